@@ -8,6 +8,7 @@
 #include <iostream> // FOR DEBUG
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include <dynd/buffer.hpp>
 #include <dynd/irange.hpp>
@@ -709,30 +710,86 @@ namespace nd {
   }
 
   /**
-   * This concatenates two 1D arrays. It is really just a placeholder until a
-   * proper
-   * concatenate is written. It shouldn't be used unless you absolutely know
-   * what you
-   * are doing. It needs to be implemented properly.
+   * Concatenates ``arrays`` along the dimension ``axis``, which counts from
+   * the end when negative. The arrays must have the same number of
+   * dimensions, and the same sizes in all of them but ``axis``. The result
+   * has fixed dimensions and the promoted dtype of the arrays.
+   *
+   * The result is allocated once, and the pieces are copied into it by
+   * ``thread_count`` threads.
    */
+  DYND_API array concatenate(const std::vector<array> &arrays, intptr_t axis = 0, intptr_t thread_count = 1);
+
+  /** Concatenates two arrays along their first dimension */
   DYND_API array concatenate(const nd::array &x, const nd::array &y);
 
   /**
-   * Reshapes an array into the new shape. This is currently a prototype and
-   * should only be used
-   * with contiguous arrays of built-in dtypes.
+   * Stacks ``arrays``, which must all have the same shape, along a new
+   * dimension inserted at position ``axis``, which counts from the end when
+   * negative. Otherwise this is like ``concatenate``.
+   */
+  DYND_API array stack(const std::vector<array> &arrays, intptr_t axis = 0, intptr_t thread_count = 1);
+
+  /**
+   * Reshapes an array into the new shape, taking its elements in C order. One
+   * entry of ``shape`` may be -1, in which case it is inferred from the
+   * number of elements.
+   *
+   * When the strides of ``a`` allow it, including for many Fortran order and
+   * sliced arrays, the result is a view of ``a``. Otherwise the elements are
+   * copied once into a new C order array, which the result views. Var
+   * dimensions over a POD dtype are flattened by copying.
    */
   DYND_API array reshape(const array &a, const array &shape);
 
   /**
-   * Reshapes an array into the new shape. This is currently a prototype and
-   * should only be used
-   * with contiguous arrays of built-in dtypes.
+   * Reshapes an array into the new shape, as above.
    */
   inline array reshape(const array &a, intptr_t ndim, const intptr_t *shape) {
     return reshape(a, nd::array(shape, ndim));
   }
 
+  /**
+   * Converts an array of structs with leading fixed dimensions, such as
+   * ``N * {a: int32, b: float64}``, into its columnar form, a struct of
+   * fixed dimension arrays like ``{a: N * int32, b: N * float64}``. Each
+   * field gets its own contiguous buffer, so a field view of the result is a
+   * unit-stride array that kernels can consume directly.
+   */
+  DYND_API array to_columnar(const array &a);
+
+  /**
+   * Converts a columnar struct of arrays, as produced by to_columnar, back
+   * into an array of structs. The leading ``ndim`` dimensions, which must
+   * match across all the fields, become the dimensions of the result.
+   */
+  DYND_API array from_columnar(const array &a, intptr_t ndim = 1);
+
+  /**
+   * Moves the elements of the var dimension in an array such as
+   * ``N * var * float64``, which are allocated in chunks as the array is built,
+   * into one contiguous allocation so scans over them are sequential. The var
+   * dimension, after any fixed dimensions, must have POD elements, and its
+   * memory block must be finalized and not shared with any other array.
+   */
+  DYND_API void compact_var_dim(const array &a);
+
+  /**
+   * Converts an array with a var dimension, ``N * var * T``, into its ragged
+   * form ``{values: M * T, offsets: N+1 * int64}``, where the M values of all
+   * the rows are stored one after another and row ``i`` is the slice from
+   * ``offsets[i]`` to ``offsets[i + 1]``. This is the layout of list arrays
+   * in Arrow.
+   */
+  DYND_API array to_ragged(const array &a);
+
+  /**
+   * Converts a ragged struct, as produced by to_ragged, back into an array
+   * of type ``N * var * T``. The result is a view whose rows point into the
+   * values field, so they stay adjacent in memory.
+   */
+  DYND_API array from_ragged(const array &a);
+
   /**
    * Memory-maps a file with dynd type 'bytes'.
    *
@@ -767,8 +824,13 @@ namespace nd {
       throw type_error(ss.str());
     }
 
-    size_t data_offset = inc_to_alignment(sizeof(buffer_memory_block) + tp.get_arrmeta_size(), tp.get_data_alignment());
     size_t data_size = tp.get_default_data_size();
+    size_t data_alignment = tp.get_data_alignment();
+    if (data_size >= large_buffer_size && data_alignment < large_buffer_alignment) {
+      // Large buffers start on a cache line, which is what vectorized loops want
+      data_alignment = large_buffer_alignment;
+    }
+    size_t data_offset = inc_to_alignment(sizeof(buffer_memory_block) + tp.get_arrmeta_size(), data_alignment);
 
     return array(new (data_offset + data_size - sizeof(buffer_memory_block))
                      buffer_memory_block(tp, data_offset, data_size, flags),
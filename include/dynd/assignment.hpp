@@ -609,5 +609,12 @@ namespace nd {
    */
   extern DYND_API callable copy;
 
+  /**
+   * Returns a callable like ``copy`` which splits copies of large arrays
+   * with permuted strides, such as transposed views, across
+   * ``thread_count`` threads.
+   */
+  DYND_API callable parallel_copy(intptr_t thread_count);
+
 } // namespace dynd::nd
 } // namespace dynd
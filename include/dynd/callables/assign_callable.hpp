@@ -8,13 +8,30 @@
 #include <dynd/callables/base_callable.hpp>
 #include <dynd/functional.hpp>
 #include <dynd/kernels/assignment_kernels.hpp>
+#include <dynd/types/adapt_type.hpp>
+#include <dynd/types/categorical_kind_type.hpp>
+#include <dynd/types/expr_kind_type.hpp>
 #include <dynd/types/fixed_bytes_kind_type.hpp>
 #include <dynd/types/fixed_string_kind_type.hpp>
 #include <dynd/types/float_kind_type.hpp>
 #include <dynd/types/int_kind_type.hpp>
+#include <dynd/types/scalar_kind_type.hpp>
+#include <dynd/types/uint_kind_type.hpp>
 
 namespace dynd {
 namespace nd {
+  namespace detail {
+
+    /**
+     * Returns true if a field of type ``src_tp`` can be assigned to a field of
+     * type ``dst_tp`` by copying its bytes, without instantiating a kernel.
+     */
+    inline bool is_plain_copy(const ndt::type &dst_tp, const ndt::type &src_tp) {
+      return dst_tp == src_tp && dst_tp.is_pod() && dst_tp.get_arrmeta_size() == 0 &&
+             dst_tp.get_base_id() != expr_kind_id;
+    }
+
+  } // namespace dynd::nd::detail
 
   template <typename ReturnType, typename Arg0Type>
   class assign_callable : public base_callable {
@@ -692,7 +709,17 @@ namespace nd {
         dst_arrmeta_offsets[i] = dst_sd->get_arrmeta_offsets()[i];
       }
 
-      cg.emplace_back([field_count, dst_arrmeta_offsets, src_arrmeta_offsets](
+      // Fields with identical POD types are copied directly rather than through a child kernel
+      const std::vector<ndt::type> &dst_field_tp = dst_sd->get_field_types();
+      const std::vector<ndt::type> &src_field_tp = src_sd->get_field_types();
+      std::vector<size_t> copy_sizes(field_count);
+      for (intptr_t i = 0; i < field_count; ++i) {
+        if (detail::is_plain_copy(dst_field_tp[i], src_field_tp[i])) {
+          copy_sizes[i] = dst_field_tp[i].get_data_size();
+        }
+      }
+
+      cg.emplace_back([field_count, dst_arrmeta_offsets, src_arrmeta_offsets, copy_sizes](
           kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data), const char *dst_arrmeta,
           size_t DYND_UNUSED(nsrc), const char *const *src_arrmeta) {
         shortvector<const char *> src_fields_arrmeta(field_count);
@@ -711,21 +738,22 @@ namespace nd {
         intptr_t self_offset = kb.size();
         kb.emplace_back<nd::tuple_unary_op_ck>(kernreq);
         nd::tuple_unary_op_ck *self = kb.get_at<nd::tuple_unary_op_ck>(self_offset);
-        self->m_fields.resize(field_count);
         for (intptr_t i = 0; i < field_count; ++i) {
           self = kb.get_at<nd::tuple_unary_op_ck>(self_offset);
-          nd::tuple_unary_op_item &field = self->m_fields[i];
-          field.child_kernel_offset = kb.size() - self_offset;
-          field.dst_data_offset = dst_data_offsets[i];
-          field.src_data_offset = src_data_offsets[i];
+          if (copy_sizes[i] != 0) {
+            self->add_copy(dst_data_offsets[i], src_data_offsets[i], copy_sizes[i]);
+            continue;
+          }
+
+          self->m_fields.push_back({kb.size() - self_offset, dst_data_offsets[i], src_data_offsets[i]});
           kb(kernel_request_single, nullptr, dst_fields_arrmeta[i], 1, &src_fields_arrmeta[i]);
         }
       });
 
-      const std::vector<ndt::type> &dst_field_tp = dst_sd->get_field_types();
-      const std::vector<ndt::type> &src_field_tp = src_sd->get_field_types();
       for (intptr_t i = 0; i < field_count; ++i) {
-        assign->resolve(this, nullptr, cg, dst_field_tp[i], 1, &src_field_tp[i], nkwd, kwds, tp_vars);
+        if (copy_sizes[i] == 0) {
+          assign->resolve(this, nullptr, cg, dst_field_tp[i], 1, &src_field_tp[i], nkwd, kwds, tp_vars);
+        }
       }
 
       return dst_tp;
@@ -783,7 +811,15 @@ namespace nd {
         dst_arrmeta_offsets[i] = dst_arrmeta_offsets_vec[i];
       }
 
-      cg.emplace_back([field_count, src_permutation, src_fields_arrmeta_offsets, dst_arrmeta_offsets](
+      // Fields with identical POD types are copied directly rather than through a child kernel
+      std::vector<size_t> copy_sizes(field_count);
+      for (intptr_t i = 0; i < field_count; ++i) {
+        if (detail::is_plain_copy(dst_fields_tp[i], src_fields_tp[i])) {
+          copy_sizes[i] = dst_fields_tp[i].get_data_size();
+        }
+      }
+
+      cg.emplace_back([field_count, src_permutation, src_fields_arrmeta_offsets, dst_arrmeta_offsets, copy_sizes](
           kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data), const char *dst_arrmeta,
           size_t DYND_UNUSED(nsrc), const char *const *src_arrmeta) {
         const uintptr_t *src_data_offsets_orig = reinterpret_cast<const uintptr_t *>(src_arrmeta[0]);
@@ -807,19 +843,68 @@ namespace nd {
         intptr_t self_offset = kb.size();
         kb.emplace_back<nd::tuple_unary_op_ck>(kernreq);
         nd::tuple_unary_op_ck *self = kb.get_at<nd::tuple_unary_op_ck>(self_offset);
-        self->m_fields.resize(field_count);
         for (intptr_t i = 0; i < field_count; ++i) {
           self = kb.get_at<nd::tuple_unary_op_ck>(self_offset);
-          nd::tuple_unary_op_item &field = self->m_fields[i];
-          field.child_kernel_offset = kb.size() - self_offset;
-          field.dst_data_offset = dst_offsets[i];
-          field.src_data_offset = src_data_offsets[i];
+          if (copy_sizes[i] != 0) {
+            self->add_copy(dst_offsets[i], src_data_offsets[i], copy_sizes[i]);
+            continue;
+          }
+
+          self->m_fields.push_back({kb.size() - self_offset, dst_offsets[i], src_data_offsets[i]});
           kb(kernel_request_single, nullptr, dst_fields_arrmeta[i], 1, &src_fields_arrmeta[i]);
         }
       });
 
       for (intptr_t i = 0; i < field_count; ++i) {
-        nd::assign->resolve(this, nullptr, cg, dst_fields_tp[i], 1, &src_fields_tp[i], nkwd, kwds, tp_vars);
+        if (copy_sizes[i] == 0) {
+          nd::assign->resolve(this, nullptr, cg, dst_fields_tp[i], 1, &src_fields_tp[i], nkwd, kwds, tp_vars);
+        }
+      }
+
+      return dst_tp;
+    }
+  };
+
+  template <typename Arg0Type>
+  class assign_callable<ndt::categorical_type, Arg0Type> : public base_callable {
+  public:
+    assign_callable()
+        : base_callable(ndt::make_type<ndt::callable_type>(
+              ndt::make_type<ndt::categorical_kind_type>(), {ndt::make_type<Arg0Type>()},
+              {{ndt::make_type<ndt::option_type>(ndt::make_type<assign_error_mode>()), "error_mode"}})) {}
+
+    ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &cg,
+                      const ndt::type &dst_tp, size_t nsrc, const ndt::type *src_tp, size_t nkwd, const array *kwds,
+                      const std::map<std::string, ndt::type> &tp_vars) {
+      const ndt::type &category_tp = dst_tp.extended<ndt::categorical_type>()->get_category_type();
+      if (src_tp[0] == category_tp) {
+        cg.emplace_back([dst_tp](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
+                                 const char *DYND_UNUSED(dst_arrmeta), size_t DYND_UNUSED(nsrc),
+                                 const char *const *src_arrmeta) {
+          kb.emplace_back<
+              detail::assignment_kernel<ndt::categorical_type, ndt::scalar_kind_type, assign_error_default>>(
+              kernreq, dst_tp, src_arrmeta[0]);
+        });
+
+        return dst_tp;
+      }
+
+      // Other values are first assigned into the category type, with the
+      // caller's error mode, and then looked up
+      cg.emplace_back([dst_tp](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
+                               const char *DYND_UNUSED(dst_arrmeta), size_t nsrc, const char *const *src_arrmeta) {
+        intptr_t self_offset = kb.size();
+        kb.emplace_back<detail::categorical_buffered_assign_kernel>(kernreq, dst_tp);
+        const char *buffer_arrmeta = kb.get_at<detail::categorical_buffered_assign_kernel>(self_offset)->buffer_arrmeta;
+        kb(kernreq | kernel_request_data_only, nullptr, buffer_arrmeta, nsrc, src_arrmeta);
+      });
+
+      try {
+        nd::assign->resolve(this, nullptr, cg, category_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
+      } catch (const std::out_of_range &) {
+        std::stringstream ss;
+        ss << "cannot assign " << src_tp[0] << " to " << dst_tp << ", the categories are of type " << category_tp;
+        throw type_error(ss.str());
       }
 
       return dst_tp;
@@ -858,65 +943,75 @@ namespace nd {
     }
   };
 
+  /**
+   * Assigns from an adapt type by running its forward callable on the
+   * storage. When the destination is the value type, the forward kernel
+   * writes straight into it, so for example a byteswapping adapt type over
+   * big-endian data is read in place with one pass. Any other destination is
+   * assigned from a chunked buffer of values, fusing the two kernels in the
+   * same loop.
+   */
   class adapt_assign_from_callable : public base_callable {
   public:
-    adapt_assign_from_callable() : base_callable(ndt::type("(Any) -> Any")) {}
+    adapt_assign_from_callable(const ndt::type &dst_tp = ndt::make_type<ndt::scalar_kind_type>())
+        : base_callable(ndt::make_type<ndt::callable_type>(dst_tp, {ndt::make_type<ndt::expr_kind_type>()})) {}
 
-    ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &DYND_UNUSED(cg),
-                      const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
-                      size_t DYND_UNUSED(nkwd), const array *DYND_UNUSED(kwds),
-                      const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars)) {
+    ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &cg,
+                      const ndt::type &dst_tp, size_t nsrc, const ndt::type *src_tp, size_t nkwd, const array *kwds,
+                      const std::map<std::string, ndt::type> &tp_vars) {
+      const ndt::adapt_type *src_adapt_tp = src_tp[0].extended<ndt::adapt_type>();
+      const ndt::type &value_tp = src_adapt_tp->get_value_type();
+      const ndt::type &storage_tp = src_adapt_tp->get_storage_type();
+
+      if (dst_tp == src_tp[0]) {
+        // The same adaptation on both sides only needs the storage copied
+        if (detail::is_plain_copy(storage_tp, storage_tp)) {
+          size_t data_size = storage_tp.get_data_size();
+          cg.emplace_back([data_size](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
+                                      const char *DYND_UNUSED(dst_arrmeta), size_t DYND_UNUSED(nsrc),
+                                      const char *const *DYND_UNUSED(src_arrmeta)) {
+            kb.emplace_back<unaligned_copy_ck>(kernreq, data_size);
+          });
+        } else {
+          assign->resolve(this, nullptr, cg, storage_tp, nsrc, &storage_tp, nkwd, kwds, tp_vars);
+        }
+        return dst_tp;
+      }
+
+      if (dst_tp.is_symbolic() || dst_tp == value_tp) {
+        return src_adapt_tp->get_forward()->resolve(this, nullptr, cg, value_tp, nsrc, &storage_tp, nkwd, kwds,
+                                                    tp_vars);
+      }
+
+      functional::compose(src_adapt_tp->get_forward(), assign, value_tp)
+          ->resolve(this, nullptr, cg, dst_tp, nsrc, &storage_tp, nkwd, kwds, tp_vars);
       return dst_tp;
     }
-
-    /*
-        void instantiate(call_node *&node, char *data, kernel_builder &kb, const ndt::type &dst_tp,
-                         const char *dst_arrmeta, intptr_t nsrc, const ndt::type *src_tp, const char *const
-       *src_arrmeta,
-                         kernel_request_t kernreq, intptr_t nkwd, const nd::array *kwds,
-                         const std::map<std::string, ndt::type> &tp_vars) {
-          intptr_t ckb_offset = kb.size();
-          const ndt::type &storage_tp = src_tp[0].storage_type();
-          if (storage_tp.is_expression()) {
-            const callable &forward = src_tp[0].extended<ndt::adapt_type>()->get_forward();
-
-            intptr_t self_offset = ckb_offset;
-            kb.emplace_back<detail::adapt_assign_from_kernel>(kernreq, storage_tp.get_canonical_type());
-            ckb_offset = kb.size();
-
-            nd::assign->instantiate(node, data, ckb, storage_tp.get_canonical_type(), dst_arrmeta, nsrc, &storage_tp,
-                                    src_arrmeta, kernel_request_single, nkwd, kwds, tp_vars);
-            ckb_offset = kb.size();
-            intptr_t forward_offset = ckb_offset - self_offset;
-            ndt::type src_tp2[1] = {storage_tp.get_canonical_type()};
-            forward->instantiate(node, data, ckb, dst_tp, dst_arrmeta, nsrc, src_tp2, src_arrmeta,
-       kernel_request_single,
-                                 nkwd, kwds, tp_vars);
-            ckb_offset = kb.size();
-            kb.get_at<detail::adapt_assign_from_kernel>(self_offset)->forward_offset = forward_offset;
-          } else {
-            const callable &forward = src_tp[0].extended<ndt::adapt_type>()->get_forward();
-
-            ndt::type src_tp2[1] = {storage_tp.get_canonical_type()};
-            forward->instantiate(node, data, ckb, dst_tp, dst_arrmeta, nsrc, src_tp2, src_arrmeta, kernreq, nkwd, kwds,
-                                 tp_vars);
-            ckb_offset = kb.size();
-          }
-        }
-    */
   };
 
+  /**
+   * Assigns to an adapt type by running its inverse callable into the
+   * storage, directly from the value type or through a chunked buffer of
+   * values from anything else.
+   */
   class adapt_assign_to_callable : public base_callable {
   public:
-    adapt_assign_to_callable() : base_callable(ndt::type("(Any) -> Any")) {}
+    adapt_assign_to_callable(const ndt::type &src_tp = ndt::make_type<ndt::scalar_kind_type>())
+        : base_callable(ndt::make_type<ndt::callable_type>(ndt::make_type<ndt::expr_kind_type>(), {src_tp})) {}
 
     ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &cg,
-                      const ndt::type &dst_tp, size_t nsrc, const ndt::type *DYND_UNUSED(src_tp), size_t nkwd,
-                      const array *kwds, const std::map<std::string, ndt::type> &tp_vars) {
-      const callable &inverse = dst_tp.extended<ndt::adapt_type>()->get_inverse();
-      const ndt::type &value_tp = dst_tp.value_type();
-
-      inverse->resolve(this, nullptr, cg, dst_tp.storage_type(), nsrc, &value_tp, nkwd, kwds, tp_vars);
+                      const ndt::type &dst_tp, size_t nsrc, const ndt::type *src_tp, size_t nkwd, const array *kwds,
+                      const std::map<std::string, ndt::type> &tp_vars) {
+      const ndt::adapt_type *dst_adapt_tp = dst_tp.extended<ndt::adapt_type>();
+      const ndt::type &value_tp = dst_adapt_tp->get_value_type();
+      const ndt::type &storage_tp = dst_adapt_tp->get_storage_type();
+
+      if (src_tp[0] == value_tp) {
+        dst_adapt_tp->get_inverse()->resolve(this, nullptr, cg, storage_tp, nsrc, &value_tp, nkwd, kwds, tp_vars);
+      } else {
+        functional::compose(assign, dst_adapt_tp->get_inverse(), value_tp)
+            ->resolve(this, nullptr, cg, storage_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
+      }
 
       return dst_tp;
     }
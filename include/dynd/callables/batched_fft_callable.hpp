@@ -0,0 +1,144 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <sstream>
+
+#include <dynd/callables/base_callable.hpp>
+#include <dynd/kernels/batched_fft_kernel.hpp>
+#include <dynd/types/callable_type.hpp>
+#include <dynd/types/fixed_dim_type.hpp>
+#include <dynd/types/option_type.hpp>
+
+namespace dynd {
+namespace nd {
+
+  enum fft_kind_t { fft_forward, fft_inverse, fft_real_forward };
+
+  /**
+   * The callable behind ``nd::fft``, ``nd::ifft`` and ``nd::rfft``. It
+   * transforms along the axes in the ``axes`` keyword, or along all of them,
+   * and treats the other dimensions as a batch. The transform along each axis
+   * is planned once at resolution time, through the shared plan cache.
+   */
+  template <fft_kind_t Kind>
+  class batched_fft_callable : public base_callable {
+    intptr_t m_thread_count;
+
+    static ndt::type make_type() {
+      std::vector<std::pair<ndt::type, std::string>> kwds{
+          {ndt::make_type<ndt::option_type>(ndt::type("Fixed * int32")), "axes"}};
+      if (Kind == fft_inverse) {
+        kwds.emplace_back(ndt::make_type<ndt::option_type>(ndt::make_type<double>()), "scale");
+      }
+
+      ndt::type arg_tp("Fixed**N * Scalar");
+      return ndt::make_type<ndt::callable_type>(ndt::type("Fixed**N * Scalar"), 1, &arg_tp, kwds);
+    }
+
+    template <typename T>
+    ndt::type resolve_kernel(call_graph &cg, const ndt::type &src_tp, const array *kwds) {
+      intptr_t ndim = src_tp.get_ndim();
+
+      std::vector<intptr_t> axes;
+      if (kwds[0].is_na()) {
+        for (intptr_t i = 0; i < ndim; ++i) {
+          axes.push_back(i);
+        }
+      } else {
+        const int32_t *values = reinterpret_cast<const int32_t *>(kwds[0].cdata());
+        for (intptr_t i = 0, i_end = kwds[0].get_dim_size(); i < i_end; ++i) {
+          intptr_t axis = values[i] < 0 ? values[i] + ndim : values[i];
+          if (axis < 0 || axis >= ndim || std::find(axes.begin(), axes.end(), axis) != axes.end()) {
+            std::stringstream ss;
+            ss << "fft cannot transform along axis " << values[i] << " of " << src_tp;
+            throw std::invalid_argument(ss.str());
+          }
+          axes.push_back(axis);
+        }
+      }
+      if (axes.empty()) {
+        throw std::invalid_argument("fft requires at least one axis to transform along");
+      }
+
+      // The half spectrum comes from the last axis, so it is transformed first
+      if (Kind == fft_real_forward) {
+        std::rotate(axes.begin(), axes.end() - 1, axes.end());
+      }
+
+      std::vector<intptr_t> shape(ndim);
+      src_tp.extended()->get_shape(ndim, 0, shape.data(), NULL, NULL);
+
+      std::vector<std::shared_ptr<const detail::fft_plan<T>>> plans;
+      for (intptr_t axis : axes) {
+        plans.push_back(detail::get_fft_plan<T>(shape[axis], Kind == fft_inverse ? 1 : -1));
+      }
+
+      T scale = (Kind == fft_inverse && !kwds[1].is_na()) ? static_cast<T>(kwds[1].as<double>()) : T(1);
+      intptr_t thread_count = m_thread_count;
+      cg.emplace_back([ndim, axes, plans, scale, thread_count](
+          kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data), const char *dst_arrmeta,
+          size_t DYND_UNUSED(nsrc), const char *const *src_arrmeta) {
+        kb.emplace_back<batched_fft_kernel<T, Kind == fft_real_forward>>(kernreq, ndim, dst_arrmeta, src_arrmeta[0],
+                                                                         axes, plans, scale, thread_count);
+      });
+
+      if (Kind == fft_real_forward) {
+        shape[axes[0]] = shape[axes[0]] / 2 + 1;
+      }
+      return ndt::make_type(ndim, shape.data(), ndt::make_type<complex<T>>());
+    }
+
+  public:
+    batched_fft_callable(intptr_t thread_count) : base_callable(make_type()), m_thread_count(thread_count) {}
+
+    ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &cg,
+                      const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
+                      size_t DYND_UNUSED(nkwd), const array *kwds,
+                      const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars)) {
+      ndt::type value_tp = src_tp[0];
+      for (intptr_t i = 0, i_end = src_tp[0].get_ndim(); i < i_end; ++i) {
+        if (value_tp.get_id() != fixed_dim_id) {
+          std::stringstream ss;
+          ss << "fft requires an array with fixed dimensions, but was given " << src_tp[0];
+          throw type_error(ss.str());
+        }
+        value_tp = value_tp.extended<ndt::fixed_dim_type>()->get_element_type();
+      }
+
+      switch (value_tp.get_id()) {
+      case float32_id:
+        if (Kind == fft_real_forward) {
+          return resolve_kernel<float>(cg, src_tp[0], kwds);
+        }
+        break;
+      case float64_id:
+        if (Kind == fft_real_forward) {
+          return resolve_kernel<double>(cg, src_tp[0], kwds);
+        }
+        break;
+      case complex_float32_id:
+        if (Kind != fft_real_forward) {
+          return resolve_kernel<float>(cg, src_tp[0], kwds);
+        }
+        break;
+      case complex_float64_id:
+        if (Kind != fft_real_forward) {
+          return resolve_kernel<double>(cg, src_tp[0], kwds);
+        }
+        break;
+      default:
+        break;
+      }
+
+      std::stringstream ss;
+      ss << (Kind == fft_real_forward ? "rfft" : "fft") << " does not support values of type " << value_tp;
+      throw type_error(ss.str());
+    }
+  };
+
+} // namespace dynd::nd
+} // namespace dynd
@@ -12,15 +12,18 @@ namespace dynd {
 namespace nd {
 
   class copy_callable : public base_callable {
+    callable m_assign;
+
   public:
-    copy_callable() : base_callable(ndt::type("(A... * S) -> B... * T")) {}
+    copy_callable(const callable &assign = nd::assign)
+        : base_callable(ndt::type("(A... * S) -> B... * T")), m_assign(assign) {}
 
     ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &cg,
                       const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
                       size_t DYND_UNUSED(nkwd), const array *DYND_UNUSED(kwds),
                       const std::map<std::string, ndt::type> &tp_vars) {
       array error_mode = eval::default_eval_context.errmode;
-      assign->resolve(this, nullptr, cg, dst_tp, 1, src_tp, 1, &error_mode, tp_vars);
+      m_assign->resolve(this, nullptr, cg, dst_tp, 1, src_tp, 1, &error_mode, tp_vars);
       return src_tp[0].get_canonical_type();
     }
   };
@@ -43,9 +43,122 @@ namespace nd {
 
     template <typename TraitsType, size_t N>
     class elwise_callable<fixed_dim_id, fixed_dim_id, TraitsType, N> : public base_elwise_callable<N> {
+      typedef typename base_elwise_callable<N>::codata_type codata_type;
       typedef typename base_elwise_callable<N>::data_type data_type;
 
     public:
+      /**
+       * Resolves the outer fixed dimensions shared by the result and every
+       * argument together, so that one coalesced_elwise_kernel can reorder
+       * and merge their loops. Anything else is left to one kernel per
+       * dimension.
+       */
+      ndt::type resolve(base_callable *caller, char *codata, call_graph &cg, const ndt::type &res_tp, size_t narg,
+                        const ndt::type *arg_tp, size_t nkwd, const array *kwds,
+                        const std::map<std::string, ndt::type> &tp_vars) {
+        codata_type *cd = reinterpret_cast<codata_type *>(codata);
+        if (!std::is_same<TraitsType, no_traits>::value || N == 0 || cd->res_ignore || cd->state) {
+          return base_elwise_callable<N>::resolve(caller, codata, cg, res_tp, narg, arg_tp, nkwd, kwds, tp_vars);
+        }
+
+        base_callable *child = cd->child;
+        const std::vector<ndt::type> &child_arg_tp = child->get_arg_types();
+
+        std::vector<std::array<bool, N>> arg_present;
+        std::vector<intptr_t> res_size;
+        std::array<ndt::type, N> arg_element_tp;
+        std::copy(arg_tp, arg_tp + N, arg_element_tp.begin());
+        ndt::type res_element_tp = res_tp;
+        intptr_t ndim = cd->ndim;
+        for (intptr_t j = 0; j < ndim; ++j) {
+          bool res_variadic = res_element_tp.is_variadic();
+          if (!res_variadic && res_element_tp.get_id() != fixed_dim_id) {
+            break;
+          }
+
+          // Arguments with fewer dimensions are broadcast across this one
+          std::array<bool, N> present;
+          bool fixed = true;
+          for (size_t i = 0; i < N; ++i) {
+            present[i] = (arg_element_tp[i].get_ndim() - child_arg_tp[i].get_ndim()) >= ndim - j;
+            fixed &= !present[i] || arg_element_tp[i].get_id() == fixed_dim_id;
+          }
+          if (!fixed) {
+            break;
+          }
+
+          intptr_t size = res_variadic ? 1 : res_element_tp.extended<ndt::fixed_dim_type>()->get_fixed_dim_size();
+          for (size_t i = 0; i < N && res_variadic && size == 1; ++i) {
+            if (present[i]) {
+              size = arg_element_tp[i].template extended<ndt::fixed_dim_type>()->get_fixed_dim_size();
+            }
+          }
+          for (size_t i = 0; i < N; ++i) {
+            if (present[i]) {
+              intptr_t arg_size = arg_element_tp[i].template extended<ndt::fixed_dim_type>()->get_fixed_dim_size();
+              if (arg_size != size && arg_size != 1) {
+                throw std::runtime_error("broadcast error 1");
+              }
+              arg_element_tp[i] = arg_element_tp[i].template extended<ndt::fixed_dim_type>()->get_element_type();
+            }
+          }
+          if (!res_variadic) {
+            res_element_tp = res_element_tp.extended<ndt::fixed_dim_type>()->get_element_type();
+          }
+
+          arg_present.push_back(present);
+          res_size.push_back(size);
+        }
+
+        if (arg_present.size() < 2) {
+          return base_elwise_callable<N>::resolve(caller, codata, cg, res_tp, narg, arg_tp, nkwd, kwds, tp_vars);
+        }
+
+        cg.emplace_back([arg_present](kernel_builder &kb, kernel_request_t kernreq, char *data,
+                                      const char *dst_arrmeta, size_t DYND_UNUSED(nsrc),
+                                      const char *const *src_arrmeta) {
+          size_t ndim = arg_present.size();
+          std::vector<intptr_t> size(ndim), dst_stride(ndim);
+          std::vector<std::array<intptr_t, N>> src_stride(ndim);
+          std::array<const char *, N> child_src_arrmeta;
+          std::copy(src_arrmeta, src_arrmeta + N, child_src_arrmeta.begin());
+          for (size_t j = 0; j < ndim; ++j) {
+            size[j] = reinterpret_cast<const size_stride_t *>(dst_arrmeta)[j].dim_size;
+            dst_stride[j] = reinterpret_cast<const size_stride_t *>(dst_arrmeta)[j].stride;
+            for (size_t i = 0; i < N; ++i) {
+              src_stride[j][i] = 0;
+              if (arg_present[j][i]) {
+                const size_stride_t *src_ss = reinterpret_cast<const size_stride_t *>(child_src_arrmeta[i]);
+                if (src_ss->dim_size != 1) {
+                  src_stride[j][i] = src_ss->stride;
+                }
+                child_src_arrmeta[i] += sizeof(size_stride_t);
+              }
+            }
+          }
+
+          kb.emplace_back<coalesced_elwise_kernel<N>>(kernreq, size, dst_stride, src_stride);
+
+          kb(kernel_request_strided, data, dst_arrmeta + ndim * sizeof(size_stride_t), N, child_src_arrmeta.data());
+        });
+
+        cd->ndim -= arg_present.size();
+        if (cd->ndim > 0) {
+          res_element_tp = caller->resolve(this, codata, cg, res_element_tp, N, arg_element_tp.data(), nkwd, kwds,
+                                           tp_vars);
+        } else {
+          res_element_tp = child->resolve(this, nullptr, cg, res_tp.is_variadic() ? child->get_ret_type()
+                                                                                   : res_element_tp,
+                                          N, arg_element_tp.data(), nkwd, kwds, tp_vars);
+        }
+
+        for (size_t j = res_size.size(); j > 0; --j) {
+          res_element_tp = ndt::make_type<ndt::fixed_dim_type>(res_size[j - 1], res_element_tp);
+        }
+
+        return res_element_tp;
+      }
+
       void subresolve(call_graph &cg, const char *data) {
         bool res_broadcast = reinterpret_cast<const data_type *>(data)->res_ignore;
         const std::array<bool, N> &arg_broadcast = reinterpret_cast<const data_type *>(data)->arg_broadcast;
@@ -0,0 +1,72 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <dynd/callables/base_callable.hpp>
+#include <dynd/kernels/fused_kernel.hpp>
+
+namespace dynd {
+namespace nd {
+  namespace functional {
+
+    /**
+     * A callable whose kernel evaluates a sequence of steps over its
+     * arguments with one fused_kernel. ``step_tp`` holds the type of each
+     * step's result, all of which must be POD with no arrmeta because they
+     * are kept in raw buffers.
+     */
+    class fused_callable : public base_callable {
+      std::vector<callable> m_step;
+      std::vector<std::vector<intptr_t>> m_step_args;
+      std::vector<ndt::type> m_step_tp;
+
+    public:
+      fused_callable(const ndt::type &tp, const std::vector<callable> &step,
+                     const std::vector<std::vector<intptr_t>> &step_args, const std::vector<ndt::type> &step_tp)
+          : base_callable(tp), m_step(step), m_step_args(step_args), m_step_tp(step_tp) {}
+
+      ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &cg,
+                        const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc), const ndt::type *src_tp, size_t nkwd,
+                        const array *kwds, const std::map<std::string, ndt::type> &tp_vars) {
+        std::vector<intptr_t> step_data_size;
+        for (const ndt::type &tp : m_step_tp) {
+          step_data_size.push_back(tp.get_data_size());
+        }
+
+        cg.emplace_back([step_args = m_step_args, step_data_size](kernel_builder &kb, kernel_request_t kernreq,
+                                                                  char *DYND_UNUSED(data), const char *dst_arrmeta,
+                                                                  size_t nsrc, const char *const *src_arrmeta) {
+          intptr_t root_kb_offset = kb.size();
+          kb.emplace_back<fused_kernel>(kernreq, nsrc, step_args, step_data_size);
+
+          for (size_t s = 0; s < step_args.size(); ++s) {
+            kb.get_at<fused_kernel>(root_kb_offset)->step_offset[s] = kb.size() - root_kb_offset;
+
+            std::vector<const char *> arg_arrmeta;
+            for (intptr_t i : step_args[s]) {
+              arg_arrmeta.push_back((i >= 0) ? src_arrmeta[i] : nullptr);
+            }
+            kb(kernel_request_strided, nullptr, (s + 1 == step_args.size()) ? dst_arrmeta : nullptr,
+               arg_arrmeta.size(), arg_arrmeta.data());
+          }
+        });
+
+        for (size_t s = 0; s < m_step.size(); ++s) {
+          std::vector<ndt::type> arg_tp;
+          for (intptr_t i : m_step_args[s]) {
+            arg_tp.push_back((i >= 0) ? src_tp[i] : m_step_tp[~i]);
+          }
+          m_step[s]->resolve(this, nullptr, cg, (s + 1 == m_step.size()) ? dst_tp : m_step_tp[s], arg_tp.size(),
+                             arg_tp.data(), nkwd, kwds, tp_vars);
+        }
+
+        return dst_tp;
+      }
+    };
+
+  } // namespace dynd::nd::functional
+} // namespace dynd::nd
+} // namespace dynd
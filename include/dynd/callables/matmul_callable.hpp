@@ -0,0 +1,115 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <dynd/callables/base_callable.hpp>
+#include <dynd/functional.hpp>
+#include <dynd/kernels/matmul_kernel.hpp>
+
+namespace dynd {
+namespace nd {
+
+  /**
+   * Multiplies a single pair of matrices.
+   */
+  class matmul_matrix_callable : public base_callable {
+    intptr_t m_thread_count;
+
+    template <typename T>
+    void emplace_kernel(call_graph &cg) {
+      intptr_t thread_count = m_thread_count;
+      cg.emplace_back([thread_count](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
+                                     const char *dst_arrmeta, size_t DYND_UNUSED(nsrc),
+                                     const char *const *src_arrmeta) {
+        kb.emplace_back<matmul_kernel<T>>(kernreq, dst_arrmeta, src_arrmeta, thread_count);
+      });
+    }
+
+  public:
+    matmul_matrix_callable(intptr_t thread_count)
+        : base_callable(ndt::type("(Fixed * Fixed * Scalar, Fixed * Fixed * Scalar) -> Fixed * Fixed * Scalar")),
+          m_thread_count(thread_count) {}
+
+    ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &cg,
+                      const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
+                      size_t DYND_UNUSED(nkwd), const array *DYND_UNUSED(kwds),
+                      const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars)) {
+      for (size_t i = 0; i < 2; ++i) {
+        if (src_tp[i].get_id() != fixed_dim_id ||
+            src_tp[i].extended<ndt::fixed_dim_type>()->get_element_type().get_id() != fixed_dim_id) {
+          std::stringstream ss;
+          ss << "matmul requires matrices with fixed dimensions, but was given " << src_tp[i];
+          throw type_error(ss.str());
+        }
+      }
+
+      intptr_t m = src_tp[0].extended<ndt::fixed_dim_type>()->get_fixed_dim_size();
+      ndt::type src0_row_tp = src_tp[0].extended<ndt::fixed_dim_type>()->get_element_type();
+      intptr_t k = src0_row_tp.extended<ndt::fixed_dim_type>()->get_fixed_dim_size();
+      ndt::type src1_row_tp = src_tp[1].extended<ndt::fixed_dim_type>()->get_element_type();
+      intptr_t n = src1_row_tp.extended<ndt::fixed_dim_type>()->get_fixed_dim_size();
+
+      ndt::type value_tp = src0_row_tp.extended<ndt::fixed_dim_type>()->get_element_type();
+      if (src_tp[1].extended<ndt::fixed_dim_type>()->get_fixed_dim_size() != k ||
+          src1_row_tp.extended<ndt::fixed_dim_type>()->get_element_type() != value_tp) {
+        std::stringstream ss;
+        ss << "matmul cannot multiply " << src_tp[0] << " by " << src_tp[1];
+        throw type_error(ss.str());
+      }
+
+      switch (value_tp.get_id()) {
+      case float32_id:
+        emplace_kernel<float>(cg);
+        break;
+      case float64_id:
+        emplace_kernel<double>(cg);
+        break;
+      case complex_float32_id:
+        emplace_kernel<complex<float>>(cg);
+        break;
+      case complex_float64_id:
+        emplace_kernel<complex<double>>(cg);
+        break;
+      default: {
+        std::stringstream ss;
+        ss << "matmul does not support values of type " << value_tp;
+        throw type_error(ss.str());
+      }
+      }
+
+      return ndt::make_fixed_dim(m, ndt::make_fixed_dim(n, value_tp));
+    }
+  };
+
+  /**
+   * The callable behind ``nd::matmul``, which multiplies the matrices in the
+   * two innermost dimensions and broadcasts over any leading dimensions.
+   */
+  class matmul_callable : public base_callable {
+    callable m_child;
+
+  public:
+    matmul_callable(intptr_t thread_count)
+        : base_callable(ndt::type("(Any, Any) -> Any")),
+          m_child(make_callable<matmul_matrix_callable>(thread_count)) {}
+
+    ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &cg,
+                      const ndt::type &dst_tp, size_t nsrc, const ndt::type *src_tp, size_t nkwd, const array *kwds,
+                      const std::map<std::string, ndt::type> &tp_vars) {
+      for (size_t i = 0; i < 2; ++i) {
+        if (src_tp[i].get_ndim() < 2) {
+          std::stringstream ss;
+          ss << "matmul requires arrays with at least two dimensions, but was given " << src_tp[i];
+          throw type_error(ss.str());
+        }
+      }
+
+      return get_elwise2()->resolve(m_child.get(), nullptr, cg, dst_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
+    }
+  };
+
+} // namespace dynd::nd
+} // namespace dynd
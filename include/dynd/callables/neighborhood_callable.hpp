@@ -7,161 +7,123 @@
 
 #include <dynd/callables/base_callable.hpp>
 #include <dynd/kernels/neighborhood.hpp>
+#include <dynd/types/fixed_dim_type.hpp>
 
 namespace dynd {
 namespace nd {
   namespace functional {
 
-    template <int N>
+    /**
+     * The callable behind ``nd::functional::neighborhood``. Its first two
+     * keywords are the window "shape" and "offset", and the rest are passed
+     * on to the child.
+     */
     class neighborhood_callable : public base_callable {
       callable m_child;
       callable m_boundary_child;
+      neighborhood_boundary_mode m_boundary_mode;
+      intptr_t m_thread_count;
 
     public:
-      struct data_type {
-        ndt::type child_src_tp;
-        size_stride_t child_src_arrmeta[5];
-
-        const ndt::type *src_tp;
-        const char *src_arrmeta;
-
-        intptr_t ndim;
-        intptr_t *shape;
-        int *offset;
-        std::shared_ptr<bool> out_of_bounds;
-
-        data_type(const ndt::type *src_tp, intptr_t ndim, int *shape, int *offset)
-            : src_tp(src_tp), src_arrmeta(NULL), ndim(ndim), offset(offset), out_of_bounds(std::make_shared<bool>()) {
-          this->shape = new intptr_t[ndim];
-          for (int i = 0; i < ndim; ++i) {
-            this->shape[i] = shape[i];
+      neighborhood_callable(const ndt::type &tp, const callable &child, const callable &boundary_child,
+                            neighborhood_boundary_mode boundary_mode, intptr_t thread_count)
+          : base_callable(tp), m_child(child), m_boundary_child(boundary_child), m_boundary_mode(boundary_mode),
+            m_thread_count(thread_count) {}
+
+      ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &cg,
+                        const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc), const ndt::type *src_tp, size_t nkwd,
+                        const array *kwds, const std::map<std::string, ndt::type> &tp_vars) {
+        intptr_t ndim = kwds[0].get_dim_size();
+        std::vector<intptr_t> window(ndim), offset(ndim, 0);
+        for (intptr_t i = 0; i < ndim; ++i) {
+          window[i] = kwds[0](i).as<intptr_t>();
+          if (window[i] < 1) {
+            throw std::invalid_argument("neighborhood shape must be positive in every dimension");
           }
-
-          /*
-                    child_src_arrmeta = new char[ndim * sizeof(size_stride_t)];
-                    for (int i = 0; i < ndim; ++i) {
-                      (reinterpret_cast<size_stride_t *>(child_src_arrmeta) + i)->dim_size = shape[i];
-                      (reinterpret_cast<size_stride_t *>(child_src_arrmeta) + i)->stride = sizeof(int);
-                    }
-          */
-
-          if (ndim == 1) {
-            child_src_arrmeta[0].dim_size = shape[0];
-            child_src_arrmeta[0].stride = sizeof(int);
-          } else if (ndim == 2) {
-            child_src_arrmeta[0].dim_size = shape[0];
-            child_src_arrmeta[0].stride = 4 * sizeof(int);
-            child_src_arrmeta[1].dim_size = shape[1];
-            child_src_arrmeta[1].stride = sizeof(int);
-          } else if (ndim == 3) {
-            child_src_arrmeta[0].dim_size = shape[0];
-            child_src_arrmeta[0].stride = 4 * 4 * sizeof(int);
-            child_src_arrmeta[1].dim_size = shape[1];
-            child_src_arrmeta[1].stride = 4 * sizeof(int);
-            child_src_arrmeta[2].dim_size = shape[2];
-            child_src_arrmeta[2].stride = sizeof(int);
+        }
+        if (!kwds[1].is_na()) {
+          if (kwds[1].get_dim_size() != ndim) {
+            throw std::invalid_argument("neighborhood offset must have one value per dimension of the shape");
+          }
+          for (intptr_t i = 0; i < ndim; ++i) {
+            offset[i] = kwds[1](i).as<intptr_t>();
           }
         }
 
-        ~data_type() {
-          //          delete[] child_src_arrmeta;
+        std::vector<intptr_t> shape(ndim);
+        ndt::type data_tp = src_tp[0];
+        for (intptr_t i = 0; i < ndim; ++i) {
+          if (data_tp.get_id() != fixed_dim_id) {
+            std::stringstream ss;
+            ss << "neighborhood with a " << ndim << "-dimensional shape requires as many leading fixed dimensions, "
+               << "but was given " << src_tp[0];
+            throw type_error(ss.str());
+          }
+          shape[i] = data_tp.extended<ndt::fixed_dim_type>()->get_fixed_dim_size();
+          data_tp = data_tp.extended<ndt::fixed_dim_type>()->get_element_type();
         }
-      };
-
-      neighborhood_callable(const ndt::type &tp, const callable &child, const callable &boundary_child)
-          : base_callable(tp), m_child(child), m_boundary_child(boundary_child) {}
-
-      ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &DYND_UNUSED(cg),
-                        const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
-                        size_t DYND_UNUSED(nkwd), const array *DYND_UNUSED(kwds),
-                        const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars)) {
-        return dst_tp;
-      }
-
-/*
-      char *data_init(const ndt::type &DYND_UNUSED(dst_tp), intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
-                      intptr_t DYND_UNUSED(nkwd), const array *kwds,
-                      const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars)) {
-        char *data = reinterpret_cast<char *>(
-            new data_type(src_tp, kwds[0].get_dim_size(), reinterpret_cast<int *>(kwds[0].data()),
-                          kwds[1].is_na() ? NULL : reinterpret_cast<int *>(kwds[1].data())));
-
-        reinterpret_cast<data_type *>(data)->child_src_tp =
-            ndt::substitute_shape(m_child.get_arg_type(0), reinterpret_cast<data_type *>(data)->ndim,
-                                  reinterpret_cast<data_type *>(data)->shape);
 
-        return data;
-      }
-*/
-
-/*
-      void resolve_dst_type(char *DYND_UNUSED(data), ndt::type &dst_tp, intptr_t DYND_UNUSED(nsrc),
-                            const ndt::type *src_tp, intptr_t DYND_UNUSED(nkwd), const array *DYND_UNUSED(kwds),
-                            const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars)) {
-        // swap in the input dimension values for the Fixed**N
-        intptr_t ndim = src_tp[0].get_ndim();
-        dimvector shape(ndim);
-        src_tp[0].extended()->get_shape(ndim, 0, shape.get(), NULL, NULL);
-        dst_tp = ndt::substitute_shape(dst_tp, ndim, shape.get());
-      }
-*/
-
-/*
-      void instantiate(call_node *&DYND_UNUSED(node), char *data, kernel_builder *ckb, const ndt::type &dst_tp,
-                       const char *dst_arrmeta, intptr_t nsrc, const ndt::type *src_tp, const char *const *src_arrmeta,
-                       kernel_request_t kernreq, intptr_t nkwd, const nd::array *kwds,
-                       const std::map<std::string, ndt::type> &tp_vars) {
-        intptr_t neighborhood_offset = ckb->size();
-        ckb->emplace_back<neighborhood_kernel<N>>(
-            kernreq, reinterpret_cast<const fixed_dim_type_arrmeta *>(dst_arrmeta)->stride,
-            reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->dim_size,
-            reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->stride,
-            reinterpret_cast<data_type *>(data)->shape[0],
-            (reinterpret_cast<data_type *>(data)->offset == NULL) ? 0 : reinterpret_cast<data_type *>(data)->offset[0],
-            reinterpret_cast<data_type *>(data)->out_of_bounds);
-
-        const ndt::type &child_dst_tp = dst_tp.extended<ndt::fixed_dim_type>()->get_element_type();
-        const char *child_dst_arrmeta = dst_arrmeta + sizeof(fixed_dim_type_arrmeta);
-
-        reinterpret_cast<data_type *>(data)->ndim -= 1;
-        reinterpret_cast<data_type *>(data)->shape += 1;
-        if (reinterpret_cast<data_type *>(data)->offset != NULL) {
-          reinterpret_cast<data_type *>(data)->offset += 1;
+        neighborhood_boundary_mode boundary_mode = m_boundary_mode;
+        if (boundary_mode != neighborhood_boundary_fill &&
+            (!data_tp.is_pod() || data_tp.get_arrmeta_size() != 0 || data_tp.get_base_id() == expr_kind_id)) {
+          std::stringstream ss;
+          ss << "neighborhood padding requires elements that can be copied as bytes, but was given " << data_tp;
+          throw type_error(ss.str());
         }
 
-        if (reinterpret_cast<data_type *>(data)->ndim == 0) {
-          const callable &child = m_child;
-          const callable &boundary_child = m_boundary_child;
-
-          const char *child_src_arrmeta =
-              reinterpret_cast<char *>(reinterpret_cast<data_type *>(data)->child_src_arrmeta);
-          child.get()->instantiate(node, NULL, ckb, child_dst_tp, child_dst_arrmeta, nsrc,
-                                   &reinterpret_cast<data_type *>(data)->child_src_tp, &child_src_arrmeta,
-                                   kernel_request_single, nkwd - 3, kwds + 3, tp_vars);
-          ckb->get_at<neighborhood_kernel<N>>(neighborhood_offset)->boundary_child_offset =
-              ckb->size() - neighborhood_offset;
-
-          boundary_child.get()->instantiate(node, NULL, ckb, child_dst_tp, child_dst_arrmeta, 0, NULL, NULL,
-                                            kernel_request_single, nkwd - 3, kwds + 3, tp_vars);
+        ndt::type window_tp = data_tp;
+        for (intptr_t i = ndim - 1; i >= 0; --i) {
+          window_tp = ndt::make_fixed_dim(window[i], window_tp);
+        }
 
-          delete reinterpret_cast<data_type *>(data);
-          return;
+        ndt::type child_dst_tp = m_child->get_ret_type();
+        if (!dst_tp.is_symbolic()) {
+          child_dst_tp = dst_tp;
+          for (intptr_t i = 0; i < ndim; ++i) {
+            child_dst_tp = child_dst_tp.extended<ndt::base_dim_type>()->get_element_type();
+          }
         }
 
-        ndt::type child_src_tp[N];
-        const char *child_src_arrmeta[N];
-        for (int i = 0; i < N; ++i) {
-          child_src_tp[i] = src_tp[i].extended<ndt::fixed_dim_type>()->get_element_type();
-          child_src_arrmeta[i] = src_arrmeta[i] + sizeof(fixed_dim_type_arrmeta);
+        size_t data_size = data_tp.get_data_size();
+        size_t data_arrmeta_size = data_tp.get_arrmeta_size();
+        intptr_t thread_count = m_thread_count;
+        cg.emplace_back([=](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
+                            const char *dst_arrmeta, size_t DYND_UNUSED(nsrc), const char *const *src_arrmeta) {
+          intptr_t root_ckb_offset = kb.size();
+          kb.emplace_back<neighborhood_kernel>(kernreq, ndim, dst_arrmeta, src_arrmeta[0], window, offset,
+                                               boundary_mode, data_size, data_arrmeta_size, thread_count);
+
+          // The arrmeta lives in the kernel's vectors, whose storage stays put if the kernel is relocated
+          const char *child_dst_arrmeta = dst_arrmeta + ndim * sizeof(size_stride_t);
+          const char *child_src_arrmeta = kb.get_at<neighborhood_kernel>(root_ckb_offset)->window_arrmeta.data();
+          kb(kernel_request_strided, nullptr, child_dst_arrmeta, 1, &child_src_arrmeta);
+
+          intptr_t ckb_offset = kb.size();
+          kb.reserve(ckb_offset + sizeof(kernel_prefix));
+          neighborhood_kernel *self = kb.get_at<neighborhood_kernel>(root_ckb_offset);
+          self->boundary_child_offset = ckb_offset - root_ckb_offset;
+          if (boundary_mode == neighborhood_boundary_fill) {
+            kb(kernel_request_single, nullptr, child_dst_arrmeta, 0, nullptr);
+          } else {
+            const char *buffer_arrmeta = self->buffer_arrmeta.data();
+            kb(kernel_request_single, nullptr, child_dst_arrmeta, 1, &buffer_arrmeta);
+          }
+        });
+
+        ndt::type ret_tp =
+            m_child->resolve(this, nullptr, cg, child_dst_tp, 1, &window_tp, nkwd - 2, kwds + 2, tp_vars);
+        if (boundary_mode == neighborhood_boundary_fill) {
+          m_boundary_child->resolve(this, nullptr, cg, ret_tp, 0, nullptr, 0, nullptr, tp_vars);
+        } else {
+          m_child->resolve(this, nullptr, cg, ret_tp, 1, &window_tp, nkwd - 2, kwds + 2, tp_vars);
         }
 
-        ckb->get_at<neighborhood_kernel<N>>(neighborhood_offset)->boundary_child_offset =
-            sizeof(neighborhood_kernel<N>);
+        for (intptr_t i = ndim - 1; i >= 0; --i) {
+          ret_tp = ndt::make_fixed_dim(shape[i], ret_tp);
+        }
 
-        return instantiate(node, data, ckb, child_dst_tp, child_dst_arrmeta, nsrc, child_src_tp, child_src_arrmeta,
-                           kernel_request_single, nkwd, kwds, tp_vars);
+        return ret_tp;
       }
-*/
     };
 
   } // namespace dynd::nd::functional
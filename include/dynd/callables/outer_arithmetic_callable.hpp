@@ -0,0 +1,94 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <dynd/callables/base_callable.hpp>
+#include <dynd/kernels/outer_kernel.hpp>
+#include <dynd/types/fixed_dim_type.hpp>
+
+namespace dynd {
+namespace nd {
+  namespace functional {
+
+    /**
+     * The outer product of two one-dimensional arrays of the same builtin
+     * type under an arithmetic function, with a blocked kernel that computes
+     * whole rows at once. Any other arguments go to ``fallback``, which is
+     * the generic outer callable for the same child.
+     */
+    template <template <typename, typename> class FuncType>
+    class outer_arithmetic_callable : public base_callable {
+      intptr_t m_thread_count;
+      bool m_integral;
+      callable m_fallback;
+
+      template <typename T>
+      ndt::type resolve_kernel(call_graph &cg, const ndt::type &dst_tp, const ndt::type *src_tp) {
+        ndt::type ret_tp = ndt::make_type<ndt::fixed_dim_type>(
+            src_tp[0].extended<ndt::fixed_dim_type>()->get_fixed_dim_size(),
+            ndt::make_type<ndt::fixed_dim_type>(src_tp[1].extended<ndt::fixed_dim_type>()->get_fixed_dim_size(),
+                                                ndt::make_type<T>()));
+        if (!std::is_same<decltype(FuncType<T, T>::f(T(), T())), T>::value ||
+            !(dst_tp.is_symbolic() ? dst_tp.match(ret_tp) : dst_tp == ret_tp)) {
+          return ndt::type();
+        }
+
+        intptr_t thread_count = m_thread_count;
+        cg.emplace_back([thread_count](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
+                                       const char *dst_arrmeta, size_t DYND_UNUSED(nsrc),
+                                       const char *const *src_arrmeta) {
+          kb.emplace_back<outer_arithmetic_kernel<T, FuncType>>(kernreq, dst_arrmeta, src_arrmeta, thread_count);
+        });
+
+        return ret_tp;
+      }
+
+    public:
+      outer_arithmetic_callable(intptr_t thread_count, bool integral, const callable &fallback)
+          : base_callable(fallback->get_type()), m_thread_count(thread_count), m_integral(integral),
+            m_fallback(fallback) {}
+
+      ndt::type resolve(base_callable *caller, char *data, call_graph &cg, const ndt::type &dst_tp, size_t nsrc,
+                        const ndt::type *src_tp, size_t nkwd, const array *kwds,
+                        const std::map<std::string, ndt::type> &tp_vars) {
+        if (nsrc == 2 && nkwd == 0 && src_tp[0].get_id() == fixed_dim_id && src_tp[1].get_id() == fixed_dim_id) {
+          const ndt::type &el_tp = src_tp[0].extended<ndt::fixed_dim_type>()->get_element_type();
+          if (el_tp == src_tp[1].extended<ndt::fixed_dim_type>()->get_element_type()) {
+            ndt::type ret_tp;
+            switch (el_tp.get_id()) {
+            case int32_id:
+              if (m_integral) {
+                ret_tp = resolve_kernel<int32_t>(cg, dst_tp, src_tp);
+              }
+              break;
+            case int64_id:
+              if (m_integral) {
+                ret_tp = resolve_kernel<int64_t>(cg, dst_tp, src_tp);
+              }
+              break;
+            case float32_id:
+              ret_tp = resolve_kernel<float>(cg, dst_tp, src_tp);
+              break;
+            case float64_id:
+              ret_tp = resolve_kernel<double>(cg, dst_tp, src_tp);
+              break;
+            default:
+              break;
+            }
+
+            if (!ret_tp.is_null()) {
+              return ret_tp;
+            }
+          }
+        }
+
+        return m_fallback->resolve(caller, data, cg, dst_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
+      }
+    };
+
+  } // namespace dynd::nd::functional
+} // namespace dynd::nd
+} // namespace dynd
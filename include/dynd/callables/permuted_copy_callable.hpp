@@ -0,0 +1,79 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <dynd/callables/base_callable.hpp>
+#include <dynd/kernels/permuted_copy_kernel.hpp>
+#include <dynd/uint128.hpp>
+
+namespace dynd {
+namespace nd {
+
+  /**
+   * Assigns between arrays of the same type made of fixed dimensions over a
+   * POD type without arrmeta, such as a builtin type, with a single kernel
+   * for all the dimensions. It handles permuted layouts efficiently and
+   * turns contiguous ones into bulk copies. Anything else goes to
+   * ``fallback``.
+   */
+  class permuted_copy_callable : public base_callable {
+    intptr_t m_thread_count;
+    callable m_fallback;
+
+    template <typename T>
+    void emplace_kernel(call_graph &cg, intptr_t ndim, intptr_t element_size = sizeof(T)) {
+      intptr_t thread_count = m_thread_count;
+      cg.emplace_back([ndim, thread_count, element_size](kernel_builder &kb, kernel_request_t kernreq,
+                                                         char *DYND_UNUSED(data), const char *dst_arrmeta,
+                                                         size_t DYND_UNUSED(nsrc), const char *const *src_arrmeta) {
+        kb.emplace_back<permuted_copy_kernel<T>>(kernreq, ndim, dst_arrmeta, src_arrmeta[0], thread_count,
+                                                 element_size);
+      });
+    }
+
+  public:
+    permuted_copy_callable(intptr_t thread_count, const callable &fallback)
+        : base_callable(fallback->get_type()), m_thread_count(thread_count), m_fallback(fallback) {}
+
+    ndt::type resolve(base_callable *caller, char *data, call_graph &cg, const ndt::type &dst_tp, size_t nsrc,
+                      const ndt::type *src_tp, size_t nkwd, const array *kwds,
+                      const std::map<std::string, ndt::type> &tp_vars) {
+      intptr_t ndim = 0;
+      ndt::type el_tp = src_tp[0];
+      for (; el_tp.get_id() == fixed_dim_id; ++ndim) {
+        el_tp = el_tp.extended<ndt::fixed_dim_type>()->get_element_type();
+      }
+
+      if (ndim > 0 && el_tp.is_pod() && el_tp.get_arrmeta_size() == 0 && el_tp.get_base_id() != expr_kind_id &&
+          (dst_tp.is_symbolic() ? dst_tp.match(src_tp[0]) : dst_tp == src_tp[0])) {
+        switch (el_tp.get_data_size()) {
+        case 1:
+          emplace_kernel<uint8_t>(cg, ndim);
+          return src_tp[0];
+        case 2:
+          emplace_kernel<uint16_t>(cg, ndim);
+          return src_tp[0];
+        case 4:
+          emplace_kernel<uint32_t>(cg, ndim);
+          return src_tp[0];
+        case 8:
+          emplace_kernel<uint64_t>(cg, ndim);
+          return src_tp[0];
+        case 16:
+          emplace_kernel<uint128>(cg, ndim);
+          return src_tp[0];
+        default:
+          emplace_kernel<uint8_t>(cg, ndim, el_tp.get_data_size());
+          return src_tp[0];
+        }
+      }
+
+      return m_fallback->resolve(caller, data, cg, dst_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
+    }
+  };
+
+} // namespace dynd::nd
+} // namespace dynd
@@ -0,0 +1,134 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <dynd/callables/base_callable.hpp>
+#include <dynd/functional.hpp>
+#include <dynd/kernels/rolling_kernel.hpp>
+
+namespace dynd {
+namespace nd {
+
+  /**
+   * Computes a rolling statistic along a single fixed or var dimension.
+   */
+  class rolling_dim_callable : public base_callable {
+    rolling_statistic m_statistic;
+    intptr_t m_window;
+    intptr_t m_min_periods;
+
+    template <typename Arg0Type>
+    void emplace_kernel(call_graph &cg, bool option, const ndt::type &src_tp, const ndt::type &dst_tp) {
+      rolling_statistic statistic = m_statistic;
+      intptr_t window = m_window;
+      intptr_t min_periods = m_min_periods;
+      cg.emplace_back([=](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
+                          const char *dst_arrmeta, size_t DYND_UNUSED(nsrc), const char *const *src_arrmeta) {
+        kb.emplace_back<rolling_kernel<Arg0Type>>(kernreq, statistic, window, min_periods, option, src_tp,
+                                                   src_arrmeta[0], dst_tp, dst_arrmeta);
+      });
+    }
+
+  public:
+    rolling_dim_callable(rolling_statistic statistic, intptr_t window, intptr_t min_periods)
+        : base_callable(ndt::type("(Fixed * Scalar) -> Fixed * float64")), m_statistic(statistic), m_window(window),
+          m_min_periods(min_periods) {}
+
+    ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &cg,
+                      const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
+                      size_t DYND_UNUSED(nkwd), const array *DYND_UNUSED(kwds),
+                      const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars)) {
+      if (src_tp[0].get_id() != fixed_dim_id && src_tp[0].get_id() != var_dim_id) {
+        std::stringstream ss;
+        ss << "rolling requires a fixed or var dimension, but was given " << src_tp[0];
+        throw type_error(ss.str());
+      }
+
+      ndt::type value_tp = src_tp[0].extended<ndt::base_dim_type>()->get_element_type();
+      bool option = value_tp.get_id() == option_id;
+      if (option) {
+        value_tp = value_tp.extended<ndt::option_type>()->get_value_type();
+      }
+
+      // The result is float64, and can be missing where the argument can be
+      ndt::type ret_tp = ndt::make_type<double>();
+      if (option) {
+        ret_tp = ndt::make_type<ndt::option_type>(ret_tp);
+      }
+      if (src_tp[0].get_id() == fixed_dim_id) {
+        ret_tp = ndt::make_fixed_dim(src_tp[0].extended<ndt::fixed_dim_type>()->get_fixed_dim_size(), ret_tp);
+      } else {
+        ret_tp = ndt::make_type<ndt::var_dim_type>(ret_tp);
+      }
+
+      switch (value_tp.get_id()) {
+      case int8_id:
+        emplace_kernel<int8_t>(cg, option, src_tp[0], ret_tp);
+        break;
+      case int16_id:
+        emplace_kernel<int16_t>(cg, option, src_tp[0], ret_tp);
+        break;
+      case int32_id:
+        emplace_kernel<int32_t>(cg, option, src_tp[0], ret_tp);
+        break;
+      case int64_id:
+        emplace_kernel<int64_t>(cg, option, src_tp[0], ret_tp);
+        break;
+      case uint8_id:
+        emplace_kernel<uint8_t>(cg, option, src_tp[0], ret_tp);
+        break;
+      case uint16_id:
+        emplace_kernel<uint16_t>(cg, option, src_tp[0], ret_tp);
+        break;
+      case uint32_id:
+        emplace_kernel<uint32_t>(cg, option, src_tp[0], ret_tp);
+        break;
+      case uint64_id:
+        emplace_kernel<uint64_t>(cg, option, src_tp[0], ret_tp);
+        break;
+      case float32_id:
+        emplace_kernel<float>(cg, option, src_tp[0], ret_tp);
+        break;
+      case float64_id:
+        emplace_kernel<double>(cg, option, src_tp[0], ret_tp);
+        break;
+      default: {
+        std::stringstream ss;
+        ss << "rolling does not support values of type " << value_tp;
+        throw type_error(ss.str());
+      }
+      }
+
+      return ret_tp;
+    }
+  };
+
+  /**
+   * The callable behind ``nd::rolling``, which applies its child along the
+   * innermost dimension and broadcasts over any leading dimensions.
+   */
+  class rolling_callable : public base_callable {
+    callable m_child;
+
+  public:
+    rolling_callable(const callable &child)
+        : base_callable(ndt::type("(Dims... * Scalar) -> Dims... * Scalar")), m_child(child) {}
+
+    ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &cg,
+                      const ndt::type &dst_tp, size_t nsrc, const ndt::type *src_tp, size_t nkwd, const array *kwds,
+                      const std::map<std::string, ndt::type> &tp_vars) {
+      if (src_tp[0].get_ndim() < 1) {
+        std::stringstream ss;
+        ss << "rolling requires at least one dimension, but was given " << src_tp[0];
+        throw type_error(ss.str());
+      }
+
+      return get_elwise2()->resolve(m_child.get(), nullptr, cg, dst_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
+    }
+  };
+
+} // namespace dynd::nd
+} // namespace dynd
@@ -10,12 +10,30 @@
 
 namespace dynd {
 namespace nd {
+  namespace detail {
 
+    template <typename PieceType>
+    ndt::type make_split_piece_type();
+
+    template <>
+    inline ndt::type make_split_piece_type<string>() {
+      return ndt::make_type<string>();
+    }
+
+    template <>
+    inline ndt::type make_split_piece_type<string_piece_offsets>() {
+      return ndt::make_type<intptr_t[2]>();
+    }
+
+  } // namespace dynd::nd::detail
+
+  template <typename PieceType>
   class string_split_callable : public base_callable {
   public:
     string_split_callable()
-        : base_callable(ndt::make_type<ndt::callable_type>(ndt::make_type<ndt::var_dim_type>(ndt::make_type<string>()),
-                                                           {ndt::make_type<string>(), ndt::make_type<string>()})) {}
+        : base_callable(ndt::make_type<ndt::callable_type>(
+              ndt::make_type<ndt::var_dim_type>(detail::make_split_piece_type<PieceType>()),
+              {ndt::make_type<string>(), ndt::make_type<string>()})) {}
 
     ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &cg,
                       const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
@@ -23,7 +41,7 @@ namespace nd {
                       const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars)) {
       cg.emplace_back([](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data), const char *dst_arrmeta,
                          size_t DYND_UNUSED(nsrc), const char *const *DYND_UNUSED(src_arrmeta)) {
-        kb.emplace_back<string_split_kernel>(
+        kb.emplace_back<string_split_kernel<PieceType>>(
             kernreq, reinterpret_cast<const ndt::var_dim_type::metadata_type *>(dst_arrmeta)->blockref);
       });
 
@@ -0,0 +1,97 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <functional>
+#include <iosfwd>
+
+#include <dynd/array.hpp>
+#include <dynd/parse_util.hpp>
+
+namespace dynd {
+
+/**
+ * An error raised while reading delimited text. The record number counts
+ * the records of the input from 1, including the header record if present
+ * and excluding blank lines.
+ */
+class csv_parse_error : public parse_error {
+  intptr_t m_record;
+
+public:
+  csv_parse_error(const char *position, intptr_t record, const std::string &message)
+      : parse_error(position, "CSV parse error on record " + std::to_string(record) + ": " + message), m_record(record)
+  {
+  }
+
+  virtual ~csv_parse_error() throw() {}
+  intptr_t get_record() const { return m_record; }
+};
+
+namespace nd {
+  namespace csv {
+
+    /**
+     * Options controlling how delimited text is read.
+     */
+    struct options {
+      /** The character separating fields within a record. */
+      char delimiter;
+      /** The character used to quote fields, with a doubled quote as its escape. */
+      char quote;
+      /** Whether the first record is a header to be skipped. */
+      bool header;
+      /** Whether to produce a struct of columns instead of an array of structs. */
+      bool columnar;
+      /** The number of threads used to parse the records, or all hardware threads when not positive. */
+      intptr_t thread_count;
+      /** The initial size of the block read at a time when streaming. */
+      size_t buffer_size;
+
+      options()
+          : delimiter(','), quote('"'), header(false), columnar(false), thread_count(1), buffer_size(1 << 22)
+      {
+      }
+    };
+
+    /**
+     * Parses delimited text into an array of the records. The record type must be
+     * a struct whose fields are bool, integer, float32, float64 or string, or an
+     * option of one of those (excluding unsigned integers). An empty field in an
+     * option column becomes NA.
+     *
+     * The result is of type ``N * {...}``, or with ``columnar`` set, a struct with
+     * a ``N * T`` field for each field of the record type.
+     *
+     * \param begin  The beginning of the UTF-8 buffer containing the text.
+     * \param end  One past the end of the buffer.
+     * \param tp  The struct type of a record.
+     * \param opts  The parsing options.
+     */
+    DYND_API array parse(const char *begin, const char *end, const ndt::type &tp, const options &opts = options());
+
+    inline array parse(const std::string &str, const ndt::type &tp, const options &opts = options())
+    {
+      return parse(str.data(), str.data() + str.size(), tp, opts);
+    }
+
+    /**
+     * Reads a whole file of delimited text, as ``nd::csv::parse``.
+     */
+    DYND_API array read(const std::string &filename, const ndt::type &tp, const options &opts = options());
+
+    /**
+     * Reads delimited text from a stream in blocks of ``opts.buffer_size``
+     * bytes, calling ``callback`` with the array of records parsed from each
+     * block. A record longer than the buffer grows it, so memory stays bounded
+     * by the longest record rather than the size of the input.
+     */
+    DYND_API void read(std::istream &in, const ndt::type &tp, const std::function<void(const array &)> &callback,
+                       const options &opts = options());
+
+  } // namespace dynd::nd::csv
+} // namespace dynd::nd
+} // namespace dynd
@@ -0,0 +1,82 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+#include <dynd/callable.hpp>
+
+namespace dynd {
+namespace nd {
+
+  /**
+   * A lazily evaluated elementwise expression over arrays.
+   *
+   * Arithmetic on an expression records the operation instead of performing
+   * it. ``eval`` then compiles the whole expression into a single kernel,
+   * which streams over the arrays once and keeps intermediate results in
+   * small cache-resident blocks. For example,
+   * ``(nd::lazy(a) * b + nd::lazy(c) * d - e).eval()`` allocates only its
+   * result, where ``a * b + c * d - e`` allocates four temporaries.
+   *
+   * The arrays are held by reference, so evaluation sees their values at
+   * the time of the call to ``eval``.
+   */
+  class DYND_API expression {
+    struct node;
+
+    std::shared_ptr<const node> m_node;
+
+  public:
+    /** An expression that evaluates to ``a`` */
+    expression(const array &a);
+
+    /**
+     * An expression that applies the elementwise callable ``f`` to the
+     * values of ``args``.
+     */
+    expression(const callable &f, std::initializer_list<expression> args);
+
+    expression(const callable &f, const std::vector<expression> &args);
+
+    /**
+     * Compiles the expression into a callable that evaluates it in one pass,
+     * filling ``args`` with the arrays to pass to it.
+     *
+     * Intermediate results must have POD types with no arrmeta, as they are
+     * kept in raw buffers.
+     */
+    callable compile(std::vector<array> &args) const;
+
+    /** Evaluates the expression into a new array */
+    array eval() const;
+  };
+
+  /**
+   * Starts a lazy expression from ``a``, so that arithmetic on it builds an
+   * expression instead of evaluating eagerly.
+   */
+  inline expression lazy(const array &a) { return expression(a); }
+
+  DYND_API expression operator-(const expression &e0);
+
+  DYND_API expression operator+(const expression &e0, const expression &e1);
+  DYND_API expression operator+(const expression &e0, const array &a1);
+  DYND_API expression operator+(const array &a0, const expression &e1);
+  DYND_API expression operator-(const expression &e0, const expression &e1);
+  DYND_API expression operator-(const expression &e0, const array &a1);
+  DYND_API expression operator-(const array &a0, const expression &e1);
+  DYND_API expression operator*(const expression &e0, const expression &e1);
+  DYND_API expression operator*(const expression &e0, const array &a1);
+  DYND_API expression operator*(const array &a0, const expression &e1);
+  DYND_API expression operator/(const expression &e0, const expression &e1);
+  DYND_API expression operator/(const expression &e0, const array &a1);
+  DYND_API expression operator/(const array &a0, const expression &e1);
+
+} // namespace dynd::nd
+} // namespace dynd
@@ -0,0 +1,46 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <dynd/callable.hpp>
+
+namespace dynd {
+namespace nd {
+
+  /**
+   * Computes the discrete Fourier transform of an array of complex[float32]
+   * or complex[float64] values with fixed dimensions. It transforms along
+   * the dimensions in the optional ``axes`` keyword, or along all of them,
+   * and treats any other dimensions as a batch of independent transforms.
+   * Any length is supported, though lengths with only small prime factors
+   * are fastest.
+   */
+  extern DYND_API callable fft;
+
+  /**
+   * Computes the inverse of ``fft``, without normalization. The optional
+   * ``scale`` keyword multiplies the result, so that ``1 / n`` gives back
+   * the original values.
+   */
+  extern DYND_API callable ifft;
+
+  /**
+   * Computes the discrete Fourier transform of an array of float32 or
+   * float64 values, keeping only the ``n / 2 + 1`` non-redundant values of
+   * the spectrum along the last axis that is transformed.
+   */
+  extern DYND_API callable rfft;
+
+  /**
+   * Return callables that compute the same transforms as ``fft``, ``ifft`` and
+   * ``rfft``, splitting large batches across ``thread_count`` threads.
+   */
+  DYND_API callable parallel_fft(intptr_t thread_count);
+  DYND_API callable parallel_ifft(intptr_t thread_count);
+  DYND_API callable parallel_rfft(intptr_t thread_count);
+
+} // namespace dynd::nd
+} // namespace dynd
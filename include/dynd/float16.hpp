@@ -27,6 +27,27 @@ DYNDT_API float halfbits_to_float(uint16_t value);
 
 DYNDT_API double halfbits_to_double(uint16_t value);
 
+// Conversions that never raise. Values round to nearest even, underflowing to signed zero or a subnormal and
+// overflowing to signed inf. The assignment kernels use these and check the error mode themselves.
+DYNDT_API uint16_t float_to_halfbits_nocheck(float value);
+
+DYNDT_API uint16_t double_to_halfbits_nocheck(double value);
+
+// Bulk conversions of contiguous arrays. These produce the same results, and raise the same errors, as the single
+// value conversions above, but use the F16C instructions when the CPU has them. The one difference is that the F16C
+// path of float_to_halfbits_nocheck sets the quiet bit of signaling NaNs.
+DYNDT_API void float_to_halfbits(uint16_t *dst, const float *src, size_t count);
+
+DYNDT_API void double_to_halfbits(uint16_t *dst, const double *src, size_t count);
+
+DYNDT_API void float_to_halfbits_nocheck(uint16_t *dst, const float *src, size_t count);
+
+DYNDT_API void double_to_halfbits_nocheck(uint16_t *dst, const double *src, size_t count);
+
+DYNDT_API void halfbits_to_float(float *dst, const uint16_t *src, size_t count);
+
+DYNDT_API void halfbits_to_double(double *dst, const uint16_t *src, size_t count);
+
 class DYNDT_API float16 {
   uint16_t m_bits;
 
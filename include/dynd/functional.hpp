@@ -10,6 +10,7 @@
 #include <dynd/callables/apply_member_function_callable.hpp>
 #include <dynd/callables/construct_then_apply_callable_callable.hpp>
 #include <dynd/callables/forward_na_callable.hpp>
+#include <dynd/kernels/neighborhood.hpp>
 #include <dynd/types/state_type.hpp>
 
 namespace dynd {
@@ -138,22 +139,46 @@ namespace nd {
       return make_callable<forward_na_callable<I...>>(tp, child);
     }
 
-    DYND_API callable outer(const callable &child);
+    /**
+     * Lifts the provided callable into a callable which applies it to every
+     * combination of elements of its array arguments, so that the result
+     * has the dimensions of all the arguments in order.
+     *
+     * When ``child`` is ``nd::add``, ``nd::subtract``, ``nd::multiply`` or
+     * ``nd::divide`` and it is called with two one-dimensional arrays of the
+     * same builtin type, a blocked kernel computes the product, using up to
+     * ``thread_count`` threads for large outputs.
+     */
+    DYND_API callable outer(const callable &child, intptr_t thread_count = 1);
 
     DYND_API ndt::type outer_make_type(const ndt::callable_type *child_tp);
 
     /**
-     * Create an callable which applies a given window_op in a
-     * rolling window fashion.
+     * Creates a callable which applies ``child`` to the window around each
+     * element of an array, in a rolling window fashion. The window is given
+     * by the "shape" keyword, and is shifted by the optional "offset"
+     * keyword, so the window of element ``i`` covers ``[i + offset, i +
+     * offset + shape)``. Any remaining keywords are passed to ``child``.
      *
-     * \param neighborhood_op  An callable object which transforms a
-     *neighborhood
-     *into
-     *                         a single output value. Signature
-     *                         '(Fixed * Fixed * NH, Fixed * Fixed * MSK) ->
-     *OUT',
+     * \param child  A callable which transforms a window, a fixed array with
+     *               one dimension per entry of "shape", into a single value.
+     * \param boundary_child  A callable with no arguments which produces the
+     *                        value for windows crossing an edge of the array.
+     *                        If it is null, such windows are padded with zeros.
+     * \param thread_count  How many threads to spread the tiles of the output
+     *                      over. ``child`` must be safe to call concurrently
+     *                      if this is more than one.
+     */
+    DYND_API callable neighborhood(const callable &child, const callable &boundary_child = callable(),
+                                   intptr_t thread_count = 1);
+
+    /**
+     * Creates a callable which applies ``child`` to the window around each
+     * element of an array, padding the windows that cross an edge of the
+     * array as ``boundary_mode`` says.
      */
-    DYND_API callable neighborhood(const callable &child, const callable &boundary_child = callable());
+    DYND_API callable neighborhood(const callable &child, neighborhood_boundary_mode boundary_mode,
+                                   intptr_t thread_count = 1);
 
     /**
      * Lifts the provided callable, broadcasting it as necessary to execute
@@ -5,6 +5,9 @@
 
 #pragma once
 
+#include <iosfwd>
+
+#include <dynd/array.hpp>
 #include <dynd/callable.hpp>
 
 namespace dynd {
@@ -12,5 +15,39 @@ namespace nd {
 
   extern DYND_API callable serialize;
 
+  /**
+   * Writes an array to a stream in the dynd binary format. The type is stored
+   * as datashape in a header, followed by the values in the default layout of
+   * the type. Strings, bytes and var dims are stored as offsets relative to the
+   * start of the values, so the payload contains no pointers. The output is
+   * written in a single sequential pass.
+   *
+   * \param o  The stream to write to, which should be opened in binary mode.
+   * \param a  The array to write.
+   */
+  DYND_API void save(std::ostream &o, const array &a);
+
+  DYND_API void save(const std::string &filename, const array &a);
+
+  /**
+   * Reads an array in the dynd binary format from a buffer. If ``owner`` is
+   * provided and the type holds no strings, bytes or var dims, the result is an
+   * immutable view of the buffer which keeps ``owner`` alive; otherwise the
+   * values are copied.
+   *
+   * \param begin  The beginning of the buffer.
+   * \param end  One past the end of the buffer.
+   * \param owner  A reference to the memory holding the buffer, or null.
+   */
+  DYND_API array load(const char *begin, const char *end, const memory_block &owner = memory_block());
+
+  DYND_API array load(std::istream &in);
+
+  /**
+   * Reads an array in the dynd binary format from a file, memory mapping it so
+   * that arrays of fixed-size types are loaded without copying.
+   */
+  DYND_API array load(const std::string &filename);
+
 } // namespace dynd::nd
 } // namespace dynd
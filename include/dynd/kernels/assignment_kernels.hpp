@@ -6,6 +6,7 @@
 #pragma once
 
 #include <stdexcept>
+#include <string>
 
 #include <dynd/assignment.hpp>
 #include <dynd/eval/eval_context.hpp>
@@ -23,6 +24,7 @@
 #include <dynd/types/fixed_bytes_type.hpp>
 #include <dynd/types/fixed_string_type.hpp>
 #include <dynd/types/option_type.hpp>
+#include <dynd/types/scalar_kind_type.hpp>
 #include <dynd/types/type_id.hpp>
 #include <map>
 
@@ -87,6 +89,91 @@ namespace nd {
     template <typename ReturnType, typename Arg0Type, typename Enable = void>
     struct assignment_virtual_kernel;
 
+    /**
+     * Base for the checked builtin assignment kernels. Rather than checking each element as it is converted,
+     * the strided loop validates a block of DYND_BUFFER_CHUNK_SIZE elements at a time with the branch-free
+     * SelfType::is_valid predicate, and converts the block with a plain cast when it passes. Only a block that
+     * fails goes through the precise per-element single(), which raises on the first offending element in order.
+     */
+    template <typename SelfType, typename ReturnType, typename Arg0Type>
+    struct base_checked_assignment_kernel : base_strided_kernel<SelfType, 1> {
+      static ReturnType convert(Arg0Type s) { return static_cast<ReturnType>(s); }
+
+      // Converts a contiguous block that passed is_valid
+      static void convert_block(ReturnType *dst, const Arg0Type *src, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+          dst[i] = SelfType::convert(src[i]);
+        }
+      }
+
+      void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count) {
+        char *src0 = src[0];
+        intptr_t src0_stride = src_stride[0];
+        size_t index = 0;
+        if (dst_stride == sizeof(ReturnType) && src0_stride == sizeof(Arg0Type)) {
+          while (count > 0) {
+            size_t chunk_size = std::min(count, static_cast<size_t>(DYND_BUFFER_CHUNK_SIZE));
+            ReturnType *d = reinterpret_cast<ReturnType *>(dst);
+            const Arg0Type *s = reinterpret_cast<const Arg0Type *>(src0);
+            bool valid = true;
+            for (size_t i = 0; i < chunk_size; ++i) {
+              valid &= SelfType::is_valid(s[i]);
+            }
+            if (valid) {
+              SelfType::convert_block(d, s, chunk_size);
+            } else {
+              single_chunk(dst, dst_stride, src0, src0_stride, chunk_size, index);
+            }
+            dst += chunk_size * dst_stride;
+            src0 += chunk_size * src0_stride;
+            count -= chunk_size;
+            index += chunk_size;
+          }
+        } else {
+          while (count > 0) {
+            size_t chunk_size = std::min(count, static_cast<size_t>(DYND_BUFFER_CHUNK_SIZE));
+            bool valid = true;
+            for (size_t i = 0; i < chunk_size; ++i) {
+              valid &= SelfType::is_valid(*reinterpret_cast<const Arg0Type *>(src0 + i * src0_stride));
+            }
+            if (valid) {
+              for (size_t i = 0; i < chunk_size; ++i) {
+                *reinterpret_cast<ReturnType *>(dst + i * dst_stride) =
+                    SelfType::convert(*reinterpret_cast<const Arg0Type *>(src0 + i * src0_stride));
+              }
+            } else {
+              single_chunk(dst, dst_stride, src0, src0_stride, chunk_size, index);
+            }
+            dst += chunk_size * dst_stride;
+            src0 += chunk_size * src0_stride;
+            count -= chunk_size;
+            index += chunk_size;
+          }
+        }
+      }
+
+    private:
+      static std::string at_index(const char *what, size_t index) {
+        return std::string(what) + " at index " + std::to_string(index);
+      }
+
+      // Replays a block element by element, adding the index of the offending element to the error
+      void single_chunk(char *dst, intptr_t dst_stride, char *src0, intptr_t src0_stride, size_t count,
+                        size_t first_index) {
+        for (size_t i = 0; i < count; ++i) {
+          try {
+            reinterpret_cast<SelfType *>(this)->single(dst, &src0);
+          } catch (const std::overflow_error &e) {
+            throw std::overflow_error(at_index(e.what(), first_index + i));
+          } catch (const std::runtime_error &e) {
+            throw std::runtime_error(at_index(e.what(), first_index + i));
+          }
+          dst += dst_stride;
+          src0 += src0_stride;
+        }
+      }
+    };
+
     template <typename ReturnType, typename Arg0Type, assign_error_mode ErrorMode, typename Enable = void>
     struct assignment_kernel : base_strided_kernel<assignment_kernel<ReturnType, Arg0Type, ErrorMode>, 1> {
       void single(char *dst, char *const *src) {
@@ -199,7 +286,10 @@ namespace nd {
     struct assignment_kernel<
         ReturnType, Arg0Type, assign_error_inexact,
         std::enable_if_t<is_floating_point<ReturnType>::value && is_unsigned_integral<Arg0Type>::value>>
-        : base_strided_kernel<assignment_kernel<ReturnType, Arg0Type, assign_error_inexact>, 1> {
+        : base_checked_assignment_kernel<assignment_kernel<ReturnType, Arg0Type, assign_error_inexact>, ReturnType,
+                                         Arg0Type> {
+      static bool is_valid(Arg0Type s) { return static_cast<Arg0Type>(static_cast<ReturnType>(s)) == s; }
+
       void single(char *dst, char *const *src) {
         *reinterpret_cast<ReturnType *>(dst) =
             check_cast<ReturnType>(*reinterpret_cast<Arg0Type *>(src[0]), inexact_check);
@@ -260,7 +350,12 @@ namespace nd {
     struct assignment_kernel<
         ReturnType, Arg0Type, assign_error_overflow,
         std::enable_if_t<is_signed_integral<ReturnType>::value && is_floating_point<Arg0Type>::value>>
-        : base_strided_kernel<assignment_kernel<ReturnType, Arg0Type, assign_error_overflow>, 1> {
+        : base_checked_assignment_kernel<assignment_kernel<ReturnType, Arg0Type, assign_error_overflow>, ReturnType,
+                                         Arg0Type> {
+      static bool is_valid(Arg0Type s) {
+        return !(s < std::numeric_limits<ReturnType>::min()) & !(std::numeric_limits<ReturnType>::max() < s);
+      }
+
       void single(char *dst, char *const *src) {
         *reinterpret_cast<ReturnType *>(dst) = overflow_cast<ReturnType>(*reinterpret_cast<Arg0Type *>(src[0]));
       }
@@ -271,7 +366,13 @@ namespace nd {
     struct assignment_kernel<
         ReturnType, Arg0Type, assign_error_fractional,
         std::enable_if_t<is_signed_integral<ReturnType>::value && is_floating_point<Arg0Type>::value>>
-        : base_strided_kernel<assignment_kernel<ReturnType, Arg0Type, assign_error_fractional>, 1> {
+        : base_checked_assignment_kernel<assignment_kernel<ReturnType, Arg0Type, assign_error_fractional>, ReturnType,
+                                         Arg0Type> {
+      static bool is_valid(Arg0Type s) {
+        return !(s < std::numeric_limits<ReturnType>::min()) & !(std::numeric_limits<ReturnType>::max() < s) &
+               (floor(s) == s);
+      }
+
       void single(char *dst, char *const *src) {
         *reinterpret_cast<ReturnType *>(dst) = fractional_cast<ReturnType>(*reinterpret_cast<Arg0Type *>(src[0]));
       }
@@ -315,7 +416,10 @@ namespace nd {
     struct assignment_kernel<
         ReturnType, Arg0Type, assign_error_overflow,
         std::enable_if_t<is_unsigned_integral<ReturnType>::value && is_floating_point<Arg0Type>::value>>
-        : base_strided_kernel<assignment_kernel<ReturnType, Arg0Type, assign_error_overflow>, 1> {
+        : base_checked_assignment_kernel<assignment_kernel<ReturnType, Arg0Type, assign_error_overflow>, ReturnType,
+                                         Arg0Type> {
+      static bool is_valid(Arg0Type s) { return !(s < 0) & !(std::numeric_limits<ReturnType>::max() < s); }
+
       void single(char *dst, char *const *src) {
         *reinterpret_cast<ReturnType *>(dst) = overflow_cast<ReturnType>(*reinterpret_cast<Arg0Type *>(src[0]));
       }
@@ -326,7 +430,12 @@ namespace nd {
     struct assignment_kernel<
         ReturnType, Arg0Type, assign_error_fractional,
         std::enable_if_t<is_unsigned_integral<ReturnType>::value && is_floating_point<Arg0Type>::value>>
-        : base_strided_kernel<assignment_kernel<ReturnType, Arg0Type, assign_error_fractional>, 1> {
+        : base_checked_assignment_kernel<assignment_kernel<ReturnType, Arg0Type, assign_error_fractional>, ReturnType,
+                                         Arg0Type> {
+      static bool is_valid(Arg0Type s) {
+        return !(s < 0) & !(std::numeric_limits<ReturnType>::max() < s) & (floor(s) == s);
+      }
+
       void single(char *dst, char *const *src) {
         *reinterpret_cast<ReturnType *>(dst) = fractional_cast<ReturnType>(*reinterpret_cast<Arg0Type *>(src[0]));
       }
@@ -448,7 +557,13 @@ namespace nd {
     struct assignment_kernel<
         ReturnType, Arg0Type, assign_error_overflow,
         std::enable_if_t<is_floating_point<ReturnType>::value && is_floating_point<Arg0Type>::value>>
-        : base_strided_kernel<assignment_kernel<ReturnType, Arg0Type, assign_error_overflow>, 1> {
+        : base_checked_assignment_kernel<assignment_kernel<ReturnType, Arg0Type, assign_error_overflow>, ReturnType,
+                                         Arg0Type> {
+      static bool is_valid(Arg0Type s) {
+        return !isfinite(s) |
+               !((s < -std::numeric_limits<ReturnType>::max()) | (s > std::numeric_limits<ReturnType>::max()));
+      }
+
       void single(char *dst, char *const *src) {
         *reinterpret_cast<ReturnType *>(dst) = overflow_cast<ReturnType>(*reinterpret_cast<Arg0Type *>(src[0]));
       }
@@ -466,7 +581,10 @@ namespace nd {
     struct assignment_kernel<
         ReturnType, Arg0Type, assign_error_inexact,
         std::enable_if_t<is_floating_point<ReturnType>::value && is_floating_point<Arg0Type>::value>>
-        : base_strided_kernel<assignment_kernel<ReturnType, Arg0Type, assign_error_inexact>, 1> {
+        : base_checked_assignment_kernel<assignment_kernel<ReturnType, Arg0Type, assign_error_inexact>, ReturnType,
+                                         Arg0Type> {
+      static bool is_valid(Arg0Type s) { return static_cast<Arg0Type>(static_cast<ReturnType>(s)) == s; }
+
       void single(char *dst, char *const *src) {
         *reinterpret_cast<ReturnType *>(dst) =
             check_cast<ReturnType>(*reinterpret_cast<Arg0Type *>(src[0]), inexact_check);
@@ -476,7 +594,11 @@ namespace nd {
     // Anything -> boolean with overflow checking
     template <typename Arg0Type>
     struct assignment_kernel<bool1, Arg0Type, assign_error_overflow>
-        : base_strided_kernel<assignment_kernel<bool1, Arg0Type, assign_error_overflow>, 1> {
+        : base_checked_assignment_kernel<assignment_kernel<bool1, Arg0Type, assign_error_overflow>, bool1, Arg0Type> {
+      static bool is_valid(Arg0Type s) { return (s == Arg0Type(0)) | (s == Arg0Type(1)); }
+
+      static bool1 convert(Arg0Type s) { return bool1(s != Arg0Type(0)); }
+
       void single(char *dst, char *const *src) {
         *reinterpret_cast<bool1 *>(dst) = overflow_cast<bool1>(*reinterpret_cast<Arg0Type *>(src[0]));
       }
@@ -522,7 +644,10 @@ namespace nd {
     struct assignment_kernel<
         ReturnType, Arg0Type, assign_error_overflow,
         std::enable_if_t<is_signed_integral<ReturnType>::value && is_signed_integral<Arg0Type>::value>>
-        : base_strided_kernel<assignment_kernel<ReturnType, Arg0Type, assign_error_overflow>, 1> {
+        : base_checked_assignment_kernel<assignment_kernel<ReturnType, Arg0Type, assign_error_overflow>, ReturnType,
+                                         Arg0Type> {
+      static bool is_valid(Arg0Type s) { return !is_overflow<ReturnType>(s); }
+
       void single(char *dst, char *const *src) {
         *reinterpret_cast<ReturnType *>(dst) = overflow_cast<ReturnType>(*reinterpret_cast<Arg0Type *>(src[0]));
       }
@@ -546,7 +671,10 @@ namespace nd {
     struct assignment_kernel<
         ReturnType, Arg0Type, assign_error_overflow,
         std::enable_if_t<is_signed_integral<ReturnType>::value && is_unsigned_integral<Arg0Type>::value>>
-        : base_strided_kernel<assignment_kernel<ReturnType, Arg0Type, assign_error_overflow>, 1> {
+        : base_checked_assignment_kernel<assignment_kernel<ReturnType, Arg0Type, assign_error_overflow>, ReturnType,
+                                         Arg0Type> {
+      static bool is_valid(Arg0Type s) { return !is_overflow<ReturnType>(s); }
+
       void single(char *dst, char *const *src) {
         *reinterpret_cast<ReturnType *>(dst) = overflow_cast<ReturnType>(*reinterpret_cast<Arg0Type *>(src[0]));
       }
@@ -570,7 +698,10 @@ namespace nd {
     struct assignment_kernel<
         ReturnType, Arg0Type, assign_error_overflow,
         std::enable_if_t<is_unsigned_integral<ReturnType>::value && is_signed_integral<Arg0Type>::value>>
-        : base_strided_kernel<assignment_kernel<ReturnType, Arg0Type, assign_error_overflow>, 1> {
+        : base_checked_assignment_kernel<assignment_kernel<ReturnType, Arg0Type, assign_error_overflow>, ReturnType,
+                                         Arg0Type> {
+      static bool is_valid(Arg0Type s) { return !is_overflow<ReturnType>(s); }
+
       void single(char *dst, char *const *src) {
         *reinterpret_cast<ReturnType *>(dst) = overflow_cast<ReturnType>(*reinterpret_cast<Arg0Type *>(src[0]));
       }
@@ -594,7 +725,10 @@ namespace nd {
     struct assignment_kernel<
         ReturnType, Arg0Type, assign_error_overflow,
         std::enable_if_t<is_unsigned_integral<ReturnType>::value && is_unsigned_integral<Arg0Type>::value>>
-        : base_strided_kernel<assignment_kernel<ReturnType, Arg0Type, assign_error_overflow>, 1> {
+        : base_checked_assignment_kernel<assignment_kernel<ReturnType, Arg0Type, assign_error_overflow>, ReturnType,
+                                         Arg0Type> {
+      static bool is_valid(Arg0Type s) { return !is_overflow<ReturnType>(s); }
+
       void single(char *dst, char *const *src) {
         *reinterpret_cast<ReturnType *>(dst) = overflow_cast<ReturnType>(*reinterpret_cast<Arg0Type *>(src[0]));
       }
@@ -618,7 +752,10 @@ namespace nd {
     struct assignment_kernel<
         ReturnType, Arg0Type, assign_error_inexact,
         std::enable_if_t<is_floating_point<ReturnType>::value && is_signed_integral<Arg0Type>::value>>
-        : base_strided_kernel<assignment_kernel<ReturnType, Arg0Type, assign_error_inexact>, 1> {
+        : base_checked_assignment_kernel<assignment_kernel<ReturnType, Arg0Type, assign_error_inexact>, ReturnType,
+                                         Arg0Type> {
+      static bool is_valid(Arg0Type s) { return static_cast<Arg0Type>(static_cast<ReturnType>(s)) == s; }
+
       void single(char *dst, char *const *src) {
         *reinterpret_cast<ReturnType *>(dst) =
             check_cast<ReturnType>(*reinterpret_cast<Arg0Type *>(src[0]), inexact_check);
@@ -1200,6 +1337,142 @@ namespace nd {
       }
     };
 
+    /**
+     * Assignment between float16 and float32/float64 with no checking. Values round quietly to nearest even, so
+     * contiguous runs go through the bulk conversions in float16.hpp, which use F16C instructions when the CPU has
+     * them.
+     */
+    template <typename ReturnType, typename Arg0Type, assign_error_mode ErrorMode>
+    struct float16_assignment_kernel : base_strided_kernel<assignment_kernel<ReturnType, Arg0Type, ErrorMode>, 1> {
+      typedef base_strided_kernel<assignment_kernel<ReturnType, Arg0Type, ErrorMode>, 1> parent_type;
+
+      void single(char *dst, char *const *src) {
+        assign(reinterpret_cast<ReturnType *>(dst), *reinterpret_cast<Arg0Type *>(src[0]));
+      }
+
+      void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count) {
+        if (dst_stride == sizeof(ReturnType) && src_stride[0] == sizeof(Arg0Type)) {
+          convert_block(reinterpret_cast<ReturnType *>(dst), reinterpret_cast<const Arg0Type *>(src[0]), count);
+        } else {
+          parent_type::strided(dst, dst_stride, src, src_stride, count);
+        }
+      }
+
+      static void assign(float16 *dst, float s) { *dst = float16_from_bits(float_to_halfbits_nocheck(s)); }
+
+      static void assign(float16 *dst, double s) { *dst = float16_from_bits(double_to_halfbits_nocheck(s)); }
+
+      static void assign(float *dst, float16 s) { *dst = halfbits_to_float(s.bits()); }
+
+      static void assign(double *dst, float16 s) { *dst = halfbits_to_double(s.bits()); }
+
+      static void convert_block(float16 *dst, const float *src, size_t count) {
+        float_to_halfbits_nocheck(reinterpret_cast<uint16_t *>(dst), src, count);
+      }
+
+      static void convert_block(float16 *dst, const double *src, size_t count) {
+        double_to_halfbits_nocheck(reinterpret_cast<uint16_t *>(dst), src, count);
+      }
+
+      static void convert_block(float *dst, const float16 *src, size_t count) {
+        halfbits_to_float(dst, reinterpret_cast<const uint16_t *>(src), count);
+      }
+
+      static void convert_block(double *dst, const float16 *src, size_t count) {
+        halfbits_to_double(dst, reinterpret_cast<const uint16_t *>(src), count);
+      }
+    };
+
+    /**
+     * Assignment from float32/float64 to float16 with overflow or inexact checking. As with the other real -> real
+     * kernels, fractional checking is the same as overflow checking. Blocks that pass is_valid are converted with the
+     * bulk conversions.
+     */
+    template <typename Arg0Type, assign_error_mode ErrorMode>
+    struct float16_checked_assignment_kernel
+        : base_checked_assignment_kernel<assignment_kernel<float16, Arg0Type, ErrorMode>, float16, Arg0Type> {
+      // Values at or past 65520 round up to inf
+      static bool is_in_range(Arg0Type s) { return !isfinite(s) | (fabs(s) < 65520); }
+
+      // Whether s is a float16 value: no more than 11 significant bits, and a multiple of 2^-24 below the smallest
+      // normal float16
+      static bool is_exact(Arg0Type s) {
+        typedef typename std::conditional<sizeof(Arg0Type) == 4, uint32_t, uint64_t>::type bits_type;
+        const bits_type low_bits = (static_cast<bits_type>(1) << (std::numeric_limits<Arg0Type>::digits - 11)) - 1;
+        Arg0Type a = fabs(s);
+        Arg0Type scaled = a * 16777216;
+        return (a <= 65504) & ((alias_cast<bits_type>(s) & low_bits) == 0) &
+               ((a >= 6.103515625e-05) | (floor(scaled) == scaled));
+      }
+
+      static bool is_valid(Arg0Type s) {
+        return (ErrorMode == assign_error_inexact) ? !isfinite(s) | is_exact(s) : is_in_range(s);
+      }
+
+      static float16 convert(Arg0Type s) {
+        float16 d;
+        float16_assignment_kernel<float16, Arg0Type, assign_error_nocheck>::assign(&d, s);
+        return d;
+      }
+
+      static void convert_block(float16 *dst, const Arg0Type *src, size_t count) {
+        float16_assignment_kernel<float16, Arg0Type, assign_error_nocheck>::convert_block(dst, src, count);
+      }
+
+      void single(char *dst, char *const *src) {
+        Arg0Type s = *reinterpret_cast<Arg0Type *>(src[0]);
+        float16 d = convert(s);
+        if (!is_in_range(s)) {
+          std::stringstream ss;
+          ss << "overflow while assigning " << ndt::make_type<Arg0Type>() << " value " << s << " to float16";
+          throw std::overflow_error(ss.str());
+        }
+        if (ErrorMode == assign_error_inexact && isfinite(s) && !is_exact(s)) {
+          std::stringstream ss;
+          ss << "inexact value while assigning " << ndt::make_type<Arg0Type>() << " value " << s
+             << " to float16 value " << static_cast<float>(d);
+          throw std::runtime_error(ss.str());
+        }
+        *reinterpret_cast<float16 *>(dst) = d;
+      }
+    };
+
+    template <assign_error_mode ErrorMode>
+    struct assignment_kernel<float16, float, ErrorMode> : float16_assignment_kernel<float16, float, ErrorMode> {};
+
+    template <assign_error_mode ErrorMode>
+    struct assignment_kernel<float16, double, ErrorMode> : float16_assignment_kernel<float16, double, ErrorMode> {};
+
+    template <>
+    struct assignment_kernel<float16, float, assign_error_overflow>
+        : float16_checked_assignment_kernel<float, assign_error_overflow> {};
+
+    template <>
+    struct assignment_kernel<float16, float, assign_error_fractional>
+        : float16_checked_assignment_kernel<float, assign_error_fractional> {};
+
+    template <>
+    struct assignment_kernel<float16, float, assign_error_inexact>
+        : float16_checked_assignment_kernel<float, assign_error_inexact> {};
+
+    template <>
+    struct assignment_kernel<float16, double, assign_error_overflow>
+        : float16_checked_assignment_kernel<double, assign_error_overflow> {};
+
+    template <>
+    struct assignment_kernel<float16, double, assign_error_fractional>
+        : float16_checked_assignment_kernel<double, assign_error_fractional> {};
+
+    template <>
+    struct assignment_kernel<float16, double, assign_error_inexact>
+        : float16_checked_assignment_kernel<double, assign_error_inexact> {};
+
+    template <assign_error_mode ErrorMode>
+    struct assignment_kernel<float, float16, ErrorMode> : float16_assignment_kernel<float, float16, ErrorMode> {};
+
+    template <assign_error_mode ErrorMode>
+    struct assignment_kernel<double, float16, ErrorMode> : float16_assignment_kernel<double, float16, ErrorMode> {};
+
     template <assign_error_mode ErrorMode>
     struct assignment_kernel<float, string, ErrorMode>
         : base_strided_kernel<assignment_kernel<float, string, ErrorMode>, 1> {
@@ -1446,6 +1719,69 @@ namespace nd {
       }
     };
 
+    /**
+     * Assigns values of the category type into a categorical, looking the
+     * whole strided range up in the categorical's hash table at once.
+     */
+    template <assign_error_mode ErrorMode>
+    struct assignment_kernel<ndt::categorical_type, ndt::scalar_kind_type, ErrorMode>
+        : base_strided_kernel<assignment_kernel<ndt::categorical_type, ndt::scalar_kind_type, ErrorMode>, 1> {
+      ndt::type dst_tp;
+      const char *src_arrmeta;
+
+      assignment_kernel(const ndt::type &dst_tp, const char *src_arrmeta) : dst_tp(dst_tp), src_arrmeta(src_arrmeta) {}
+
+      void single(char *dst, char *const *src) {
+        dst_tp.extended<ndt::categorical_type>()->get_values_from_categories(dst, 0, src_arrmeta, src[0], 0, 1);
+      }
+
+      void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count) {
+        dst_tp.extended<ndt::categorical_type>()->get_values_from_categories(dst, dst_stride, src_arrmeta, src[0],
+                                                                             src_stride[0], count);
+      }
+    };
+
+    /**
+     * Assigns values of any other type into a categorical. The child kernel
+     * assigns them into a buffer of the category type, a chunk at a time,
+     * and the buffer is then looked up like the kernel above.
+     */
+    struct categorical_buffered_assign_kernel : base_strided_kernel<categorical_buffered_assign_kernel, 1> {
+      ndt::type dst_tp;
+      array buffer;
+      const char *buffer_arrmeta;
+      intptr_t buffer_stride;
+
+      categorical_buffered_assign_kernel(const ndt::type &dst_tp)
+          : dst_tp(dst_tp),
+            buffer(empty(DYND_BUFFER_CHUNK_SIZE, dst_tp.extended<ndt::categorical_type>()->get_category_type())),
+            buffer_arrmeta(buffer->metadata() + sizeof(fixed_dim_type_arrmeta)),
+            buffer_stride(reinterpret_cast<const fixed_dim_type_arrmeta *>(buffer->metadata())->stride) {}
+
+      ~categorical_buffered_assign_kernel() { get_child()->destroy(); }
+
+      void single(char *dst, char *const *src) {
+        char *buffer_data = buffer.data();
+        get_child()->single(buffer_data, src);
+        dst_tp.extended<ndt::categorical_type>()->get_values_from_categories(dst, 0, buffer_arrmeta, buffer_data, 0, 1);
+      }
+
+      void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count) {
+        kernel_prefix *child = get_child();
+        char *buffer_data = buffer.data();
+        char *src0 = src[0];
+        while (count > 0) {
+          size_t chunk_size = std::min(count, static_cast<size_t>(DYND_BUFFER_CHUNK_SIZE));
+          child->strided(buffer_data, buffer_stride, &src0, src_stride, chunk_size);
+          dst_tp.extended<ndt::categorical_type>()->get_values_from_categories(dst, dst_stride, buffer_arrmeta,
+                                                                               buffer_data, buffer_stride, chunk_size);
+          dst += chunk_size * dst_stride;
+          src0 += chunk_size * src_stride[0];
+          count -= chunk_size;
+        }
+      }
+    };
+
   } // namespace dynd::nd::detail
 
   template <typename ReturnType, typename Arg0Type>
@@ -0,0 +1,530 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include <dynd/kernels/base_strided_kernel.hpp>
+#include <dynd/parallel.hpp>
+
+namespace dynd {
+namespace nd {
+  namespace detail {
+
+    /**
+     * A mixed-radix plan for complex transforms of one length, in one
+     * direction (``sign`` is -1 for forward transforms and 1 for inverse ones).
+     *
+     * The transform is a self-sorting Stockham decomposition into radix 4, 2,
+     * 3 and then any remaining prime factors, which ping-pongs between two
+     * buffers. The values are split into real and imaginary parts, and
+     * ``batch`` transforms are interleaved, so that element k of transform b
+     * is at ``k * batch + b``. Every butterfly then runs over a contiguous
+     * range of ``stride * batch`` independent lanes. GCC leaves these loops
+     * scalar, because they use more pointers than it checks for aliasing at
+     * run time. Forcing them to vectorize made short float32 transforms up to
+     * 2.7 times as fast, but float64 and long transforms slower, so there is
+     * no vector version yet.
+     *
+     * A prime factor p without its own butterfly costs O(p) operations per
+     * value, so lengths with a prime factor above ``bluestein_threshold`` are
+     * instead transformed with Bluestein's algorithm. It turns the transform
+     * into a convolution, which is done with two transforms of a power of two
+     * length of at least ``2 * size - 1``.
+     */
+    template <typename T>
+    class fft_plan {
+      static const intptr_t bluestein_threshold = 48;
+
+      struct stage {
+        intptr_t radix;
+        intptr_t m;
+        // The twiddle factors for output t > 0 of butterfly j, at j * (radix - 1) + t - 1
+        std::vector<T> twiddle_re;
+        std::vector<T> twiddle_im;
+        // The radix-th roots of unity, for the radices without their own butterfly
+        std::vector<T> root_re;
+        std::vector<T> root_im;
+      };
+
+      intptr_t m_size;
+      int m_sign;
+      std::vector<stage> m_stages;
+      // For Bluestein's algorithm, the chirp exp(sign * i * pi * k^2 / size),
+      // the transform of the kernel it is convolved with, divided by the
+      // convolution length, and the plans for that length
+      intptr_t m_buffer_size;
+      std::vector<T> m_chirp_re;
+      std::vector<T> m_chirp_im;
+      std::vector<T> m_kernel_re;
+      std::vector<T> m_kernel_im;
+      std::shared_ptr<const fft_plan> m_forward;
+      std::shared_ptr<const fft_plan> m_inverse;
+
+      static void twiddle(T &re, T &im, T w_re, T w_im) {
+        T tmp = re * w_re - im * w_im;
+        im = re * w_im + im * w_re;
+        re = tmp;
+      }
+
+      void radix2(const stage &st, intptr_t lanes, const T *x_re, const T *x_im, T *y_re, T *y_im) const {
+        for (intptr_t j = 0; j < st.m; ++j) {
+          const T *a_re = x_re + j * lanes, *a_im = x_im + j * lanes;
+          const T *b_re = a_re + st.m * lanes, *b_im = a_im + st.m * lanes;
+          T *c0_re = y_re + 2 * j * lanes, *c0_im = y_im + 2 * j * lanes;
+          T *c1_re = c0_re + lanes, *c1_im = c0_im + lanes;
+          T w_re = st.twiddle_re[j], w_im = st.twiddle_im[j];
+          for (intptr_t l = 0; l < lanes; ++l) {
+            c0_re[l] = a_re[l] + b_re[l];
+            c0_im[l] = a_im[l] + b_im[l];
+            T d_re = a_re[l] - b_re[l], d_im = a_im[l] - b_im[l];
+            c1_re[l] = d_re * w_re - d_im * w_im;
+            c1_im[l] = d_re * w_im + d_im * w_re;
+          }
+        }
+      }
+
+      void radix3(const stage &st, intptr_t lanes, const T *x_re, const T *x_im, T *y_re, T *y_im) const {
+        const T sin60 = static_cast<T>(m_sign * 0.86602540378443864676);
+        for (intptr_t j = 0; j < st.m; ++j) {
+          const T *a0_re = x_re + j * lanes, *a0_im = x_im + j * lanes;
+          const T *a1_re = a0_re + st.m * lanes, *a1_im = a0_im + st.m * lanes;
+          const T *a2_re = a1_re + st.m * lanes, *a2_im = a1_im + st.m * lanes;
+          T *c0_re = y_re + 3 * j * lanes, *c0_im = y_im + 3 * j * lanes;
+          T *c1_re = c0_re + lanes, *c1_im = c0_im + lanes;
+          T *c2_re = c1_re + lanes, *c2_im = c1_im + lanes;
+          T w1_re = st.twiddle_re[2 * j], w1_im = st.twiddle_im[2 * j];
+          T w2_re = st.twiddle_re[2 * j + 1], w2_im = st.twiddle_im[2 * j + 1];
+          for (intptr_t l = 0; l < lanes; ++l) {
+            T s_re = a1_re[l] + a2_re[l], s_im = a1_im[l] + a2_im[l];
+            T d_re = a1_re[l] - a2_re[l], d_im = a1_im[l] - a2_im[l];
+            T h_re = a0_re[l] - s_re / 2, h_im = a0_im[l] - s_im / 2;
+            c0_re[l] = a0_re[l] + s_re;
+            c0_im[l] = a0_im[l] + s_im;
+            // h +/- i * sin60 * d
+            T t1_re = h_re - sin60 * d_im, t1_im = h_im + sin60 * d_re;
+            T t2_re = h_re + sin60 * d_im, t2_im = h_im - sin60 * d_re;
+            c1_re[l] = t1_re * w1_re - t1_im * w1_im;
+            c1_im[l] = t1_re * w1_im + t1_im * w1_re;
+            c2_re[l] = t2_re * w2_re - t2_im * w2_im;
+            c2_im[l] = t2_re * w2_im + t2_im * w2_re;
+          }
+        }
+      }
+
+      void radix4(const stage &st, intptr_t lanes, const T *x_re, const T *x_im, T *y_re, T *y_im) const {
+        const T sign = static_cast<T>(m_sign);
+        for (intptr_t j = 0; j < st.m; ++j) {
+          const T *a0_re = x_re + j * lanes, *a0_im = x_im + j * lanes;
+          const T *a1_re = a0_re + st.m * lanes, *a1_im = a0_im + st.m * lanes;
+          const T *a2_re = a1_re + st.m * lanes, *a2_im = a1_im + st.m * lanes;
+          const T *a3_re = a2_re + st.m * lanes, *a3_im = a2_im + st.m * lanes;
+          T *c0_re = y_re + 4 * j * lanes, *c0_im = y_im + 4 * j * lanes;
+          T *c1_re = c0_re + lanes, *c1_im = c0_im + lanes;
+          T *c2_re = c1_re + lanes, *c2_im = c1_im + lanes;
+          T *c3_re = c2_re + lanes, *c3_im = c2_im + lanes;
+          const T *w_re = &st.twiddle_re[3 * j], *w_im = &st.twiddle_im[3 * j];
+          T w1_re = w_re[0], w1_im = w_im[0], w2_re = w_re[1], w2_im = w_im[1], w3_re = w_re[2], w3_im = w_im[2];
+          for (intptr_t l = 0; l < lanes; ++l) {
+            T s02_re = a0_re[l] + a2_re[l], s02_im = a0_im[l] + a2_im[l];
+            T d02_re = a0_re[l] - a2_re[l], d02_im = a0_im[l] - a2_im[l];
+            T s13_re = a1_re[l] + a3_re[l], s13_im = a1_im[l] + a3_im[l];
+            T d13_re = a1_re[l] - a3_re[l], d13_im = a1_im[l] - a3_im[l];
+            // The fourth root of unity is sign * i, so it maps d13 to sign * (-d13_im, d13_re)
+            T r_re = -sign * d13_im, r_im = sign * d13_re;
+            c0_re[l] = s02_re + s13_re;
+            c0_im[l] = s02_im + s13_im;
+            T t1_re = d02_re + r_re, t1_im = d02_im + r_im;
+            T t2_re = s02_re - s13_re, t2_im = s02_im - s13_im;
+            T t3_re = d02_re - r_re, t3_im = d02_im - r_im;
+            c1_re[l] = t1_re * w1_re - t1_im * w1_im;
+            c1_im[l] = t1_re * w1_im + t1_im * w1_re;
+            c2_re[l] = t2_re * w2_re - t2_im * w2_im;
+            c2_im[l] = t2_re * w2_im + t2_im * w2_re;
+            c3_re[l] = t3_re * w3_re - t3_im * w3_im;
+            c3_im[l] = t3_re * w3_im + t3_im * w3_re;
+          }
+        }
+      }
+
+      void radixn(const stage &st, intptr_t lanes, const T *x_re, const T *x_im, T *y_re, T *y_im) const {
+        intptr_t p = st.radix;
+        for (intptr_t j = 0; j < st.m; ++j) {
+          for (intptr_t t = 0; t < p; ++t) {
+            T *c_re = y_re + (p * j + t) * lanes, *c_im = y_im + (p * j + t) * lanes;
+            std::copy(x_re + j * lanes, x_re + (j + 1) * lanes, c_re);
+            std::copy(x_im + j * lanes, x_im + (j + 1) * lanes, c_im);
+            for (intptr_t r = 1; r < p; ++r) {
+              const T *a_re = x_re + (j + r * st.m) * lanes, *a_im = x_im + (j + r * st.m) * lanes;
+              T w_re = st.root_re[(r * t) % p], w_im = st.root_im[(r * t) % p];
+              for (intptr_t l = 0; l < lanes; ++l) {
+                c_re[l] += a_re[l] * w_re - a_im[l] * w_im;
+                c_im[l] += a_re[l] * w_im + a_im[l] * w_re;
+              }
+            }
+            if (t > 0) {
+              T w_re = st.twiddle_re[j * (p - 1) + t - 1], w_im = st.twiddle_im[j * (p - 1) + t - 1];
+              for (intptr_t l = 0; l < lanes; ++l) {
+                twiddle(c_re[l], c_im[l], w_re, w_im);
+              }
+            }
+          }
+        }
+      }
+
+      static intptr_t largest_prime_factor(intptr_t n) {
+        intptr_t largest = 1;
+        for (intptr_t p = 2; p * p <= n; ++p) {
+          while (n % p == 0) {
+            largest = p;
+            n /= p;
+          }
+        }
+        return std::max(largest, n);
+      }
+
+      void make_bluestein() {
+        const double pi = 3.14159265358979323846;
+
+        m_buffer_size = 1;
+        while (m_buffer_size < 2 * m_size - 1) {
+          m_buffer_size *= 2;
+        }
+        m_forward = std::make_shared<fft_plan>(m_buffer_size, -1);
+        m_inverse = std::make_shared<fft_plan>(m_buffer_size, 1);
+
+        for (intptr_t k = 0; k < m_size; ++k) {
+          double theta = m_sign * pi * static_cast<double>((k * k) % (2 * m_size)) / static_cast<double>(m_size);
+          m_chirp_re.push_back(static_cast<T>(std::cos(theta)));
+          m_chirp_im.push_back(static_cast<T>(std::sin(theta)));
+        }
+
+        // The kernel is the conjugate chirp at both ends, for the differences j - k of either sign
+        std::vector<T> buffer(4 * m_buffer_size, T(0));
+        T *re = buffer.data(), *im = re + m_buffer_size, *work_re = im + m_buffer_size,
+          *work_im = work_re + m_buffer_size;
+        for (intptr_t k = 0; k < m_size; ++k) {
+          re[k] = m_chirp_re[k];
+          im[k] = -m_chirp_im[k];
+          if (k > 0) {
+            re[m_buffer_size - k] = m_chirp_re[k];
+            im[m_buffer_size - k] = -m_chirp_im[k];
+          }
+        }
+        m_forward->execute(1, re, im, work_re, work_im);
+        for (intptr_t k = 0; k < m_buffer_size; ++k) {
+          m_kernel_re.push_back(re[k] / static_cast<T>(m_buffer_size));
+          m_kernel_im.push_back(im[k] / static_cast<T>(m_buffer_size));
+        }
+      }
+
+      void execute_bluestein(intptr_t batch, T *&re, T *&im, T *&work_re, T *&work_im) const {
+        for (intptr_t k = 0; k < m_size; ++k) {
+          for (intptr_t l = k * batch; l < (k + 1) * batch; ++l) {
+            twiddle(re[l], im[l], m_chirp_re[k], m_chirp_im[k]);
+          }
+        }
+        std::fill(re + m_size * batch, re + m_buffer_size * batch, T(0));
+        std::fill(im + m_size * batch, im + m_buffer_size * batch, T(0));
+
+        m_forward->execute(batch, re, im, work_re, work_im);
+        for (intptr_t k = 0; k < m_buffer_size; ++k) {
+          for (intptr_t l = k * batch; l < (k + 1) * batch; ++l) {
+            twiddle(re[l], im[l], m_kernel_re[k], m_kernel_im[k]);
+          }
+        }
+        m_inverse->execute(batch, re, im, work_re, work_im);
+
+        for (intptr_t k = 0; k < m_size; ++k) {
+          for (intptr_t l = k * batch; l < (k + 1) * batch; ++l) {
+            twiddle(re[l], im[l], m_chirp_re[k], m_chirp_im[k]);
+          }
+        }
+      }
+
+    public:
+      fft_plan(intptr_t size, int sign) : m_size(size), m_sign(sign), m_buffer_size(size) {
+        const double pi = 3.14159265358979323846;
+
+        if (largest_prime_factor(size) > bluestein_threshold) {
+          make_bluestein();
+          return;
+        }
+
+        intptr_t n = size;
+        while (n > 1) {
+          intptr_t p;
+          if (n % 4 == 0) {
+            p = 4;
+          } else if (n % 2 == 0) {
+            p = 2;
+          } else {
+            p = 3;
+            while (n % p != 0) {
+              p += 2;
+            }
+          }
+
+          stage st;
+          st.radix = p;
+          st.m = n / p;
+          for (intptr_t j = 0; j < st.m; ++j) {
+            for (intptr_t t = 1; t < p; ++t) {
+              double theta = sign * 2 * pi * static_cast<double>((j * t) % n) / static_cast<double>(n);
+              st.twiddle_re.push_back(static_cast<T>(std::cos(theta)));
+              st.twiddle_im.push_back(static_cast<T>(std::sin(theta)));
+            }
+          }
+          if (p > 4) {
+            for (intptr_t r = 0; r < p; ++r) {
+              double theta = sign * 2 * pi * static_cast<double>(r) / static_cast<double>(p);
+              st.root_re.push_back(static_cast<T>(std::cos(theta)));
+              st.root_im.push_back(static_cast<T>(std::sin(theta)));
+            }
+          }
+          m_stages.push_back(std::move(st));
+
+          n /= p;
+        }
+      }
+
+      intptr_t get_size() const { return m_size; }
+
+      /**
+       * Returns the number of values per sequence that each buffer passed to
+       * ``execute`` must hold, which is more than the size for Bluestein's
+       * algorithm.
+       */
+      intptr_t get_buffer_size() const { return m_buffer_size; }
+
+      /**
+       * Transforms ``batch`` interleaved sequences in ``re`` and ``im``,
+       * using ``work_re`` and ``work_im`` as the second buffer. Each of the
+       * four pointers covers ``get_buffer_size() * batch`` values, of which
+       * the sequences are the first ``size * batch``. On return, ``re`` and
+       * ``im`` point at whichever buffer holds the result.
+       */
+      void execute(intptr_t batch, T *&re, T *&im, T *&work_re, T *&work_im) const {
+        if (m_forward) {
+          execute_bluestein(batch, re, im, work_re, work_im);
+          return;
+        }
+
+        intptr_t lanes = batch;
+        for (const stage &st : m_stages) {
+          switch (st.radix) {
+          case 2:
+            radix2(st, lanes, re, im, work_re, work_im);
+            break;
+          case 3:
+            radix3(st, lanes, re, im, work_re, work_im);
+            break;
+          case 4:
+            radix4(st, lanes, re, im, work_re, work_im);
+            break;
+          default:
+            radixn(st, lanes, re, im, work_re, work_im);
+            break;
+          }
+          std::swap(re, work_re);
+          std::swap(im, work_im);
+          lanes *= st.radix;
+        }
+      }
+    };
+
+    /**
+     * Returns the plan for complex transforms of length ``size`` in the
+     * direction given by ``sign``, building it on first use. Plans are
+     * shared, so kernels for arrays of the same length along an axis reuse
+     * the same twiddle factors.
+     */
+    template <typename T>
+    DYND_API std::shared_ptr<const fft_plan<T>> get_fft_plan(intptr_t size, int sign);
+
+  } // namespace dynd::nd::detail
+
+  /**
+   * Computes the discrete Fourier transform of an array of fixed dimensions
+   * along each of a list of axes in turn, with every other dimension as a
+   * batch of independent transforms.
+   *
+   * For each axis, a block of lines is gathered into interleaved split-complex
+   * buffers, transformed by an ``fft_plan`` and scattered into ``dst``. When
+   * ``Real`` is true, the source holds real values of type T, and the first
+   * axis produces the half spectrum of ``n / 2 + 1`` values. Two real lines are
+   * then transformed as the real and imaginary parts of one complex line, and
+   * separated by symmetry afterwards. The blocks are split across
+   * ``thread_count`` threads when there is enough work.
+   */
+  template <typename T, bool Real>
+  struct batched_fft_kernel : base_strided_kernel<batched_fft_kernel<T, Real>, 1> {
+    static const intptr_t max_batch = 16;
+    static const intptr_t block_values = 2048;
+    static const intptr_t parallel_threshold = 1 << 15;
+
+    intptr_t m_ndim;
+    std::vector<intptr_t> m_src_shape;
+    std::vector<intptr_t> m_src_stride;
+    std::vector<intptr_t> m_dst_shape;
+    std::vector<intptr_t> m_dst_stride;
+    std::vector<intptr_t> m_axes;
+    std::vector<std::shared_ptr<const detail::fft_plan<T>>> m_plans;
+    T m_scale;
+    intptr_t m_thread_count;
+
+    batched_fft_kernel(intptr_t ndim, const char *dst_arrmeta, const char *src_arrmeta,
+                       const std::vector<intptr_t> &axes,
+                       const std::vector<std::shared_ptr<const detail::fft_plan<T>>> &plans, T scale,
+                       intptr_t thread_count)
+        : m_ndim(ndim), m_axes(axes), m_plans(plans), m_scale(scale), m_thread_count(thread_count) {
+      for (intptr_t i = 0; i < ndim; ++i) {
+        const size_stride_t &src_ss = reinterpret_cast<const size_stride_t *>(src_arrmeta)[i];
+        const size_stride_t &dst_ss = reinterpret_cast<const size_stride_t *>(dst_arrmeta)[i];
+        m_src_shape.push_back(src_ss.dim_size);
+        m_src_stride.push_back(src_ss.stride);
+        m_dst_shape.push_back(dst_ss.dim_size);
+        m_dst_stride.push_back(dst_ss.stride);
+      }
+    }
+
+    /**
+     * Computes the offsets of ``count`` consecutive lines, starting at line
+     * ``begin``, where the lines run along ``axis`` and are numbered in C
+     * order over the remaining dimensions.
+     */
+    void line_offsets(intptr_t axis, intptr_t begin, intptr_t count, const intptr_t *src_stride,
+                      intptr_t *src_offset, intptr_t *dst_offset) const {
+      for (intptr_t b = 0; b < count; ++b) {
+        intptr_t line = begin + b;
+        src_offset[b] = 0;
+        dst_offset[b] = 0;
+        for (intptr_t i = m_ndim - 1; i >= 0; --i) {
+          if (i != axis) {
+            intptr_t index = line % m_dst_shape[i];
+            line /= m_dst_shape[i];
+            src_offset[b] += index * src_stride[i];
+            dst_offset[b] += index * m_dst_stride[i];
+          }
+        }
+      }
+    }
+
+    /**
+     * Transforms the lines in blocks [block_begin, block_end) along the axis
+     * of pass ``k``. The first pass reads from ``src``, and later ones
+     * transform ``dst`` in place.
+     */
+    void transform_blocks(intptr_t k, char *dst, const char *src, intptr_t nlines, intptr_t batch,
+                          intptr_t block_begin, intptr_t block_end) const {
+      const bool real = Real && k == 0;
+      const intptr_t axis = m_axes[k];
+      const detail::fft_plan<T> &plan = *m_plans[k];
+      const intptr_t n = plan.get_size();
+      const intptr_t in_stride = k == 0 ? m_src_stride[axis] : m_dst_stride[axis];
+      const intptr_t out_stride = m_dst_stride[axis];
+      const T scale = k == 0 ? m_scale : T(1);
+      const intptr_t lines_per_block = real ? 2 * batch : batch;
+
+      const intptr_t buffer_size = plan.get_buffer_size() * batch;
+      std::vector<T> buffer(4 * buffer_size);
+      std::vector<intptr_t> in_offset(lines_per_block), out_offset(lines_per_block);
+      for (intptr_t block = block_begin; block < block_end; ++block) {
+        intptr_t line_begin = block * lines_per_block;
+        intptr_t count = std::min(lines_per_block, nlines - line_begin);
+        line_offsets(axis, line_begin, count, k == 0 ? m_src_stride.data() : m_dst_stride.data(), in_offset.data(),
+                     out_offset.data());
+        const char *in = k == 0 ? src : dst;
+
+        T *re = buffer.data(), *im = re + buffer_size, *work_re = im + buffer_size, *work_im = work_re + buffer_size;
+        std::fill(re, work_re, T(0));
+        if (real) {
+          for (intptr_t b = 0; b < count; ++b) {
+            T *part = b < batch ? re + b : im + b - batch;
+            const char *line = in + in_offset[b];
+            for (intptr_t j = 0; j < n; ++j) {
+              part[j * batch] = *reinterpret_cast<const T *>(line + j * in_stride);
+            }
+          }
+        } else {
+          for (intptr_t b = 0; b < count; ++b) {
+            const char *line = in + in_offset[b];
+            for (intptr_t j = 0; j < n; ++j) {
+              const T *value = reinterpret_cast<const T *>(line + j * in_stride);
+              re[j * batch + b] = value[0];
+              im[j * batch + b] = value[1];
+            }
+          }
+        }
+
+        plan.execute(batch, re, im, work_re, work_im);
+
+        if (real) {
+          // With z = x + i * y, X[j] = (Z[j] + conj(Z[n - j])) / 2 and Y[j] = (Z[j] - conj(Z[n - j])) / 2i
+          const T half = scale / 2;
+          for (intptr_t b = 0; b < count; ++b) {
+            intptr_t lane = b < batch ? b : b - batch;
+            char *line = dst + out_offset[b];
+            for (intptr_t j = 0; j <= n / 2; ++j) {
+              intptr_t p = j * batch + lane, q = ((n - j) % n) * batch + lane;
+              T *value = reinterpret_cast<T *>(line + j * out_stride);
+              if (b < batch) {
+                value[0] = (re[p] + re[q]) * half;
+                value[1] = (im[p] - im[q]) * half;
+              } else {
+                value[0] = (im[p] + im[q]) * half;
+                value[1] = (re[q] - re[p]) * half;
+              }
+            }
+          }
+        } else {
+          for (intptr_t b = 0; b < count; ++b) {
+            char *line = dst + out_offset[b];
+            for (intptr_t j = 0; j < n; ++j) {
+              T *value = reinterpret_cast<T *>(line + j * out_stride);
+              value[0] = re[j * batch + b] * scale;
+              value[1] = im[j * batch + b] * scale;
+            }
+          }
+        }
+      }
+    }
+
+    void single(char *dst, char *const *src) {
+      for (size_t k = 0; k < m_axes.size(); ++k) {
+        intptr_t n = m_plans[k]->get_size();
+        intptr_t nlines = 1;
+        for (intptr_t i = 0; i < m_ndim; ++i) {
+          if (i != m_axes[k]) {
+            nlines *= m_dst_shape[i];
+          }
+        }
+        if (nlines == 0 || n == 0) {
+          return;
+        }
+
+        intptr_t batch = std::max(intptr_t(1), std::min(max_batch, block_values / n));
+        intptr_t lines_per_block = (Real && k == 0) ? 2 * batch : batch;
+        intptr_t nblocks = (nlines + lines_per_block - 1) / lines_per_block;
+
+        intptr_t threads_used = std::min(m_thread_count, nblocks);
+        if (threads_used <= 1 || nlines * n < parallel_threshold) {
+          transform_blocks(k, dst, src[0], nlines, batch, 0, nblocks);
+          continue;
+        }
+
+        parallel_for(nblocks, threads_used, 1, [&](intptr_t block_begin, intptr_t block_end) {
+          transform_blocks(k, dst, src[0], nlines, batch, block_begin, block_end);
+        });
+      }
+    }
+  };
+
+} // namespace dynd::nd
+} // namespace dynd
@@ -5,6 +5,11 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <vector>
+
 #include <dynd/callable.hpp>
 #include <dynd/kernels/base_kernel.hpp>
 
@@ -77,6 +82,102 @@ namespace nd {
       }
     };
 
+    /**
+     * Expr kernel for several fixed dimensions at once, taking their sizes
+     * and strides outermost first.
+     *
+     * The dimensions are reordered so that the one with the smallest strides
+     * is innermost, ties keeping their declared order, and adjacent
+     * dimensions that are contiguous in every operand are merged into one.
+     * The innermost remaining dimension goes to the child in a single strided
+     * call. This requires that the child kernel be created with the
+     * kernel_request_strided type of kernel.
+     */
+    template <size_t N>
+    struct coalesced_elwise_kernel : base_strided_kernel<coalesced_elwise_kernel<N>, N> {
+      std::vector<intptr_t> m_size;
+      std::vector<intptr_t> m_dst_stride;
+      std::vector<std::array<intptr_t, N>> m_src_stride;
+
+      coalesced_elwise_kernel(const std::vector<intptr_t> &size, const std::vector<intptr_t> &dst_stride,
+                              const std::vector<std::array<intptr_t, N>> &src_stride) {
+        // Weigh each dimension by how far a step along it moves through all the operands
+        std::vector<intptr_t> weight(size.size());
+        for (size_t j = 0; j < size.size(); ++j) {
+          weight[j] = std::abs(dst_stride[j]);
+          for (size_t i = 0; i < N; ++i) {
+            weight[j] += std::abs(src_stride[j][i]);
+          }
+        }
+        std::vector<size_t> order(size.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&weight](size_t j, size_t k) { return weight[j] > weight[k]; });
+
+        for (size_t j : order) {
+          // A dimension of size one is never stepped along
+          if (size[j] == 1 && order.size() > 1) {
+            continue;
+          }
+
+          if (!m_size.empty() && can_merge(dst_stride[j], src_stride[j], size[j])) {
+            m_size.back() *= size[j];
+            m_dst_stride.back() = dst_stride[j];
+            m_src_stride.back() = src_stride[j];
+          } else {
+            m_size.push_back(size[j]);
+            m_dst_stride.push_back(dst_stride[j]);
+            m_src_stride.push_back(src_stride[j]);
+          }
+        }
+
+        if (m_size.empty()) {
+          m_size.push_back(1);
+          m_dst_stride.push_back(0);
+          m_src_stride.push_back(std::array<intptr_t, N>());
+          m_src_stride.back().fill(0);
+        }
+      }
+
+      ~coalesced_elwise_kernel() { this->get_child()->destroy(); }
+
+      // Whether the innermost dimension so far can absorb a dimension inside it
+      bool can_merge(intptr_t dst_stride, const std::array<intptr_t, N> &src_stride, intptr_t size) const {
+        if (m_dst_stride.back() != dst_stride * size) {
+          return false;
+        }
+        for (size_t i = 0; i < N; ++i) {
+          if (m_src_stride.back()[i] != src_stride[i] * size) {
+            return false;
+          }
+        }
+
+        return true;
+      }
+
+      void loop(size_t j, char *dst, std::array<char *, N> src) {
+        if (j + 1 == m_size.size()) {
+          kernel_prefix *child = this->get_child();
+          child->get_function<kernel_strided_t>()(child, dst, m_dst_stride[j], src.data(), m_src_stride[j].data(),
+                                                  m_size[j]);
+          return;
+        }
+
+        for (intptr_t k = 0; k < m_size[j]; ++k) {
+          loop(j + 1, dst, src);
+          dst += m_dst_stride[j];
+          for (size_t i = 0; i < N; ++i) {
+            src[i] += m_src_stride[j][i];
+          }
+        }
+      }
+
+      void single(char *dst, char *const *src) {
+        std::array<char *, N> src_copy;
+        std::copy(src, src + N, src_copy.begin());
+        loop(0, dst, src_copy);
+      }
+    };
+
     /**
      * Generic expr kernel + destructor for a strided/var dimensions with
      * a fixed number of src operands, outputing to a strided dimension.
@@ -0,0 +1,105 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include <dynd/kernels/base_strided_kernel.hpp>
+#include <dynd/shortvector.hpp>
+
+namespace dynd {
+namespace nd {
+  namespace functional {
+
+    /**
+     * A kernel that evaluates a sequence of steps, each a child kernel
+     * applied to sources and to the results of earlier steps, and writes the
+     * result of the last step to dst.
+     *
+     * An argument ``i >= 0`` of a step is the ``i``th source, and ``~i`` is
+     * the result of step ``i``. Strided calls run in blocks of
+     * DYND_BUFFER_CHUNK_SIZE elements, so that the intermediate results of a
+     * block stay in cache between steps instead of going through memory.
+     */
+    // All methods are inlined, so this does not need to be declared DYND_API.
+    struct fused_kernel : base_strided_kernel<fused_kernel> {
+      size_t nsrc;
+      std::vector<std::vector<intptr_t>> step_args;
+      // The element size of each step's result, which is also its stride in the block buffer
+      std::vector<intptr_t> step_data_size;
+      std::vector<intptr_t> step_offset;
+
+      fused_kernel(size_t nsrc, const std::vector<std::vector<intptr_t>> &step_args,
+                   const std::vector<intptr_t> &step_data_size)
+          : nsrc(nsrc), step_args(step_args), step_data_size(step_data_size), step_offset(step_args.size()) {}
+
+      ~fused_kernel() {
+        for (intptr_t offset : step_offset) {
+          get_child(offset)->destroy();
+        }
+      }
+
+      void call(array *dst, const array *src) {
+        shortvector<char *> src_data(nsrc);
+        for (size_t i = 0; i < nsrc; ++i) {
+          src_data[i] = const_cast<char *>(src[i].cdata());
+        }
+        single(const_cast<char *>(dst->cdata()), src_data.get());
+      }
+
+      void single(char *dst, char *const *src) {
+        shortvector<intptr_t> src_stride(nsrc);
+        std::fill(src_stride.get(), src_stride.get() + nsrc, 0);
+        strided(dst, 0, src, src_stride.get(), 1);
+      }
+
+      void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count) {
+        size_t nstep = step_args.size();
+        size_t block_size = std::min(count, static_cast<size_t>(DYND_BUFFER_CHUNK_SIZE));
+
+        // One block of results for each step but the last, which writes to dst
+        shortvector<intptr_t> buffer_offset(nstep);
+        size_t buffer_size = 0, max_narg = 0;
+        for (size_t s = 0; s < nstep; ++s) {
+          buffer_offset[s] = buffer_size;
+          if (s + 1 < nstep) {
+            buffer_size += (block_size * step_data_size[s] + 15) & ~static_cast<size_t>(15);
+          }
+          max_narg = std::max(max_narg, step_args[s].size());
+        }
+        std::vector<char> buffer(buffer_size);
+
+        shortvector<char *> arg(max_narg);
+        shortvector<intptr_t> arg_stride(max_narg);
+        for (size_t i = 0; i < count; i += block_size) {
+          size_t n = std::min(block_size, count - i);
+          for (size_t s = 0; s < nstep; ++s) {
+            const std::vector<intptr_t> &args = step_args[s];
+            for (size_t k = 0; k < args.size(); ++k) {
+              if (args[k] >= 0) {
+                arg[k] = src[args[k]] + i * src_stride[args[k]];
+                arg_stride[k] = src_stride[args[k]];
+              } else {
+                arg[k] = buffer.data() + buffer_offset[~args[k]];
+                arg_stride[k] = step_data_size[~args[k]];
+              }
+            }
+
+            if (s + 1 < nstep) {
+              get_child(step_offset[s])
+                  ->strided(buffer.data() + buffer_offset[s], step_data_size[s], arg.get(), arg_stride.get(), n);
+            } else {
+              get_child(step_offset[s])->strided(dst + i * dst_stride, dst_stride, arg.get(), arg_stride.get(), n);
+            }
+          }
+        }
+      }
+    };
+
+  } // namespace dynd::nd::functional
+} // namespace dynd::nd
+} // namespace dynd
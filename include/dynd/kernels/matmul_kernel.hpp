@@ -0,0 +1,476 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <vector>
+
+#include <dynd/complex.hpp>
+#include <dynd/kernels/base_strided_kernel.hpp>
+#include <dynd/parallel.hpp>
+
+#if !defined(__CUDACC__) && defined(__AVX__)
+#include <immintrin.h>
+#define DYND_MATMUL_AVX
+#elif !defined(__CUDACC__) && (defined(__SSE2__) || defined(_M_X64))
+#include <emmintrin.h>
+#define DYND_MATMUL_SSE2
+#endif
+
+#ifdef DYND_BLAS
+extern "C" {
+void sgemm_(const char *transa, const char *transb, const int *m, const int *n, const int *k, const float *alpha,
+            const float *a, const int *lda, const float *b, const int *ldb, const float *beta, float *c,
+            const int *ldc);
+void dgemm_(const char *transa, const char *transb, const int *m, const int *n, const int *k, const double *alpha,
+            const double *a, const int *lda, const double *b, const int *ldb, const double *beta, double *c,
+            const int *ldc);
+void cgemm_(const char *transa, const char *transb, const int *m, const int *n, const int *k, const void *alpha,
+            const void *a, const int *lda, const void *b, const int *ldb, const void *beta, void *c, const int *ldc);
+void zgemm_(const char *transa, const char *transb, const int *m, const int *n, const int *k, const void *alpha,
+            const void *a, const int *lda, const void *b, const int *ldb, const void *beta, void *c, const int *ldc);
+}
+#endif
+
+namespace dynd {
+namespace nd {
+
+  namespace detail {
+
+    // Calls the Fortran BLAS gemm for a column major C = op(A) op(B)
+    template <typename T>
+    struct blas_gemm {
+      static const bool available = false;
+
+      static void call(char, char, int, int, int, const T *, int, const T *, int, T *, int) {}
+    };
+
+#ifdef DYND_BLAS
+    template <>
+    struct blas_gemm<float> {
+      static const bool available = true;
+
+      static void call(char transa, char transb, int m, int n, int k, const float *a, int lda, const float *b,
+                       int ldb, float *c, int ldc) {
+        float alpha = 1, beta = 0;
+        sgemm_(&transa, &transb, &m, &n, &k, &alpha, a, &lda, b, &ldb, &beta, c, &ldc);
+      }
+    };
+
+    template <>
+    struct blas_gemm<double> {
+      static const bool available = true;
+
+      static void call(char transa, char transb, int m, int n, int k, const double *a, int lda, const double *b,
+                       int ldb, double *c, int ldc) {
+        double alpha = 1, beta = 0;
+        dgemm_(&transa, &transb, &m, &n, &k, &alpha, a, &lda, b, &ldb, &beta, c, &ldc);
+      }
+    };
+
+    template <>
+    struct blas_gemm<complex<float>> {
+      static const bool available = true;
+
+      static void call(char transa, char transb, int m, int n, int k, const complex<float> *a, int lda,
+                       const complex<float> *b, int ldb, complex<float> *c, int ldc) {
+        complex<float> alpha = 1, beta = 0;
+        cgemm_(&transa, &transb, &m, &n, &k, &alpha, a, &lda, b, &ldb, &beta, c, &ldc);
+      }
+    };
+
+    template <>
+    struct blas_gemm<complex<double>> {
+      static const bool available = true;
+
+      static void call(char transa, char transb, int m, int n, int k, const complex<double> *a, int lda,
+                       const complex<double> *b, int ldb, complex<double> *c, int ldc) {
+        complex<double> alpha = 1, beta = 0;
+        zgemm_(&transa, &transb, &m, &n, &k, &alpha, a, &lda, b, &ldb, &beta, c, &ldc);
+      }
+    };
+#endif
+
+    /**
+     * Accumulates a 4 x 8 tile of the product of packed panels of A, four
+     * values per step, and B, eight values per step, over ``kc`` steps.
+     */
+    template <typename T>
+    struct matmul_micro_kernel {
+      static void run(intptr_t kc, const T *a, const T *b, T (&acc)[4][8]) {
+        for (intptr_t i = 0; i < 4; ++i) {
+          for (intptr_t j = 0; j < 8; ++j) {
+            acc[i][j] = T();
+          }
+        }
+        for (intptr_t p = 0; p < kc; ++p, a += 4, b += 8) {
+          for (intptr_t i = 0; i < 4; ++i) {
+            T ai = a[i];
+            for (intptr_t j = 0; j < 8; ++j) {
+              acc[i][j] += ai * b[j];
+            }
+          }
+        }
+      }
+    };
+
+    // Compilers don't keep the whole tile of the generic loop in registers,
+    // so float and double have intrinsic versions that do, for SSE2 and for
+    // AVX when the build targets it
+
+#if defined(DYND_MATMUL_AVX)
+    template <>
+    struct matmul_micro_kernel<float> {
+      static __m256 madd(__m256 a, __m256 b, __m256 c) {
+#ifdef __FMA__
+        return _mm256_fmadd_ps(a, b, c);
+#else
+        return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+      }
+
+      static void run(intptr_t kc, const float *a, const float *b, float (&acc)[4][8]) {
+        __m256 c0 = _mm256_setzero_ps(), c1 = c0, c2 = c0, c3 = c0;
+        for (intptr_t p = 0; p < kc; ++p, a += 4, b += 8) {
+          __m256 bp = _mm256_loadu_ps(b);
+          c0 = madd(_mm256_broadcast_ss(a), bp, c0);
+          c1 = madd(_mm256_broadcast_ss(a + 1), bp, c1);
+          c2 = madd(_mm256_broadcast_ss(a + 2), bp, c2);
+          c3 = madd(_mm256_broadcast_ss(a + 3), bp, c3);
+        }
+        _mm256_storeu_ps(acc[0], c0);
+        _mm256_storeu_ps(acc[1], c1);
+        _mm256_storeu_ps(acc[2], c2);
+        _mm256_storeu_ps(acc[3], c3);
+      }
+    };
+
+    template <>
+    struct matmul_micro_kernel<double> {
+      static __m256d madd(__m256d a, __m256d b, __m256d c) {
+#ifdef __FMA__
+        return _mm256_fmadd_pd(a, b, c);
+#else
+        return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+#endif
+      }
+
+      static void run(intptr_t kc, const double *a, const double *b, double (&acc)[4][8]) {
+        __m256d c00 = _mm256_setzero_pd(), c01 = c00, c10 = c00, c11 = c00, c20 = c00, c21 = c00, c30 = c00,
+                c31 = c00;
+        for (intptr_t p = 0; p < kc; ++p, a += 4, b += 8) {
+          __m256d b0 = _mm256_loadu_pd(b), b1 = _mm256_loadu_pd(b + 4);
+          __m256d ai = _mm256_broadcast_sd(a);
+          c00 = madd(ai, b0, c00);
+          c01 = madd(ai, b1, c01);
+          ai = _mm256_broadcast_sd(a + 1);
+          c10 = madd(ai, b0, c10);
+          c11 = madd(ai, b1, c11);
+          ai = _mm256_broadcast_sd(a + 2);
+          c20 = madd(ai, b0, c20);
+          c21 = madd(ai, b1, c21);
+          ai = _mm256_broadcast_sd(a + 3);
+          c30 = madd(ai, b0, c30);
+          c31 = madd(ai, b1, c31);
+        }
+        _mm256_storeu_pd(acc[0], c00);
+        _mm256_storeu_pd(acc[0] + 4, c01);
+        _mm256_storeu_pd(acc[1], c10);
+        _mm256_storeu_pd(acc[1] + 4, c11);
+        _mm256_storeu_pd(acc[2], c20);
+        _mm256_storeu_pd(acc[2] + 4, c21);
+        _mm256_storeu_pd(acc[3], c30);
+        _mm256_storeu_pd(acc[3] + 4, c31);
+      }
+    };
+#elif defined(DYND_MATMUL_SSE2)
+    template <>
+    struct matmul_micro_kernel<float> {
+      static void run(intptr_t kc, const float *a, const float *b, float (&acc)[4][8]) {
+        __m128 c00 = _mm_setzero_ps(), c01 = c00, c10 = c00, c11 = c00, c20 = c00, c21 = c00, c30 = c00, c31 = c00;
+        for (intptr_t p = 0; p < kc; ++p, a += 4, b += 8) {
+          __m128 b0 = _mm_loadu_ps(b), b1 = _mm_loadu_ps(b + 4);
+          __m128 ai = _mm_set1_ps(a[0]);
+          c00 = _mm_add_ps(c00, _mm_mul_ps(ai, b0));
+          c01 = _mm_add_ps(c01, _mm_mul_ps(ai, b1));
+          ai = _mm_set1_ps(a[1]);
+          c10 = _mm_add_ps(c10, _mm_mul_ps(ai, b0));
+          c11 = _mm_add_ps(c11, _mm_mul_ps(ai, b1));
+          ai = _mm_set1_ps(a[2]);
+          c20 = _mm_add_ps(c20, _mm_mul_ps(ai, b0));
+          c21 = _mm_add_ps(c21, _mm_mul_ps(ai, b1));
+          ai = _mm_set1_ps(a[3]);
+          c30 = _mm_add_ps(c30, _mm_mul_ps(ai, b0));
+          c31 = _mm_add_ps(c31, _mm_mul_ps(ai, b1));
+        }
+        _mm_storeu_ps(acc[0], c00);
+        _mm_storeu_ps(acc[0] + 4, c01);
+        _mm_storeu_ps(acc[1], c10);
+        _mm_storeu_ps(acc[1] + 4, c11);
+        _mm_storeu_ps(acc[2], c20);
+        _mm_storeu_ps(acc[2] + 4, c21);
+        _mm_storeu_ps(acc[3], c30);
+        _mm_storeu_ps(acc[3] + 4, c31);
+      }
+    };
+
+    template <>
+    struct matmul_micro_kernel<double> {
+      static void run(intptr_t kc, const double *a, const double *b, double (&acc)[4][8]) {
+        __m128d c[4][4];
+        for (int i = 0; i < 4; ++i) {
+          for (int j = 0; j < 4; ++j) {
+            c[i][j] = _mm_setzero_pd();
+          }
+        }
+        for (intptr_t p = 0; p < kc; ++p, a += 4, b += 8) {
+          __m128d b0 = _mm_loadu_pd(b), b1 = _mm_loadu_pd(b + 2), b2 = _mm_loadu_pd(b + 4), b3 = _mm_loadu_pd(b + 6);
+          for (int i = 0; i < 4; ++i) {
+            __m128d ai = _mm_set1_pd(a[i]);
+            c[i][0] = _mm_add_pd(c[i][0], _mm_mul_pd(ai, b0));
+            c[i][1] = _mm_add_pd(c[i][1], _mm_mul_pd(ai, b1));
+            c[i][2] = _mm_add_pd(c[i][2], _mm_mul_pd(ai, b2));
+            c[i][3] = _mm_add_pd(c[i][3], _mm_mul_pd(ai, b3));
+          }
+        }
+        for (int i = 0; i < 4; ++i) {
+          for (int j = 0; j < 4; ++j) {
+            _mm_storeu_pd(acc[i] + 2 * j, c[i][j]);
+          }
+        }
+      }
+    };
+#endif
+
+  } // namespace dynd::nd::detail
+
+  /**
+   * Multiplies an ``M * K`` matrix by a ``K * N`` matrix, with any strides.
+   *
+   * When libdynd is built with DYND_BLAS and the operands have a unit
+   * stride in one of their dimensions, the product goes to the BLAS gemm.
+   * Otherwise it is computed with a cache blocked loop nest: panels of
+   * ``B`` and blocks of ``A`` are packed into contiguous buffers, and a
+   * micro kernel accumulates an ``MR * NR`` tile of the result in vector
+   * registers.
+   *
+   * Large products are split across ``thread_count`` threads by rows, and a
+   * strided call spreads whole products across them instead, both through
+   * ``parallel_for``.
+   */
+  template <typename T>
+  struct matmul_kernel : base_strided_kernel<matmul_kernel<T>, 2> {
+    static const intptr_t MR = 4;
+    static const intptr_t NR = 8;
+    static const intptr_t MC = 64;
+    static const intptr_t KC = 256;
+    static const intptr_t NC = 1024;
+
+    intptr_t m, k, n;
+    intptr_t dst_stride[2];
+    intptr_t src0_stride[2];
+    intptr_t src1_stride[2];
+    intptr_t thread_count;
+
+    matmul_kernel(const char *dst_arrmeta, const char *const *src_arrmeta, intptr_t thread_count)
+        : thread_count(thread_count) {
+      const size_stride_t *dst_ss = reinterpret_cast<const size_stride_t *>(dst_arrmeta);
+      const size_stride_t *src0_ss = reinterpret_cast<const size_stride_t *>(src_arrmeta[0]);
+      const size_stride_t *src1_ss = reinterpret_cast<const size_stride_t *>(src_arrmeta[1]);
+
+      m = src0_ss[0].dim_size;
+      k = src0_ss[1].dim_size;
+      n = src1_ss[1].dim_size;
+      for (int i = 0; i < 2; ++i) {
+        dst_stride[i] = dst_ss[i].stride;
+        src0_stride[i] = src0_ss[i].stride;
+        src1_stride[i] = src1_ss[i].stride;
+      }
+    }
+
+    /**
+     * Packs rows ``[i0, i0 + mc)`` and columns ``[p0, p0 + kc)`` of A into
+     * panels of MR rows, each stored column by column and padded with zeros.
+     */
+    void pack_a(T *buffer, const char *a, intptr_t i0, intptr_t mc, intptr_t p0, intptr_t kc) const {
+      for (intptr_t ir = 0; ir < mc; ir += MR) {
+        for (intptr_t p = 0; p < kc; ++p) {
+          for (intptr_t i = 0; i < MR; ++i) {
+            *buffer++ = (ir + i < mc) ? *reinterpret_cast<const T *>(a + (i0 + ir + i) * src0_stride[0] +
+                                                                      (p0 + p) * src0_stride[1])
+                                      : T();
+          }
+        }
+      }
+    }
+
+    /**
+     * Packs rows ``[p0, p0 + kc)`` and columns ``[j0, j0 + nc)`` of B into
+     * panels of NR columns, each stored row by row and padded with zeros.
+     */
+    void pack_b(T *buffer, const char *b, intptr_t p0, intptr_t kc, intptr_t j0, intptr_t nc) const {
+      for (intptr_t jr = 0; jr < nc; jr += NR) {
+        for (intptr_t p = 0; p < kc; ++p) {
+          for (intptr_t j = 0; j < NR; ++j) {
+            *buffer++ = (jr + j < nc) ? *reinterpret_cast<const T *>(b + (p0 + p) * src1_stride[0] +
+                                                                      (j0 + jr + j) * src1_stride[1])
+                                      : T();
+          }
+        }
+      }
+    }
+
+    static void micro_kernel(intptr_t kc, const T *a, const T *b, T (&acc)[MR][NR]) {
+      detail::matmul_micro_kernel<T>::run(kc, a, b, acc);
+    }
+
+    /**
+     * Computes rows ``[row_begin, row_end)`` of the product with the blocked
+     * loop nest.
+     */
+    void blocked_rows(char *dst, const char *a, const char *b, intptr_t row_begin, intptr_t row_end) const {
+      if (k == 0) {
+        for (intptr_t i = row_begin; i < row_end; ++i) {
+          for (intptr_t j = 0; j < n; ++j) {
+            *reinterpret_cast<T *>(dst + i * dst_stride[0] + j * dst_stride[1]) = T();
+          }
+        }
+        return;
+      }
+
+      std::vector<T> a_buffer(MC * KC);
+      std::vector<T> b_buffer(((std::min(n, intptr_t(NC)) + NR - 1) / NR) * NR * KC);
+      T acc[MR][NR];
+      for (intptr_t jc = 0; jc < n; jc += NC) {
+        intptr_t nc = std::min(intptr_t(NC), n - jc);
+        for (intptr_t pc = 0; pc < k; pc += KC) {
+          intptr_t kc = std::min(intptr_t(KC), k - pc);
+          pack_b(b_buffer.data(), b, pc, kc, jc, nc);
+
+          for (intptr_t ic = row_begin; ic < row_end; ic += MC) {
+            intptr_t mc = std::min(intptr_t(MC), row_end - ic);
+            pack_a(a_buffer.data(), a, ic, mc, pc, kc);
+
+            for (intptr_t jr = 0; jr < nc; jr += NR) {
+              for (intptr_t ir = 0; ir < mc; ir += MR) {
+                micro_kernel(kc, a_buffer.data() + ir * kc, b_buffer.data() + jr * kc, acc);
+
+                // The first panel of K overwrites the result, and the others add to it
+                for (intptr_t i = 0; i < std::min(intptr_t(MR), mc - ir); ++i) {
+                  char *dst_row = dst + (ic + ir + i) * dst_stride[0];
+                  for (intptr_t j = 0; j < std::min(intptr_t(NR), nc - jr); ++j) {
+                    T &c = *reinterpret_cast<T *>(dst_row + (jc + jr + j) * dst_stride[1]);
+                    c = (pc == 0) ? acc[i][j] : c + acc[i][j];
+                  }
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+
+    /**
+     * Hands the product to the BLAS gemm, returning false when the strides
+     * or sizes are not ones that BLAS accepts.
+     */
+    bool blas_single(char *dst, const char *a, const char *b) const {
+      if (!detail::blas_gemm<T>::available || m == 0 || n == 0 || k == 0) {
+        return false;
+      }
+
+      // Make the result row major, by computing its transpose if it is column major
+      intptr_t mm = m, nn = n;
+      intptr_t c_rs = dst_stride[0], c_cs = dst_stride[1];
+      intptr_t a_rs = src0_stride[0], a_cs = src0_stride[1], b_rs = src1_stride[0], b_cs = src1_stride[1];
+      if (c_cs != static_cast<intptr_t>(sizeof(T))) {
+        std::swap(mm, nn);
+        std::swap(c_rs, c_cs);
+        std::swap(a, b);
+        std::swap(a_rs, b_cs);
+        std::swap(a_cs, b_rs);
+      }
+      if (c_cs != static_cast<intptr_t>(sizeof(T))) {
+        return false;
+      }
+
+      // A row major C is the column major transpose, which is op(B)^T op(A)^T
+      char transa, transb;
+      intptr_t lda, ldb;
+      if (!blas_operand(a_rs, a_cs, mm, k, transa, lda) || !blas_operand(b_rs, b_cs, k, nn, transb, ldb)) {
+        return false;
+      }
+      intptr_t ldc = c_rs / static_cast<intptr_t>(sizeof(T));
+      if (c_rs % static_cast<intptr_t>(sizeof(T)) != 0 || ldc < std::max(nn, intptr_t(1)) || ldc > INT_MAX ||
+          mm > INT_MAX || nn > INT_MAX || k > INT_MAX) {
+        return false;
+      }
+
+      detail::blas_gemm<T>::call(transb, transa, static_cast<int>(nn), static_cast<int>(mm), static_cast<int>(k),
+                                 reinterpret_cast<const T *>(b), static_cast<int>(ldb),
+                                 reinterpret_cast<const T *>(a), static_cast<int>(lda), reinterpret_cast<T *>(dst),
+                                 static_cast<int>(ldc));
+      return true;
+    }
+
+    /**
+     * Describes a ``rows * cols`` operand to the column major BLAS, as
+     * untransposed when its rows are contiguous and as transposed when its
+     * columns are.
+     */
+    static bool blas_operand(intptr_t rs, intptr_t cs, intptr_t rows, intptr_t cols, char &trans, intptr_t &ld) {
+      intptr_t size = sizeof(T);
+      if (cs == size && rs % size == 0 && rs / size >= std::max(cols, intptr_t(1))) {
+        trans = 'N';
+        ld = rs / size;
+      } else if (rs == size && cs % size == 0 && cs / size >= std::max(rows, intptr_t(1))) {
+        trans = 'T';
+        ld = cs / size;
+      } else {
+        return false;
+      }
+
+      return ld <= INT_MAX;
+    }
+
+    void single(char *dst, char *const *src) {
+      if (blas_single(dst, src[0], src[1])) {
+        return;
+      }
+
+      // Only split products big enough to keep every thread busy, giving
+      // each thread whole panels of MR rows and at least MC rows in all
+      if (m * n * k < 64 * 64 * 64) {
+        blocked_rows(dst, src[0], src[1], 0, m);
+        return;
+      }
+
+      parallel_for((m + MR - 1) / MR, thread_count, MC / MR, [&](intptr_t begin, intptr_t end) {
+        blocked_rows(dst, src[0], src[1], begin * MR, std::min(end * MR, m));
+      });
+    }
+
+    void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count) {
+      if (count == 1) {
+        single(dst, src);
+        return;
+      }
+
+      // Each thread takes a run of whole products from the batch
+      parallel_for(count, thread_count, 1, [&](intptr_t begin, intptr_t end) {
+        for (intptr_t i = begin; i < end; ++i) {
+          char *src_i[2] = {src[0] + i * src_stride[0], src[1] + i * src_stride[1]};
+          if (!blas_single(dst + i * dst_stride, src_i[0], src_i[1])) {
+            blocked_rows(dst + i * dst_stride, src_i[0], src_i[1], 0, m);
+          }
+        }
+      });
+    }
+  };
+
+} // namespace dynd::nd
+} // namespace dynd
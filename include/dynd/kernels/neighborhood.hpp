@@ -6,76 +6,274 @@
 #pragma once
 
 #include <algorithm>
+#include <cstring>
+#include <vector>
 
-#include <dynd/kernels/base_kernel.hpp>
-#include <dynd/types/substitute_shape.hpp>
+#include <dynd/kernels/base_strided_kernel.hpp>
+#include <dynd/parallel.hpp>
 
 namespace dynd {
 namespace nd {
   namespace functional {
 
-    template <int N>
-    struct neighborhood_kernel : base_strided_kernel<neighborhood_kernel<N>, N> {
-      intptr_t dst_stride;
-      intptr_t src0_offset;
-      intptr_t src0_stride;
-      intptr_t offset;
-      intptr_t counts[3];
-      std::shared_ptr<bool> out_of_bounds;
-      intptr_t boundary_child_offset;
-
-      neighborhood_kernel(intptr_t dst_stride, intptr_t src0_size, intptr_t src0_stride, intptr_t size, intptr_t offset,
-                          const std::shared_ptr<bool> &out_of_bounds)
-          : dst_stride(dst_stride), src0_offset(offset * src0_stride), src0_stride(src0_stride), offset(offset),
-            out_of_bounds(out_of_bounds)
-      {
-        counts[0] = std::min((intptr_t)0, src0_size + offset);
-        counts[1] = std::min(src0_size + offset, src0_size - size + 1);
-        counts[2] = src0_size + offset;
-
-        *out_of_bounds = false;
+    /**
+     * How a neighborhood handles windows that extend past the edges of the
+     * array.
+     */
+    enum neighborhood_boundary_mode {
+      // The boundary callable produces the output for such windows
+      neighborhood_boundary_fill,
+      // Elements outside the array are zero
+      neighborhood_boundary_zero,
+      // Elements outside the array repeat the nearest edge element
+      neighborhood_boundary_nearest,
+      // Elements outside the array mirror it about its edges, as in "dcba|abcd|dcba"
+      neighborhood_boundary_reflect,
+      // Elements outside the array wrap around to the opposite edge
+      neighborhood_boundary_wrap
+    };
+
+    /**
+     * Applies a child kernel to the window around each element of an
+     * ``ndim``-dimensional fixed array.
+     *
+     * The output is split into tiles, which are processed in turn or spread
+     * across threads. Within a tile, each row of windows that lies entirely
+     * inside the array goes to the child in one strided call with no bounds
+     * checks. Only windows crossing an edge go through the boundary path,
+     * which either calls the boundary child or gathers the window into a
+     * padded buffer for a second instance of the child.
+     */
+    struct neighborhood_kernel : base_strided_kernel<neighborhood_kernel, 1> {
+      intptr_t ndim;
+      std::vector<intptr_t> shape;
+      std::vector<intptr_t> dst_stride;
+      std::vector<intptr_t> src_stride;
+      std::vector<intptr_t> window;
+      std::vector<intptr_t> offset;
+      // The range of output indices in each dimension whose windows are inside the array
+      std::vector<intptr_t> interior_begin;
+      std::vector<intptr_t> interior_end;
+      std::vector<intptr_t> tile;
+      neighborhood_boundary_mode boundary_mode;
+      size_t data_size;
+      intptr_t thread_count;
+      // Arrmeta of a window viewed in place, and of a window gathered into a buffer
+      std::vector<char> window_arrmeta;
+      std::vector<char> buffer_arrmeta;
+      size_t boundary_child_offset;
+
+      neighborhood_kernel(intptr_t ndim, const char *dst_arrmeta, const char *src_arrmeta,
+                          const std::vector<intptr_t> &window, const std::vector<intptr_t> &offset,
+                          neighborhood_boundary_mode boundary_mode, size_t data_size, size_t data_arrmeta_size,
+                          intptr_t thread_count)
+          : ndim(ndim), shape(ndim), dst_stride(ndim), src_stride(ndim), window(window), offset(offset),
+            interior_begin(ndim), interior_end(ndim), tile(ndim), boundary_mode(boundary_mode), data_size(data_size),
+            thread_count(thread_count), window_arrmeta(ndim * sizeof(size_stride_t) + data_arrmeta_size),
+            buffer_arrmeta(ndim * sizeof(size_stride_t)) {
+        const size_stride_t *dst_ss = reinterpret_cast<const size_stride_t *>(dst_arrmeta);
+        const size_stride_t *src_ss = reinterpret_cast<const size_stride_t *>(src_arrmeta);
+        size_stride_t *window_ss = reinterpret_cast<size_stride_t *>(window_arrmeta.data());
+        size_stride_t *buffer_ss = reinterpret_cast<size_stride_t *>(buffer_arrmeta.data());
+
+        intptr_t buffer_stride = data_size;
+        for (intptr_t i = ndim - 1; i >= 0; --i) {
+          shape[i] = src_ss[i].dim_size;
+          dst_stride[i] = dst_ss[i].stride;
+          src_stride[i] = src_ss[i].stride;
+
+          // A window at output index j covers [j + offset, j + offset + window)
+          interior_begin[i] = std::min(std::max(-offset[i], intptr_t(0)), shape[i]);
+          interior_end[i] = std::max(interior_begin[i], std::min(shape[i], shape[i] - window[i] - offset[i] + 1));
+
+          // Rows of a tile are long enough to stream, and a tile's rows reuse each other's window rows
+          tile[i] = std::max(std::min(shape[i], intptr_t((i == ndim - 1) ? 512 : 32)), intptr_t(1));
+
+          window_ss[i].dim_size = window[i];
+          window_ss[i].stride = src_ss[i].stride;
+          buffer_ss[i].dim_size = window[i];
+          buffer_ss[i].stride = buffer_stride;
+          buffer_stride *= window[i];
+        }
+
+        if (data_arrmeta_size > 0) {
+          memcpy(window_arrmeta.data() + ndim * sizeof(size_stride_t), src_arrmeta + ndim * sizeof(size_stride_t),
+                 data_arrmeta_size);
+        }
       }
 
-      void single(char *dst, char *const *src)
-      {
-        kernel_prefix *child = this->get_child();
-        kernel_prefix *boundary_child = this->get_child(boundary_child_offset);
+      ~neighborhood_kernel() {
+        get_child()->destroy();
+        get_child(boundary_child_offset)->destroy();
+      }
 
-        char *src0 = src[0] + src0_offset;
+      size_t get_window_size() const {
+        size_t size = data_size;
+        for (intptr_t i = 0; i < ndim; ++i) {
+          size *= window[i];
+        }
 
-        intptr_t i = offset;
-        bool old_out_of_bounds = *out_of_bounds;
+        return size;
+      }
+
+      /**
+       * Produces the output for a window that crosses an edge, given the
+       * output index ``index``.
+       */
+      void boundary_single(char *dst, char *src, const intptr_t *index, char *buffer) {
+        kernel_prefix *boundary_child = get_child(boundary_child_offset);
+        if (boundary_mode == neighborhood_boundary_fill) {
+          boundary_child->single(dst, nullptr);
+          return;
+        }
 
-        *out_of_bounds = true;
-        while (i < counts[0]) {
-          boundary_child->single(dst, &src0);
-          ++i;
-          dst += dst_stride;
-          src0 += src0_stride;
-        };
+        // Gather the window into the buffer, walking it in row-major order
+        std::vector<intptr_t> w(ndim, 0);
+        for (char *buffer_it = buffer;; buffer_it += data_size) {
+          intptr_t src_offset = 0;
+          bool outside = false;
+          for (intptr_t i = 0; i < ndim; ++i) {
+            intptr_t j = index[i] + offset[i] + w[i];
+            if (j < 0 || j >= shape[i]) {
+              switch (boundary_mode) {
+              case neighborhood_boundary_nearest:
+                j = (j < 0) ? 0 : (shape[i] - 1);
+                break;
+              case neighborhood_boundary_reflect:
+                j %= 2 * shape[i];
+                if (j < 0) {
+                  j += 2 * shape[i];
+                }
+                if (j >= shape[i]) {
+                  j = 2 * shape[i] - 1 - j;
+                }
+                break;
+              case neighborhood_boundary_wrap:
+                j %= shape[i];
+                if (j < 0) {
+                  j += shape[i];
+                }
+                break;
+              default:
+                outside = true;
+                break;
+              }
+            }
+            src_offset += j * src_stride[i];
+          }
+
+          if (outside) {
+            memset(buffer_it, 0, data_size);
+          } else {
+            memcpy(buffer_it, src + src_offset, data_size);
+          }
 
-        *out_of_bounds = old_out_of_bounds;
-        while (i < counts[1]) {
-          if (*out_of_bounds) {
-            boundary_child->single(dst, &src0);
+          intptr_t i = ndim - 1;
+          while (i >= 0 && ++w[i] == window[i]) {
+            w[i--] = 0;
           }
-          else {
-            child->single(dst, &src0);
+          if (i < 0) {
+            break;
           }
-          ++i;
-          dst += dst_stride;
-          src0 += src0_stride;
         }
 
-        *out_of_bounds = true;
-        while (i < counts[2]) {
-          boundary_child->single(dst, &src0);
-          ++i;
-          dst += dst_stride;
-          src0 += src0_stride;
+        boundary_child->single(dst, &buffer);
+      }
+
+      /**
+       * Produces the outputs for the tile whose first output index is ``first``.
+       */
+      void tile_single(char *dst, char *src, const std::vector<intptr_t> &first, char *buffer) {
+        kernel_prefix *child = get_child();
+
+        intptr_t inner = ndim - 1;
+        intptr_t row_begin = first[inner];
+        intptr_t row_end = std::min(row_begin + tile[inner], shape[inner]);
+
+        // Walk the rows of the tile, the index of the row being all but the innermost dimension
+        std::vector<intptr_t> index(first);
+        for (;;) {
+          bool interior_row = true;
+          intptr_t dst_offset = 0, src_offset = 0;
+          for (intptr_t i = 0; i < inner; ++i) {
+            interior_row = interior_row && index[i] >= interior_begin[i] && index[i] < interior_end[i];
+            dst_offset += index[i] * dst_stride[i];
+            src_offset += (index[i] + offset[i]) * src_stride[i];
+          }
+
+          intptr_t begin = row_begin, end = row_end;
+          if (interior_row) {
+            begin = std::min(std::max(row_begin, interior_begin[inner]), row_end);
+            end = std::max(std::min(row_end, interior_end[inner]), begin);
+          } else {
+            begin = end = row_end;
+          }
+
+          for (intptr_t j = row_begin; j < begin; ++j) {
+            index[inner] = j;
+            boundary_single(dst + dst_offset + j * dst_stride[inner], src, index.data(), buffer);
+          }
+          if (begin < end) {
+            char *child_src = src + src_offset + (begin + offset[inner]) * src_stride[inner];
+            child->strided(dst + dst_offset + begin * dst_stride[inner], dst_stride[inner], &child_src,
+                           &src_stride[inner], end - begin);
+          }
+          for (intptr_t j = end; j < row_end; ++j) {
+            index[inner] = j;
+            boundary_single(dst + dst_offset + j * dst_stride[inner], src, index.data(), buffer);
+          }
+
+          intptr_t i = inner - 1;
+          while (i >= 0 && ++index[i] == std::min(first[i] + tile[i], shape[i])) {
+            index[i] = first[i];
+            --i;
+          }
+          if (i < 0) {
+            break;
+          }
+        }
+      }
+
+      /**
+       * Processes every ``step``-th tile, starting at tile ``start``.
+       */
+      void tiles_single(char *dst, char *src, intptr_t start, intptr_t step) {
+        std::vector<char> buffer((boundary_mode == neighborhood_boundary_fill) ? 0 : get_window_size());
+
+        std::vector<intptr_t> tile_count(ndim);
+        intptr_t count = 1;
+        for (intptr_t i = 0; i < ndim; ++i) {
+          tile_count[i] = (shape[i] + tile[i] - 1) / tile[i];
+          count *= tile_count[i];
+        }
+
+        std::vector<intptr_t> first(ndim);
+        for (intptr_t t = start; t < count; t += step) {
+          for (intptr_t i = ndim - 1, k = t; i >= 0; --i) {
+            first[i] = (k % tile_count[i]) * tile[i];
+            k /= tile_count[i];
+          }
+          tile_single(dst, src, first, buffer.data());
         }
+      }
 
-        *out_of_bounds = old_out_of_bounds;
+      void single(char *dst, char *const *src) {
+        intptr_t count = 1;
+        for (intptr_t i = 0; i < ndim; ++i) {
+          count *= (shape[i] + tile[i] - 1) / tile[i];
+        }
+        if (count == 0) {
+          return;
+        }
+
+        intptr_t threads_used = std::max(std::min(thread_count, count), static_cast<intptr_t>(1));
+
+        // Tiles are dealt out round robin, so that edge tiles spread across threads
+        parallel_for(threads_used, threads_used, 1, [&](intptr_t begin, intptr_t end) {
+          for (intptr_t t = begin; t < end; ++t) {
+            tiles_single(dst, src[0], t, threads_used);
+          }
+        });
       }
     };
 
@@ -0,0 +1,315 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+#include <dynd/kernels/base_strided_kernel.hpp>
+#include <dynd/parallel.hpp>
+#include <dynd/types/fixed_dim_type.hpp>
+
+#if !defined(__CUDACC__) && (defined(__SSE2__) || defined(_M_X64))
+#include <emmintrin.h>
+#define DYND_TRANSPOSE_SSE2
+#endif
+
+namespace dynd {
+namespace nd {
+
+  /**
+   * Copies of at least this many bytes bypass the cache with non-temporal
+   * stores where the target supports them.
+   */
+  static const size_t streaming_copy_threshold = 1 << 24;
+
+  /**
+   * Copies of at least this many bytes per thread are split across threads.
+   */
+  static const size_t parallel_copy_threshold = 1 << 22;
+
+  /**
+   * Copies ``size`` bytes between two buffers that don't overlap, like
+   * ``memcpy``, using up to ``thread_count`` threads for large copies.
+   */
+  DYND_API void bulk_copy(char *dst, const char *src, size_t size, intptr_t thread_count);
+
+  namespace detail {
+
+    /**
+     * Transposes an 8 x 8 block of Size byte elements, whose rows start
+     * ``src_stride`` bytes apart in the source and ``dst_stride`` bytes apart
+     * in the destination.
+     *
+     * The generic version goes through a local array, which works for any
+     * element size. Compilers don't turn it into shuffles, so 4 and 8 byte
+     * elements have SSE2 versions, which take about two thirds of the time on
+     * a plane too large for the cache.
+     */
+    template <size_t Size>
+    struct transpose_block {
+      static void run(char *dst, intptr_t dst_stride, const char *src, intptr_t src_stride) {
+        char values[8][8][Size];
+        for (intptr_t i = 0; i < 8; ++i) {
+          memcpy(values[i], src + i * src_stride, 8 * Size);
+        }
+        for (intptr_t j = 0; j < 8; ++j) {
+          char transposed[8][Size];
+          for (intptr_t i = 0; i < 8; ++i) {
+            memcpy(transposed[i], values[i][j], Size);
+          }
+          memcpy(dst + j * dst_stride, transposed, 8 * Size);
+        }
+      }
+    };
+
+#ifdef DYND_TRANSPOSE_SSE2
+    template <>
+    struct transpose_block<4> {
+      static void run(char *dst, intptr_t dst_stride, const char *src, intptr_t src_stride) {
+        for (intptr_t i = 0; i < 8; i += 4) {
+          for (intptr_t j = 0; j < 8; j += 4) {
+            const char *s = src + i * src_stride + j * 4;
+            __m128 a = _mm_loadu_ps(reinterpret_cast<const float *>(s));
+            __m128 b = _mm_loadu_ps(reinterpret_cast<const float *>(s + src_stride));
+            __m128 c = _mm_loadu_ps(reinterpret_cast<const float *>(s + 2 * src_stride));
+            __m128 d = _mm_loadu_ps(reinterpret_cast<const float *>(s + 3 * src_stride));
+            _MM_TRANSPOSE4_PS(a, b, c, d);
+            char *t = dst + j * dst_stride + i * 4;
+            _mm_storeu_ps(reinterpret_cast<float *>(t), a);
+            _mm_storeu_ps(reinterpret_cast<float *>(t + dst_stride), b);
+            _mm_storeu_ps(reinterpret_cast<float *>(t + 2 * dst_stride), c);
+            _mm_storeu_ps(reinterpret_cast<float *>(t + 3 * dst_stride), d);
+          }
+        }
+      }
+    };
+
+    template <>
+    struct transpose_block<8> {
+      static void run(char *dst, intptr_t dst_stride, const char *src, intptr_t src_stride) {
+        for (intptr_t i = 0; i < 8; i += 2) {
+          for (intptr_t j = 0; j < 8; j += 2) {
+            const char *s = src + i * src_stride + j * 8;
+            __m128d a = _mm_loadu_pd(reinterpret_cast<const double *>(s));
+            __m128d b = _mm_loadu_pd(reinterpret_cast<const double *>(s + src_stride));
+            char *t = dst + j * dst_stride + i * 8;
+            _mm_storeu_pd(reinterpret_cast<double *>(t), _mm_unpacklo_pd(a, b));
+            _mm_storeu_pd(reinterpret_cast<double *>(t + dst_stride), _mm_unpackhi_pd(a, b));
+          }
+        }
+      }
+    };
+#endif
+
+  } // namespace dynd::nd::detail
+
+  /**
+   * Copies ``ndim`` fixed dimensions of elements of type T, which is only used
+   * for its size, between two arbitrary strided layouts.
+   *
+   * The dimensions are ordered by the destination strides and merged where
+   * both layouts are contiguous across them. When the source is contiguous
+   * along a different dimension than the destination, as after a
+   * ``transpose`` or ``permute``, the plane of those two dimensions is
+   * copied in square tiles, so that both sides are read and written a cache
+   * line at a time instead of one of them jumping by its large stride on
+   * every element. Inside a tile, the work is done in 8 x 8 blocks by
+   * ``detail::transpose_block``.
+   *
+   * Planes with at least ``parallel_threshold`` elements split their rows of
+   * tiles across ``thread_count`` threads, and contiguous runs go through
+   * ``bulk_copy``.
+   *
+   * Elements of a POD type whose size isn't that of T are copied with T as
+   * ``uint8_t`` and ``element_size`` bytes as an extra innermost dimension.
+   */
+  template <typename T>
+  struct permuted_copy_kernel : base_strided_kernel<permuted_copy_kernel<T>, 1> {
+    static const intptr_t block = 8;
+    static const intptr_t tile = 64;
+    static const intptr_t parallel_threshold = 1 << 20;
+
+    // The dimensions after merging, outermost first by destination stride
+    std::vector<intptr_t> m_size;
+    std::vector<intptr_t> m_dst_stride;
+    std::vector<intptr_t> m_src_stride;
+    // The dimension the source is contiguous along, if it is not the innermost one
+    intptr_t m_src_inner;
+    intptr_t m_thread_count;
+
+    permuted_copy_kernel(intptr_t ndim, const char *dst_arrmeta, const char *src_arrmeta, intptr_t thread_count,
+                         intptr_t element_size = sizeof(T))
+        : m_src_inner(-1), m_thread_count(thread_count) {
+      const size_stride_t *dst_ss = reinterpret_cast<const size_stride_t *>(dst_arrmeta);
+      const size_stride_t *src_ss = reinterpret_cast<const size_stride_t *>(src_arrmeta);
+
+      std::vector<intptr_t> order(ndim);
+      std::iota(order.begin(), order.end(), 0);
+      std::stable_sort(order.begin(), order.end(), [dst_ss](intptr_t j, intptr_t k) {
+        return std::abs(dst_ss[j].stride) > std::abs(dst_ss[k].stride);
+      });
+
+      for (intptr_t j : order) {
+        if (dst_ss[j].dim_size == 0) {
+          // Nothing to copy
+          m_size.assign(1, 0);
+          m_dst_stride.assign(1, 0);
+          m_src_stride.assign(1, 0);
+          return;
+        }
+        if (dst_ss[j].dim_size != 1) {
+          push_dim(dst_ss[j].dim_size, dst_ss[j].stride, src_ss[j].stride);
+        }
+      }
+      if (element_size != static_cast<intptr_t>(sizeof(T))) {
+        push_dim(element_size / sizeof(T), sizeof(T), sizeof(T));
+      }
+
+      if (m_size.empty()) {
+        m_size.push_back(1);
+        m_dst_stride.push_back(0);
+        m_src_stride.push_back(0);
+      }
+
+      intptr_t inner = m_size.size() - 1;
+      intptr_t j = std::min_element(m_src_stride.begin(), m_src_stride.end(),
+                                    [](intptr_t a, intptr_t b) { return std::abs(a) < std::abs(b); }) -
+                   m_src_stride.begin();
+      if (j != inner && std::abs(m_src_stride[j]) < std::abs(m_src_stride[inner])) {
+        m_src_inner = j;
+      }
+    }
+
+    /**
+     * Appends a dimension inside the existing ones, merging it into the
+     * innermost one when both layouts are contiguous across the two.
+     */
+    void push_dim(intptr_t size, intptr_t dst_stride, intptr_t src_stride) {
+      if (!m_size.empty() && m_dst_stride.back() == dst_stride * size && m_src_stride.back() == src_stride * size) {
+        m_size.back() *= size;
+        m_dst_stride.back() = dst_stride;
+        m_src_stride.back() = src_stride;
+      } else {
+        m_size.push_back(size);
+        m_dst_stride.push_back(dst_stride);
+        m_src_stride.push_back(src_stride);
+      }
+    }
+
+    static void copy_element(char *dst, const char *src) { memcpy(dst, src, sizeof(T)); }
+
+    void copy_row(char *dst, const char *src) const {
+      intptr_t size = m_size.back(), dst_stride = m_dst_stride.back(), src_stride = m_src_stride.back();
+      if (dst_stride == static_cast<intptr_t>(sizeof(T)) && src_stride == static_cast<intptr_t>(sizeof(T))) {
+        size_t nbytes = size * sizeof(T);
+        if (nbytes < parallel_copy_threshold) {
+          memcpy(dst, src, nbytes);
+        } else {
+          bulk_copy(dst, src, nbytes, m_thread_count);
+        }
+      } else {
+        for (intptr_t i = 0; i < size; ++i, dst += dst_stride, src += src_stride) {
+          copy_element(dst, src);
+        }
+      }
+    }
+
+    /**
+     * Copies rows [row_begin, row_end) by columns [col_begin, col_end) of the
+     * plane, where rows are the source's contiguous dimension and columns the
+     * destination's.
+     */
+    void copy_tile(char *dst, const char *src, intptr_t row_begin, intptr_t row_end, intptr_t col_begin,
+                   intptr_t col_end) const {
+      intptr_t dst_row_stride = m_dst_stride[m_src_inner], dst_col_stride = m_dst_stride.back();
+      intptr_t src_row_stride = m_src_stride[m_src_inner], src_col_stride = m_src_stride.back();
+      bool unit =
+          dst_col_stride == static_cast<intptr_t>(sizeof(T)) && src_row_stride == static_cast<intptr_t>(sizeof(T));
+
+      intptr_t row = row_begin;
+      if (unit) {
+        for (; row + block <= row_end; row += block) {
+          intptr_t col = col_begin;
+          for (; col + block <= col_end; col += block) {
+            // Each source column of the block is a contiguous run of its rows
+            detail::transpose_block<sizeof(T)>::run(dst + row * dst_row_stride + col * dst_col_stride,
+                                                    dst_row_stride, src + row * src_row_stride + col * src_col_stride,
+                                                    src_col_stride);
+          }
+          for (intptr_t r = row; r < row + block; ++r) {
+            for (intptr_t c = col; c < col_end; ++c) {
+              copy_element(dst + r * dst_row_stride + c * dst_col_stride,
+                           src + r * src_row_stride + c * src_col_stride);
+            }
+          }
+        }
+      }
+      for (; row < row_end; ++row) {
+        for (intptr_t c = col_begin; c < col_end; ++c) {
+          copy_element(dst + row * dst_row_stride + c * dst_col_stride,
+                       src + row * src_row_stride + c * src_col_stride);
+        }
+      }
+    }
+
+    void copy_plane(char *dst, const char *src) const {
+      intptr_t rows = m_size[m_src_inner], cols = m_size.back();
+      intptr_t row_tiles = (rows + tile - 1) / tile;
+      auto copy_row_tiles = [&](intptr_t first, intptr_t step) {
+        for (intptr_t i = first; i < row_tiles; i += step) {
+          intptr_t row_end = std::min((i + 1) * tile, rows);
+          for (intptr_t col = 0; col < cols; col += tile) {
+            copy_tile(dst, src, i * tile, row_end, col, std::min(col + tile, cols));
+          }
+        }
+      };
+
+      intptr_t threads_used = std::min(m_thread_count, row_tiles);
+      if (threads_used <= 1 || rows * cols < parallel_threshold) {
+        copy_row_tiles(0, 1);
+        return;
+      }
+
+      // Each thread takes every threads_used-th row of tiles
+      parallel_for(threads_used, threads_used, 1, [&](intptr_t begin, intptr_t end) {
+        for (intptr_t t = begin; t < end; ++t) {
+          copy_row_tiles(t, threads_used);
+        }
+      });
+    }
+
+    void loop(intptr_t j, char *dst, const char *src) const {
+      if (j == m_src_inner) {
+        loop(j + 1, dst, src);
+        return;
+      }
+      if (j + 1 == static_cast<intptr_t>(m_size.size())) {
+        if (m_src_inner >= 0) {
+          copy_plane(dst, src);
+        } else {
+          copy_row(dst, src);
+        }
+        return;
+      }
+
+      for (intptr_t i = 0; i < m_size[j]; ++i, dst += m_dst_stride[j], src += m_src_stride[j]) {
+        loop(j + 1, dst, src);
+      }
+    }
+
+    void single(char *dst, char *const *src) {
+      if (m_size[0] != 0) {
+        loop(0, dst, src[0]);
+      }
+    }
+  };
+
+} // namespace dynd::nd
+} // namespace dynd
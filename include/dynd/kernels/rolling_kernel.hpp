@@ -0,0 +1,333 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <dynd/kernels/base_strided_kernel.hpp>
+#include <dynd/types/fixed_dim_type.hpp>
+#include <dynd/types/option_type.hpp>
+#include <dynd/types/var_dim_type.hpp>
+
+namespace dynd {
+namespace nd {
+
+  /**
+   * The statistic computed over each window by ``nd::rolling``.
+   */
+  enum rolling_statistic { rolling_sum, rolling_mean, rolling_min, rolling_max, rolling_var };
+
+  namespace detail {
+
+    // Whether a value is left out of its window. Integers are only missing
+    // when they are the NA of an option type, while floating point NaN is
+    // always missing.
+    template <typename ValueType>
+    std::enable_if_t<is_signed_integral<ValueType>::value, bool> rolling_is_missing(ValueType value, bool option) {
+      return option && value == std::numeric_limits<ValueType>::min();
+    }
+
+    template <typename ValueType>
+    std::enable_if_t<is_unsigned_integral<ValueType>::value, bool> rolling_is_missing(ValueType value, bool option) {
+      return option && value == std::numeric_limits<ValueType>::max();
+    }
+
+    template <typename ValueType>
+    std::enable_if_t<std::is_floating_point<ValueType>::value, bool> rolling_is_missing(ValueType value,
+                                                                                       bool DYND_UNUSED(option)) {
+      return value != value;
+    }
+
+    // A running sum that values are added to and removed from. Integers are
+    // summed exactly, and floating point uses a compensated sum so that
+    // rounding error does not build up over a long series.
+    template <typename ValueType, typename Enable = void>
+    struct rolling_accumulator {
+      int64_t sum = 0;
+
+      void add(ValueType value) { sum += static_cast<int64_t>(value); }
+
+      void remove(ValueType value) { sum -= static_cast<int64_t>(value); }
+
+      double get() const { return static_cast<double>(sum); }
+    };
+
+    template <typename ValueType>
+    struct rolling_accumulator<ValueType, std::enable_if_t<std::is_floating_point<ValueType>::value>> {
+      double sum = 0;
+      double compensation = 0;
+
+      void add(double value) {
+        double t = sum + value;
+        if (std::abs(sum) >= std::abs(value)) {
+          compensation += (sum - t) + value;
+        } else {
+          compensation += (value - t) + sum;
+        }
+        sum = t;
+      }
+
+      void remove(double value) { add(-value); }
+
+      double get() const { return sum + compensation; }
+    };
+
+  } // namespace dynd::nd::detail
+
+  /**
+   * Computes a statistic over the trailing window of each element of a
+   * one-dimensional fixed or var array, writing float64 results.
+   *
+   * Each step updates the state of the previous window instead of visiting
+   * the whole window again. Sums and means add the incoming value and remove
+   * the outgoing one, counting infinities on the side so that they never
+   * enter the sum. Minima and maxima keep a monotonic deque of candidates,
+   * and variance keeps Welford's running mean and sum of squared deviations.
+   *
+   * Missing values are skipped. A result is written once the window is full
+   * and holds at least ``min_periods`` values, and NaN (or NA, for an option
+   * result) is written otherwise.
+   */
+  template <typename Arg0Type>
+  struct rolling_kernel : base_strided_kernel<rolling_kernel<Arg0Type>, 1> {
+    rolling_statistic statistic;
+    intptr_t window;
+    intptr_t min_periods;
+    bool option;
+    bool var_src;
+    intptr_t src_size;
+    intptr_t src_stride;
+    intptr_t src_offset;
+    bool var_dst;
+    intptr_t dst_size;
+    intptr_t dst_stride;
+    memory_block dst_memory_block;
+
+    rolling_kernel(rolling_statistic statistic, intptr_t window, intptr_t min_periods, bool option,
+                   const ndt::type &src_tp, const char *src_arrmeta, const ndt::type &dst_tp, const char *dst_arrmeta)
+        : statistic(statistic), window(window), min_periods(min_periods), option(option),
+          var_src(src_tp.get_id() == var_dim_id), src_size(0), src_offset(0), var_dst(dst_tp.get_id() == var_dim_id),
+          dst_size(0) {
+      if (var_src) {
+        src_stride = reinterpret_cast<const ndt::var_dim_type::metadata_type *>(src_arrmeta)->stride;
+        src_offset = reinterpret_cast<const ndt::var_dim_type::metadata_type *>(src_arrmeta)->offset;
+      } else {
+        src_size = reinterpret_cast<const size_stride_t *>(src_arrmeta)->dim_size;
+        src_stride = reinterpret_cast<const size_stride_t *>(src_arrmeta)->stride;
+      }
+
+      if (var_dst) {
+        dst_stride = reinterpret_cast<const ndt::var_dim_type::metadata_type *>(dst_arrmeta)->stride;
+        dst_memory_block = reinterpret_cast<const ndt::var_dim_type::metadata_type *>(dst_arrmeta)->blockref;
+      } else {
+        dst_size = reinterpret_cast<const size_stride_t *>(dst_arrmeta)->dim_size;
+        dst_stride = reinterpret_cast<const size_stride_t *>(dst_arrmeta)->stride;
+      }
+    }
+
+    Arg0Type get(const char *src, intptr_t i) const {
+      return *reinterpret_cast<const Arg0Type *>(src + i * src_stride);
+    }
+
+    bool is_missing(Arg0Type value) const { return detail::rolling_is_missing(value, option); }
+
+    void put(char *dst, intptr_t i, double value) const { *reinterpret_cast<double *>(dst + i * dst_stride) = value; }
+
+    void put_missing(char *dst, intptr_t i) const {
+      if (option) {
+        *reinterpret_cast<uint64_t *>(dst + i * dst_stride) = DYND_FLOAT64_NA_AS_UINT;
+      } else {
+        put(dst, i, std::numeric_limits<double>::quiet_NaN());
+      }
+    }
+
+    bool ready(intptr_t i, intptr_t count) const { return i >= window - 1 && count >= min_periods; }
+
+    void sum_single(char *dst, const char *src, intptr_t size, bool mean) {
+      detail::rolling_accumulator<Arg0Type> acc;
+      intptr_t count = 0, pos_inf = 0, neg_inf = 0, negative = 0;
+      for (intptr_t i = 0; i < size; ++i) {
+        Arg0Type value = get(src, i);
+        if (!is_missing(value)) {
+          double x = static_cast<double>(value);
+          ++count;
+          if (x < 0) {
+            ++negative;
+          }
+          if (std::isinf(x)) {
+            ++((x > 0) ? pos_inf : neg_inf);
+          } else {
+            acc.add(value);
+          }
+        }
+
+        if (i >= window) {
+          value = get(src, i - window);
+          if (!is_missing(value)) {
+            double x = static_cast<double>(value);
+            --count;
+            if (x < 0) {
+              --negative;
+            }
+            if (std::isinf(x)) {
+              --((x > 0) ? pos_inf : neg_inf);
+            } else {
+              acc.remove(value);
+            }
+          }
+        }
+
+        if (!ready(i, count)) {
+          put_missing(dst, i);
+          continue;
+        }
+
+        double res;
+        if (pos_inf > 0 && neg_inf > 0) {
+          res = std::numeric_limits<double>::quiet_NaN();
+        } else if (pos_inf > 0) {
+          res = std::numeric_limits<double>::infinity();
+        } else if (neg_inf > 0) {
+          res = -std::numeric_limits<double>::infinity();
+        } else {
+          res = acc.get();
+          // Removing values can leave a small negative residue behind when only nonnegative values remain
+          if (negative == 0 && res < 0) {
+            res = 0;
+          }
+        }
+        put(dst, i, (mean && count > 0) ? res / static_cast<double>(count) : res);
+      }
+    }
+
+    template <typename Compare>
+    void extremum_single(char *dst, const char *src, intptr_t size, Compare comp) {
+      // A ring buffer of (value, index) candidates, ordered so that the front is the extremum of the window
+      std::vector<std::pair<Arg0Type, intptr_t>> deque(window);
+      intptr_t front = 0, deque_size = 0, count = 0;
+      for (intptr_t i = 0; i < size; ++i) {
+        if (deque_size > 0 && deque[front].second <= i - window) {
+          front = (front + 1) % window;
+          --deque_size;
+        }
+
+        Arg0Type value = get(src, i);
+        if (!is_missing(value)) {
+          ++count;
+          while (deque_size > 0 && !comp(deque[(front + deque_size - 1) % window].first, value)) {
+            --deque_size;
+          }
+          deque[(front + deque_size) % window] = std::make_pair(value, i);
+          ++deque_size;
+        }
+        if (i >= window && !is_missing(get(src, i - window))) {
+          --count;
+        }
+
+        if (ready(i, count) && deque_size > 0) {
+          put(dst, i, static_cast<double>(deque[front].first));
+        } else {
+          put_missing(dst, i);
+        }
+      }
+    }
+
+    void var_single(char *dst, const char *src, intptr_t size) {
+      double mean = 0, m2 = 0;
+      intptr_t count = 0, inf = 0;
+      for (intptr_t i = 0; i < size; ++i) {
+        Arg0Type value = get(src, i);
+        if (!is_missing(value)) {
+          ++count;
+          double x = static_cast<double>(value);
+          if (std::isinf(x)) {
+            ++inf;
+          } else {
+            intptr_t n = count - inf;
+            double delta = x - mean;
+            mean += delta / static_cast<double>(n);
+            m2 += delta * (x - mean);
+          }
+        }
+
+        if (i >= window) {
+          value = get(src, i - window);
+          if (!is_missing(value)) {
+            --count;
+            double x = static_cast<double>(value);
+            if (std::isinf(x)) {
+              --inf;
+            } else {
+              intptr_t n = count - inf;
+              if (n == 0) {
+                mean = 0;
+                m2 = 0;
+              } else {
+                double delta = x - mean;
+                mean -= delta / static_cast<double>(n);
+                m2 -= delta * (x - mean);
+              }
+            }
+          }
+        }
+
+        if (!ready(i, count)) {
+          put_missing(dst, i);
+        } else if (inf > 0 || count < 2) {
+          put(dst, i, std::numeric_limits<double>::quiet_NaN());
+        } else {
+          put(dst, i, std::max(m2, 0.0) / static_cast<double>(count - 1));
+        }
+      }
+    }
+
+    void single(char *dst, char *const *src) {
+      const char *src0 = src[0];
+      intptr_t size = src_size;
+      if (var_src) {
+        const ndt::var_dim_type::data_type *src0_d = reinterpret_cast<const ndt::var_dim_type::data_type *>(src0);
+        src0 = src0_d->begin + src_offset;
+        size = src0_d->size;
+      }
+
+      if (var_dst) {
+        ndt::var_dim_type::data_type *dst_d = reinterpret_cast<ndt::var_dim_type::data_type *>(dst);
+        if (dst_d->begin == NULL) {
+          dst_d->begin = dst_memory_block->alloc(size);
+          dst_d->size = size;
+        } else if (static_cast<intptr_t>(dst_d->size) != size) {
+          throw broadcast_error(dst_d->size, size, "var", "var");
+        }
+        dst = dst_d->begin;
+      } else if (dst_size != size) {
+        throw broadcast_error(dst_size, size, "strided", "var");
+      }
+
+      switch (statistic) {
+      case rolling_sum:
+        sum_single(dst, src0, size, false);
+        break;
+      case rolling_mean:
+        sum_single(dst, src0, size, true);
+        break;
+      case rolling_min:
+        extremum_single(dst, src0, size, [](Arg0Type x, Arg0Type y) { return x < y; });
+        break;
+      case rolling_max:
+        extremum_single(dst, src0, size, [](Arg0Type x, Arg0Type y) { return x > y; });
+        break;
+      case rolling_var:
+        var_single(dst, src0, size);
+        break;
+      }
+    }
+  };
+
+} // namespace dynd::nd
+} // namespace dynd
@@ -14,7 +14,84 @@
 namespace dynd {
 namespace nd {
 
-  struct string_split_kernel : base_strided_kernel<string_split_kernel, 2> {
+  /**
+   * A split piece given as [begin, end) byte offsets into the source string,
+   * for splitting without copying.
+   */
+  struct string_piece_offsets {
+    intptr_t begin;
+    intptr_t end;
+  };
+
+  namespace detail {
+
+    inline void assign_split_piece(string &dst, const char *src, size_t begin, size_t end)
+    {
+      dst.assign(src + begin, end - begin);
+    }
+
+    inline void assign_split_piece(string_piece_offsets &dst, const char *DYND_UNUSED(src), size_t begin, size_t end)
+    {
+      dst.begin = begin;
+      dst.end = end;
+    }
+
+    /**
+     * Appends the pieces of split strings to a single allocation from a memory
+     * block, growing it geometrically, so each haystack is searched only once.
+     * The allocation may move while it grows, so pointers into it are only
+     * stable after ``finish``.
+     */
+    template <typename PieceType>
+    class string_split_appender {
+      const memory_block &m_memblock;
+      char *m_begin;
+      size_t m_size, m_capacity;
+      const char *m_src;
+      size_t m_src_size, m_split_size, m_last_src_start;
+
+      void append(size_t begin, size_t end)
+      {
+        if (m_size == m_capacity) {
+          m_capacity *= 2;
+          m_begin = m_memblock->resize(m_begin, m_capacity);
+        }
+        assign_split_piece(reinterpret_cast<PieceType *>(m_begin)[m_size++], m_src, begin, end);
+      }
+
+    public:
+      string_split_appender(const memory_block &memblock, size_t capacity)
+          : m_memblock(memblock), m_begin(memblock->alloc(capacity)), m_size(0), m_capacity(capacity)
+      {
+      }
+
+      size_t size() const { return m_size; }
+
+      void split(const string &haystack, const string &needle)
+      {
+        m_src = haystack.begin();
+        m_src_size = haystack.size();
+        m_split_size = needle.size();
+        m_last_src_start = 0;
+        dynd::detail::string_search(haystack, needle, *this);
+        append(m_last_src_start, m_src_size);
+      }
+
+      bool operator()(const size_t match)
+      {
+        append(m_last_src_start, match);
+        m_last_src_start = match + m_split_size;
+
+        return false;
+      }
+
+      char *finish() { return m_begin = m_memblock->resize(m_begin, m_size); }
+    };
+
+  } // namespace dynd::nd::detail
+
+  template <typename PieceType>
+  struct string_split_kernel : base_strided_kernel<string_split_kernel<PieceType>, 2> {
     memory_block m_dst_memblock;
 
     string_split_kernel(const memory_block &dst_memblock) : m_dst_memblock(dst_memblock) {}
@@ -23,26 +100,11 @@ namespace nd {
       ndt::var_dim_type::data_type *dst_v = reinterpret_cast<ndt::var_dim_type::data_type *>(dst);
 
       const string *const *s = reinterpret_cast<const string *const *>(src);
-      const string &haystack = *(s[0]);
-      const string &needle = *(s[1]);
-
-      intptr_t count = dynd::string_count(haystack, needle);
-
-      if (count == 0) {
-        dst_v->begin = m_dst_memblock->alloc(1);
-        dst_v->size = 1;
-        string *dst_str = reinterpret_cast<string *>(dst_v->begin);
-        dst_str[0] = haystack;
-        return;
-      }
-
-      dst_v->begin = m_dst_memblock->alloc(count + 1);
-      dst_v->size = count + 1;
-      string *dst_str = reinterpret_cast<string *>(dst_v->begin);
 
-      dynd::detail::string_splitter<string> f(dst_str, haystack, needle);
-      dynd::detail::string_search(haystack, needle, f);
-      f.finish();
+      detail::string_split_appender<PieceType> f(m_dst_memblock, 8);
+      f.split(*(s[0]), *(s[1]));
+      dst_v->size = f.size();
+      dst_v->begin = f.finish();
     }
   };
 
@@ -17,8 +17,19 @@ namespace nd {
     size_t src_data_offset;
   };
 
+  /**
+   * A block of bytes that is copied directly from src to dst, covering
+   * one or more POD fields whose types match.
+   */
+  struct tuple_unary_op_copy_item {
+    size_t dst_data_offset;
+    size_t src_data_offset;
+    size_t data_size;
+  };
+
   struct tuple_unary_op_ck : nd::base_strided_kernel<tuple_unary_op_ck, 1> {
     std::vector<tuple_unary_op_item> m_fields;
+    std::vector<tuple_unary_op_copy_item> m_copies;
 
     ~tuple_unary_op_ck() {
       for (size_t i = 0; i < m_fields.size(); ++i) {
@@ -26,8 +37,30 @@ namespace nd {
       }
     }
 
+    /**
+     * Adds a field that is copied with memcpy instead of a child kernel,
+     * merging it into the previous copy block when the field directly
+     * follows it in both src and dst.
+     */
+    void add_copy(size_t dst_data_offset, size_t src_data_offset, size_t data_size) {
+      if (!m_copies.empty()) {
+        tuple_unary_op_copy_item &last = m_copies.back();
+        if (last.dst_data_offset + last.data_size == dst_data_offset &&
+            last.src_data_offset + last.data_size == src_data_offset) {
+          last.data_size += data_size;
+          return;
+        }
+      }
+
+      m_copies.push_back({dst_data_offset, src_data_offset, data_size});
+    }
+
     void single(char *dst, char *const *src) {
-      const tuple_unary_op_item *fi = &m_fields[0];
+      for (const tuple_unary_op_copy_item &item : m_copies) {
+        memcpy(dst + item.dst_data_offset, src[0] + item.src_data_offset, item.data_size);
+      }
+
+      const tuple_unary_op_item *fi = m_fields.data();
       intptr_t field_count = m_fields.size();
       kernel_prefix *child;
       kernel_single_t child_fn;
@@ -40,6 +73,35 @@ namespace nd {
         child_fn(child, dst + item.dst_data_offset, &child_src);
       }
     }
+
+    void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count) {
+      // Whole records that are one contiguous copy block move in a single memcpy
+      if (m_fields.empty() && m_copies.size() == 1 && m_copies[0].dst_data_offset == 0 &&
+          m_copies[0].src_data_offset == 0 && static_cast<intptr_t>(m_copies[0].data_size) == dst_stride &&
+          dst_stride == src_stride[0]) {
+        memcpy(dst, src[0], count * m_copies[0].data_size);
+        return;
+      }
+
+      // Otherwise process the records a field at a time
+      for (const tuple_unary_op_copy_item &item : m_copies) {
+        char *child_dst = dst + item.dst_data_offset;
+        char *child_src = src[0] + item.src_data_offset;
+        for (size_t i = 0; i != count; ++i, child_dst += dst_stride, child_src += src_stride[0]) {
+          memcpy(child_dst, child_src, item.data_size);
+        }
+      }
+
+      for (const tuple_unary_op_item &item : m_fields) {
+        kernel_prefix *child = get_child(item.child_kernel_offset);
+        kernel_single_t child_fn = child->get_function<kernel_single_t>();
+        char *child_dst = dst + item.dst_data_offset;
+        char *child_src = src[0] + item.src_data_offset;
+        for (size_t i = 0; i != count; ++i, child_dst += dst_stride, child_src += src_stride[0]) {
+          child_fn(child, child_dst, &child_src);
+        }
+      }
+    }
   };
 
 } // namespace dynd::nd
@@ -0,0 +1,28 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <dynd/callable.hpp>
+
+namespace dynd {
+namespace nd {
+
+  /**
+   * Multiplies the matrices in the two innermost dimensions of its arguments,
+   * so that ``... * M * K * T`` by ``... * K * N * T`` gives ``... * M * N * T``,
+   * broadcasting over any leading dimensions. T may be float32, float64,
+   * complex[float32] or complex[float64].
+   */
+  extern DYND_API callable matmul;
+
+  /**
+   * Returns a callable that computes the same product as ``matmul``, splitting
+   * large products and batches of matrices across ``thread_count`` threads.
+   */
+  DYND_API callable parallel_matmul(intptr_t thread_count);
+
+} // namespace dynd::nd
+} // namespace dynd
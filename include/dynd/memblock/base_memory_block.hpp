@@ -58,6 +58,14 @@ namespace nd {
      */
     virtual void reset() { throw std::runtime_error("reset is not implemented"); }
 
+    /**
+     * Moves the memory allocated from a finalized memory block into one
+     * contiguous allocation, updating the given pointers into it to match.
+     */
+    virtual void compact(intptr_t DYND_UNUSED(count), char **const *DYND_UNUSED(pointers)) {
+      throw std::runtime_error("compact is not implemented");
+    }
+
     /**
      * Does a debug dump of the memory block.
      */
@@ -0,0 +1,80 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <dynd/config.hpp>
+
+namespace dynd {
+namespace nd {
+
+  /**
+   * Memory blocks at least this large are allocated with ``large_buffer_alignment``,
+   * and nd::make_array aligns the data within them to it too.
+   */
+  const size_t large_buffer_size = 65536;
+  const size_t large_buffer_alignment = 64;
+
+  /**
+   * The allocator behind buffer_memory_block and fixed_size_pod_memory_block. The
+   * alignment is either 16 or ``large_buffer_alignment``, and ``deallocate`` is
+   * called with the same size and alignment that were passed to ``allocate``.
+   */
+  class DYNDT_API buffer_allocator {
+  public:
+    virtual ~buffer_allocator();
+
+    virtual void *allocate(size_t size, size_t alignment) = 0;
+    virtual void deallocate(void *ptr, size_t size, size_t alignment) = 0;
+  };
+
+  /**
+   * Counters describing the memory blocks allocated so far, across all threads.
+   */
+  struct buffer_allocation_stats {
+    /** The number of memory blocks allocated. */
+    uint64_t allocation_count;
+    /** The number of those served from a thread's cache of freed blocks. */
+    uint64_t cached_count;
+    /** The number of those allocated with the large buffer alignment. */
+    uint64_t large_count;
+    /** The number of bytes in memory blocks which have not been freed yet. */
+    uint64_t bytes_in_use;
+  };
+
+  /**
+   * Returns the default allocator. It keeps a per-thread cache of freed blocks in
+   * power of two size classes up to 4096 bytes, and hands larger blocks to malloc.
+   */
+  DYNDT_API buffer_allocator *get_default_buffer_allocator();
+
+  /**
+   * Sets the allocator used for memory blocks allocated from now on, or restores
+   * the default for nullptr. Each block is freed through the allocator that
+   * allocated it, so the allocator must outlive its blocks.
+   */
+  DYNDT_API void set_buffer_allocator(buffer_allocator *allocator);
+
+  DYNDT_API buffer_allocator *get_buffer_allocator();
+
+  /**
+   * Enables or disables backing memory blocks of 2MB or more with huge pages in
+   * the default allocator, where the platform supports it.
+   */
+  DYNDT_API void set_huge_pages(bool enable);
+
+  DYNDT_API buffer_allocation_stats get_buffer_allocation_stats();
+
+  namespace detail {
+
+    DYNDT_API void *allocate_buffer(size_t size);
+    DYNDT_API void deallocate_buffer(void *ptr);
+
+  } // namespace dynd::nd::detail
+} // namespace dynd::nd
+} // namespace dynd
@@ -8,6 +8,7 @@
 #include <iostream>
 #include <string>
 
+#include <dynd/memblock/buffer_allocator.hpp>
 #include <dynd/memory_block.hpp>
 #include <dynd/type.hpp>
 #include <dynd/types/base_memory_type.hpp>
@@ -109,11 +110,11 @@ namespace nd {
       o << indent << "------" << std::endl;
     }
 
-    static void *operator new(size_t size, size_t extra_size) { return ::operator new(size + extra_size); }
+    static void *operator new(size_t size, size_t extra_size) { return detail::allocate_buffer(size + extra_size); }
 
-    static void operator delete(void *ptr) { return ::operator delete(ptr); }
+    static void operator delete(void *ptr) { detail::deallocate_buffer(ptr); }
 
-    static void operator delete(void *ptr, size_t DYND_UNUSED(extra_size)) { return ::operator delete(ptr); }
+    static void operator delete(void *ptr, size_t DYND_UNUSED(extra_size)) { detail::deallocate_buffer(ptr); }
 
     friend class buffer;
 
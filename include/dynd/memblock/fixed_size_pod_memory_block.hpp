@@ -9,6 +9,7 @@
 #include <string>
 
 #include <dynd/memblock/base_memory_block.hpp>
+#include <dynd/memblock/buffer_allocator.hpp>
 
 namespace dynd {
 namespace nd {
@@ -21,11 +22,11 @@ namespace nd {
       o << indent << "------" << std::endl;
     }
 
-    static void *operator new(size_t size, size_t extra_size) { return ::operator new(size + extra_size); }
+    static void *operator new(size_t size, size_t extra_size) { return detail::allocate_buffer(size + extra_size); }
 
-    static void operator delete(void *ptr) { return ::operator delete(ptr); }
+    static void operator delete(void *ptr) { detail::deallocate_buffer(ptr); }
 
-    static void operator delete(void *ptr, size_t DYND_UNUSED(extra_size)) { return ::operator delete(ptr); }
+    static void operator delete(void *ptr, size_t DYND_UNUSED(extra_size)) { detail::deallocate_buffer(ptr); }
   };
 
 } // namespace dynd::nd
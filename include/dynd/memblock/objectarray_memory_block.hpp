@@ -31,6 +31,7 @@ namespace nd {
    *                for each element. This would be typically set to the value for
    *                get_default_data_size() corresponding to default-constructed arrmeta.
    * \param initial_count  The number of elements to allocate at the start.
+   * \param growth_factor  How much each further chunk grows the total capacity by.
    */
   class objectarray_memory_block : public base_memory_block {
     ndt::type m_dt;
@@ -38,21 +39,28 @@ namespace nd {
     const char *m_arrmeta;
     intptr_t m_stride;
     size_t m_total_allocated_count;
+    double m_growth_factor;
     bool m_finalized;
     /** The malloc'd memory */
     std::vector<memory_chunk> m_memory_handles;
 
   public:
     objectarray_memory_block(const ndt::type &dt, size_t arrmeta_size, const char *arrmeta, intptr_t stride,
-                             intptr_t initial_count)
+                             intptr_t initial_count, double growth_factor = 2.0)
         : m_dt(dt), arrmeta_size(arrmeta_size), m_arrmeta(arrmeta), m_stride(stride), m_total_allocated_count(0),
-          m_finalized(false), m_memory_handles() {
+          m_growth_factor(growth_factor), m_finalized(false), m_memory_handles() {
       if ((dt.get_flags() & type_flag_destructor) == 0) {
         std::stringstream ss;
         ss << "Cannot create objectarray memory block with dynd type " << dt;
         ss << " because it does not have a destructor, use a POD memory block instead";
         throw std::runtime_error(ss.str());
       }
+      if (!(growth_factor >= 1.0)) {
+        std::stringstream ss;
+        ss << "Cannot create an objectarray memory block with growth factor " << growth_factor
+           << ", it must be at least 1";
+        throw std::invalid_argument(ss.str());
+      }
       append_memory(initial_count);
     }
 
@@ -82,12 +90,20 @@ namespace nd {
       m_total_allocated_count += count;
     }
 
+    /**
+     * The element count of the next chunk, which grows the total capacity by
+     * the growth factor, or fits the requested count, whichever is larger.
+     */
+    size_t get_next_count(size_t count) const {
+      return std::max(static_cast<size_t>(m_total_allocated_count * (m_growth_factor - 1.0)), count);
+    }
+
     char *alloc(size_t count) {
       //    cout << "allocating " << size_bytes << " of memory with alignment " << alignment << endl;
       // Allocate new POD memory of the requested size and alignment
       memory_chunk *mc = &m_memory_handles.back();
       if (mc->capacity_count - mc->used_count < count) {
-        append_memory(std::max(m_total_allocated_count, count));
+        append_memory(get_next_count(count));
         mc = &m_memory_handles.back();
       }
 
@@ -112,13 +128,15 @@ namespace nd {
       char *result = previous_allocated;
 
       if (mc->capacity_count - previous_index < count) {
-        append_memory(std::max(m_total_allocated_count, count));
+        append_memory(get_next_count(count));
+        // Appending may have reallocated the vector of chunks
+        mc = &m_memory_handles[m_memory_handles.size() - 2];
         memory_chunk *new_mc = &m_memory_handles.back();
         // Move the old memory to the newly allocated block
         if (previous_count > 0) {
           // Subtract the previously used memory from the old chunk's count
           mc->used_count -= previous_count;
-          memcpy(new_mc->memory, previous_allocated, previous_count);
+          memcpy(new_mc->memory, previous_allocated, previous_count * m_stride);
           // If the old memory only had the memory being resized,
           // free it completely.
           if (previous_allocated == mc->memory) {
@@ -146,7 +164,7 @@ namespace nd {
         // Zero-init the new memory
         intptr_t new_count = count - (intptr_t)previous_count;
         if (new_count > 0) {
-          memset(mc->memory + m_stride * previous_count, 0, m_stride * new_count);
+          memset(result + m_stride * previous_count, 0, m_stride * new_count);
         }
       } else {
         // TODO: Add a default data constructor to base_type
@@ -160,22 +178,29 @@ namespace nd {
 
     void finalize() { m_finalized = true; }
 
+    /**
+     * Destroys all the objects allocated so far, also after ``finalize``. If they
+     * were spread over several chunks, those are replaced by a single chunk as
+     * large as all of them, so filling the block with as many objects again needs
+     * no more mallocs.
+     */
     void reset() {
+      for (size_t i = 0, i_end = m_memory_handles.size(); i != i_end; ++i) {
+        memory_chunk &mc = m_memory_handles[i];
+        m_dt.extended()->data_destruct_strided(m_arrmeta + arrmeta_size, mc.memory, m_stride, mc.used_count);
+        mc.used_count = 0;
+      }
+
       if (m_memory_handles.size() > 1) {
-        // If there are more than one allocated memory chunks,
-        // throw them all away except the last
-        for (size_t i = 0, i_end = m_memory_handles.size() - 1; i != i_end; ++i) {
-          memory_chunk &mc = m_memory_handles[i];
-          m_dt.extended()->data_destruct_strided(m_arrmeta, mc.memory, m_stride, mc.used_count);
-          free(mc.memory);
+        for (size_t i = 0, i_end = m_memory_handles.size(); i != i_end; ++i) {
+          free(m_memory_handles[i].memory);
         }
-        m_memory_handles.front() = m_memory_handles.back();
-        m_memory_handles.resize(1);
-        // Reset to zero used elements in the chunk
-        memory_chunk &mc = m_memory_handles.front();
-        m_dt.extended()->data_destruct_strided(m_arrmeta, mc.memory, m_stride, mc.used_count);
-        mc.used_count = 0;
+        m_memory_handles.clear();
+        size_t count = m_total_allocated_count;
+        m_total_allocated_count = 0;
+        append_memory(count);
       }
+      m_finalized = false;
     }
 
     void debug_print(std::ostream &o, const std::string &indent) {
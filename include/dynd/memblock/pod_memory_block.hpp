@@ -6,7 +6,10 @@
 #pragma once
 
 #include <iostream>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 #include <dynd/memblock/base_memory_block.hpp>
 #include <dynd/type.hpp>
@@ -14,27 +17,53 @@
 namespace dynd {
 namespace nd {
 
+  /**
+   * A malloc'd chunk of a pod_memory_block. Data is doled out of [begin, used_end),
+   * and [used_end, end) is still free.
+   */
+  struct pod_memory_chunk {
+    char *begin, *used_end, *end;
+  };
+
+  /**
+   * Creates a memory block which can be used to allocate POD output memory
+   * for blockref types.
+   *
+   * The memory is doled out of malloc'd chunks. The first has the initial
+   * capacity, and each further chunk grows the total capacity by the growth
+   * factor, so the default of 2 doubles it every time.
+   */
   class pod_memory_block : public base_memory_block {
   public:
     size_t data_size;
     intptr_t data_alignment;
     intptr_t m_total_allocated_capacity;
+    double m_growth_factor;
     /** The malloc'd memory */
-    std::vector<char *> m_memory_handles;
+    std::vector<pod_memory_chunk> m_memory_handles;
     /** The current malloc'd memory being doled out */
     char *m_memory_begin, *m_memory_current, *m_memory_end;
 
-    pod_memory_block(size_t data_size, intptr_t data_alignment, intptr_t initial_capacity_bytes = 2048)
-        : data_size(data_size), data_alignment(data_alignment), m_total_allocated_capacity(0), m_memory_handles() {
+    pod_memory_block(size_t data_size, intptr_t data_alignment, intptr_t initial_capacity_bytes = 2048,
+                     double growth_factor = 2.0)
+        : data_size(data_size), data_alignment(data_alignment), m_total_allocated_capacity(0),
+          m_growth_factor(growth_factor), m_memory_handles(), m_memory_begin(NULL), m_memory_current(NULL),
+          m_memory_end(NULL) {
+      if (!(growth_factor >= 1.0)) {
+        std::stringstream ss;
+        ss << "Cannot create a pod memory block with growth factor " << growth_factor << ", it must be at least 1";
+        throw std::invalid_argument(ss.str());
+      }
       append_memory(initial_capacity_bytes);
     }
 
-    pod_memory_block(const ndt::type &tp, intptr_t initial_capacity_bytes = 2048)
-        : pod_memory_block(tp.get_default_data_size(), tp.get_data_alignment(), initial_capacity_bytes) {}
+    pod_memory_block(const ndt::type &tp, intptr_t initial_capacity_bytes = 2048, double growth_factor = 2.0)
+        : pod_memory_block(tp.get_default_data_size(), tp.get_data_alignment(), initial_capacity_bytes,
+                           growth_factor) {}
 
     ~pod_memory_block() {
       for (size_t i = 0, i_end = m_memory_handles.size(); i != i_end; ++i) {
-        free(m_memory_handles[i]);
+        free(m_memory_handles[i].begin);
       }
     }
 
@@ -43,18 +72,31 @@ namespace nd {
      * more. Adds it to the memory handles vector.
      */
     void append_memory(intptr_t capacity_bytes) {
-      m_memory_handles.push_back(NULL);
+      if (m_memory_begin != NULL) {
+        m_memory_handles.back().used_end = m_memory_current;
+      }
+      m_memory_handles.push_back(pod_memory_chunk());
       m_memory_begin = reinterpret_cast<char *>(malloc(capacity_bytes));
-      m_memory_handles.back() = m_memory_begin;
       if (m_memory_begin == NULL) {
         m_memory_handles.pop_back();
         throw std::bad_alloc();
       }
       m_memory_current = m_memory_begin;
       m_memory_end = m_memory_current + capacity_bytes;
+      m_memory_handles.back().begin = m_memory_begin;
+      m_memory_handles.back().used_end = m_memory_begin;
+      m_memory_handles.back().end = m_memory_end;
       m_total_allocated_capacity += capacity_bytes;
     }
 
+    /**
+     * The capacity of the next chunk, which grows the total capacity by the
+     * growth factor, or fits the requested size, whichever is larger.
+     */
+    intptr_t get_next_capacity(intptr_t size_bytes) const {
+      return std::max(static_cast<intptr_t>(m_total_allocated_capacity * (m_growth_factor - 1.0)), size_bytes);
+    }
+
     char *alloc(size_t count) {
       intptr_t size_bytes = count * data_size;
 
@@ -65,9 +107,8 @@ namespace nd {
       char *end = begin + size_bytes;
       if (end > m_memory_end) {
         m_total_allocated_capacity -= m_memory_end - m_memory_current;
-        // Allocate memory to double the amount used so far, or the requested size, whichever is larger
         // NOTE: We're assuming malloc produces memory which has good enough alignment for anything
-        append_memory(std::max(m_total_allocated_capacity, size_bytes));
+        append_memory(get_next_capacity(size_bytes));
         begin = m_memory_begin;
         end = begin + size_bytes;
       }
@@ -97,10 +138,11 @@ namespace nd {
       } else {
         // If it doesn't fit, need to copy to newly malloc'd memory
         char *old_current = inout_begin, *old_end = *inout_end;
-        // Allocate memory to double the amount used so far, or the requested size, whichever is larger
+        // The resized memory no longer counts as used in the old chunk
+        m_memory_current = inout_begin;
         // NOTE: We're assuming malloc produces memory which has good enough alignment for anything
-        append_memory(std::max(m_total_allocated_capacity, size_bytes));
-        memcpy(m_memory_begin, inout_begin, *inout_end - inout_begin);
+        append_memory(get_next_capacity(size_bytes));
+        memcpy(m_memory_begin, inout_begin, old_end - old_current);
         end = m_memory_begin + size_bytes;
         m_memory_current = end;
         inout_begin = m_memory_begin;
@@ -115,6 +157,9 @@ namespace nd {
     }
 
     void finalize() {
+      if (m_memory_begin != NULL) {
+        m_memory_handles.back().used_end = m_memory_current;
+      }
       if (m_memory_current < m_memory_end) {
         m_total_allocated_capacity -= m_memory_end - m_memory_current;
       }
@@ -124,20 +169,96 @@ namespace nd {
       m_memory_end = NULL;
     }
 
+    /**
+     * Throws away all the memory allocated so far, also after ``finalize``. If it
+     * was spread over several chunks, they are replaced by a single chunk as large
+     * as all of them, so filling the block with as much data again needs no more
+     * mallocs.
+     */
     void reset() {
+      intptr_t capacity_bytes = 0;
+      for (size_t i = 0, i_end = m_memory_handles.size(); i != i_end; ++i) {
+        capacity_bytes += m_memory_handles[i].end - m_memory_handles[i].begin;
+      }
+
       if (m_memory_handles.size() > 1) {
-        // If there are more than one allocated memory chunks,
-        // throw them all away except the last
-        for (size_t i = 0, i_end = m_memory_handles.size() - 1; i != i_end; ++i) {
-          free(m_memory_handles[i]);
+        for (size_t i = 0, i_end = m_memory_handles.size(); i != i_end; ++i) {
+          free(m_memory_handles[i].begin);
         }
-        m_memory_handles.front() = m_memory_handles.back();
-        m_memory_handles.resize(1);
+        m_memory_handles.clear();
+        m_memory_begin = NULL;
+        m_total_allocated_capacity = 0;
+        append_memory(capacity_bytes);
+      } else {
+        // Reset to use the whole chunk
+        pod_memory_chunk &mc = m_memory_handles.front();
+        mc.used_end = mc.begin;
+        m_memory_begin = mc.begin;
+        m_memory_current = mc.begin;
+        m_memory_end = mc.end;
+        m_total_allocated_capacity = capacity_bytes;
       }
+    }
 
-      // Reset to use the whole chunk
-      m_memory_current = m_memory_begin;
-      m_total_allocated_capacity = m_memory_end - m_memory_begin;
+    /**
+     * Coalesces the chunks of a finalized memory block into a single allocation,
+     * so scans over the data allocated from it are contiguous. Each of the
+     * ``count`` pointers is updated to point at its data in the new allocation,
+     * and must point into memory allocated from this block, or be NULL.
+     */
+    void compact(intptr_t count, char **const *pointers) {
+      if (m_memory_begin != NULL) {
+        throw std::runtime_error("Cannot compact a pod memory block before it is finalized");
+      }
+      if (m_memory_handles.size() <= 1) {
+        return;
+      }
+
+      // Place the chunks one after another, keeping the data in each aligned
+      std::vector<intptr_t> offsets(m_memory_handles.size());
+      intptr_t size_bytes = 0;
+      for (size_t i = 0, i_end = m_memory_handles.size(); i != i_end; ++i) {
+        size_bytes = inc_to_alignment(size_bytes, data_alignment);
+        offsets[i] = size_bytes;
+        size_bytes += m_memory_handles[i].used_end - m_memory_handles[i].begin;
+      }
+
+      // Find where every pointer goes before touching anything, so a bad pointer leaves the block intact
+      std::vector<intptr_t> relocated(count);
+      for (intptr_t j = 0; j < count; ++j) {
+        char *ptr = *pointers[j];
+        if (ptr != NULL) {
+          size_t i = 0, i_end = m_memory_handles.size();
+          while (i != i_end && !(m_memory_handles[i].begin <= ptr && ptr <= m_memory_handles[i].used_end)) {
+            ++i;
+          }
+          if (i == i_end) {
+            throw std::invalid_argument("Cannot compact a pod memory block with a pointer not allocated from it");
+          }
+          relocated[j] = offsets[i] + (ptr - m_memory_handles[i].begin);
+        }
+      }
+
+      char *memory = reinterpret_cast<char *>(malloc(std::max<intptr_t>(size_bytes, 1)));
+      if (memory == NULL) {
+        throw std::bad_alloc();
+      }
+      for (size_t i = 0, i_end = m_memory_handles.size(); i != i_end; ++i) {
+        pod_memory_chunk &mc = m_memory_handles[i];
+        memcpy(memory + offsets[i], mc.begin, mc.used_end - mc.begin);
+        free(mc.begin);
+      }
+      for (intptr_t j = 0; j < count; ++j) {
+        if (*pointers[j] != NULL) {
+          *pointers[j] = memory + relocated[j];
+        }
+      }
+
+      m_memory_handles.resize(1);
+      m_memory_handles.front().begin = memory;
+      m_memory_handles.front().used_end = memory + size_bytes;
+      m_memory_handles.front().end = memory + size_bytes;
+      m_total_allocated_capacity = size_bytes;
     }
 
     void debug_print(std::ostream &o, const std::string &indent) {
@@ -0,0 +1,80 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace dynd {
+
+/**
+ * Returns the number of ranges ``parallel_for`` splits ``count`` items into,
+ * which is at most ``thread_count`` (the number of hardware threads when it is
+ * not positive) and leaves every range at least ``min_chunk_size`` items long.
+ */
+inline intptr_t parallel_chunk_count(intptr_t count, intptr_t thread_count, intptr_t min_chunk_size) {
+  if (thread_count <= 0) {
+    thread_count = std::max(static_cast<intptr_t>(std::thread::hardware_concurrency()), static_cast<intptr_t>(1));
+  }
+  return std::max(std::min(thread_count, count / std::max(min_chunk_size, static_cast<intptr_t>(1))),
+                  static_cast<intptr_t>(1));
+}
+
+/**
+ * Calls ``func(begin, end)`` over contiguous ranges that together cover
+ * [0, count), one range per thread, with as many ranges as
+ * ``parallel_chunk_count`` gives. Range ``i`` is
+ * [count * i / chunks, count * (i + 1) / chunks). The first range runs on the
+ * calling thread, so work too small to split starts no threads at all.
+ *
+ * Every range runs to completion, and then the first exception thrown by any
+ * of them is rethrown on the calling thread.
+ */
+template <typename FuncType>
+void parallel_for(intptr_t count, intptr_t thread_count, intptr_t min_chunk_size, FuncType &&func) {
+  intptr_t chunks = parallel_chunk_count(count, thread_count, min_chunk_size);
+  if (chunks <= 1) {
+    func(static_cast<intptr_t>(0), count);
+    return;
+  }
+
+  std::vector<std::exception_ptr> errors(chunks);
+  auto run = [&](intptr_t i) {
+    try {
+      func(count * i / chunks, count * (i + 1) / chunks);
+    } catch (...) {
+      errors[i] = std::current_exception();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(chunks - 1);
+  try {
+    for (intptr_t i = 1; i < chunks; ++i) {
+      threads.emplace_back(run, i);
+    }
+  } catch (...) {
+    // A thread failed to start, so its ranges run here instead
+    for (intptr_t i = static_cast<intptr_t>(threads.size()) + 1; i < chunks; ++i) {
+      run(i);
+    }
+  }
+  run(0);
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  for (const std::exception_ptr &error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+} // namespace dynd
@@ -772,6 +772,24 @@ std::enable_if_t<is_signed<T>::value && is_integral<T>::value, T> parse(const ch
   return 0;
 }
 
+/**
+ * Parses the decimal floating point number filling the range [begin, end),
+ * correctly rounded and independent of the C locale. The range doesn't need
+ * to be NUL-terminated. Returns false if it isn't a valid number.
+ */
+DYNDT_API bool parse_float(const char *begin, const char *end, double &out);
+
+DYNDT_API bool parse_float(const char *begin, const char *end, float &out);
+
+/**
+ * Parses the longest prefix of [begin, end) that is a decimal floating point
+ * number, after any leading whitespace, the way strtod does. Returns false,
+ * leaving ``out`` alone, if there is no such prefix.
+ */
+DYNDT_API bool parse_float_prefix(const char *begin, const char *end, double &out);
+
+DYNDT_API bool parse_float_prefix(const char *begin, const char *end, float &out);
+
 /**
  * Converts a string containing only a floating point number into
  * a float64/C double.
@@ -782,8 +800,8 @@ std::enable_if_t<is_floating_point<T>::value, T> parse(const char *begin, const
 {
   bool negative = false;
   const char *pos = begin;
-  if (pos < end && *pos == '-') {
-    negative = true;
+  if (pos < end && (*pos == '-' || *pos == '+')) {
+    negative = (*pos == '-');
     ++pos;
   }
   // First check for various NaN/Inf inputs
@@ -821,10 +839,12 @@ std::enable_if_t<is_floating_point<T>::value, T> parse(const char *begin, const
     }
   }
 
-  // TODO: use http://www.netlib.org/fp/dtoa.c
-  char *end_ptr;
-  std::string s(begin, end);
-  return strtod(s.c_str(), &end_ptr);
+  // Invalid input keeps the number at its start, or is 0 if there isn't one
+  T value = 0;
+  if (!parse_float(begin, end, value)) {
+    parse_float_prefix(begin, end, value);
+  }
+  return value;
 }
 
 template <typename T>
@@ -1015,8 +1035,8 @@ std::enable_if_t<is_floating_point<T>::value, T> parse(const char *begin, const
 {
   bool negative = false;
   const char *pos = begin;
-  if (pos < end && *pos == '-') {
-    negative = true;
+  if (pos < end && (*pos == '-' || *pos == '+')) {
+    negative = (*pos == '-');
     ++pos;
   }
   // First check for various NaN/Inf inputs
@@ -1054,10 +1074,8 @@ std::enable_if_t<is_floating_point<T>::value, T> parse(const char *begin, const
     }
   }
 
-  // TODO: use http://www.netlib.org/fp/dtoa.c
-  char *end_ptr;
-  T value = strto<T>(begin, &end_ptr);
-  if (end_ptr - begin != end - begin) {
+  T value;
+  if (!parse_float(begin, end, value)) {
     std::stringstream ss;
     ss << "parse error converting string ";
     ss.write(begin, end - begin);
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <dynd/callable.hpp>
+#include <dynd/kernels/rolling_kernel.hpp>
 
 namespace dynd {
 namespace nd {
@@ -14,5 +15,24 @@ namespace nd {
   extern DYND_API callable mean;
   extern DYND_API callable min;
 
+  /**
+   * Returns a callable that computes ``statistic`` over the trailing window
+   * of ``window`` elements at each position along the innermost dimension,
+   * broadcasting over any others. The result is float64, or ?float64 for
+   * option arguments.
+   *
+   * \param statistic  The statistic to compute for each window.
+   * \param window  The number of elements in each window.
+   * \param min_periods  The number of non-missing values a window needs to
+   *                     produce a result. A negative value means ``window``.
+   */
+  DYND_API callable rolling(rolling_statistic statistic, intptr_t window, intptr_t min_periods = -1);
+
+  /**
+   * Returns a rolling version of the reduction ``reduction``, which must be
+   * one of ``nd::sum``, ``nd::mean``, ``nd::min`` or ``nd::max``.
+   */
+  DYND_API callable rolling(const callable &reduction, intptr_t window, intptr_t min_periods = -1);
+
 } // namespace dynd::nd
 } // namespace dynd
@@ -169,9 +169,17 @@ namespace nd {
   extern DYND_API callable string_rfind;
   extern DYND_API callable string_replace;
   extern DYND_API callable string_split;
+  extern DYND_API callable string_split_offsets;
   extern DYND_API callable string_startswith;
   extern DYND_API callable string_endswith;
   extern DYND_API callable string_contains;
 
+  /**
+   * Splits every string of a ``N * string`` array by ``sep`` in a single pass
+   * over the column, returning a ``N * var * string``. The pieces of all the
+   * strings are stored in one allocation rather than one per string.
+   */
+  DYND_API array string_tokenize(const array &a, const std::string &sep);
+
 } // namespace dynd::nd
 } // namespace dynd
@@ -31,6 +31,9 @@ namespace ndt {
     nd::array m_category_index_to_value;
     // mapping from values to category indices
     nd::array m_value_to_category_index;
+    // open addressing hash table from categories to values, holding value + 1
+    // in each used slot, or empty if the category type can't be hashed
+    std::vector<uint32_t> m_value_hash_slots;
 
   public:
     categorical_type(type_id_t new_id, const nd::array &categories, bool presorted = false);
@@ -59,6 +62,14 @@ namespace ndt {
     uint32_t get_value_from_category(const char *category_arrmeta, const char *category_data) const;
     uint32_t get_value_from_category(const nd::array &category) const;
 
+    /**
+     * Looks up ``count`` strided categories at once, writing their values as
+     * the storage type. This reuses the hash table built at construction
+     * across the whole range, so it is what assignment kernels call.
+     */
+    void get_values_from_categories(char *dst, intptr_t dst_stride, const char *category_arrmeta, const char *src,
+                                    intptr_t src_stride, size_t count) const;
+
     const char *get_category_data_from_value(uint32_t value) const {
       if (value >= get_category_count()) {
         throw std::runtime_error("category value is out of bounds");
@@ -97,4 +108,23 @@ namespace ndt {
   DYND_API type factor_categorical(const nd::array &values);
 
 } // namespace dynd::ndt
+
+namespace nd {
+
+  /**
+   * Factorizes a one-dimensional array of strings or POD values in a single
+   * hashing pass. Returns an array of uint32 codes the same length as
+   * ``values``, and places the distinct values, in order of first appearance,
+   * in ``out_categories``, so that ``out_categories(codes(i))`` equals
+   * ``values(i)``. Values are compared by their bytes.
+   *
+   * \param values  The values to factorize.
+   * \param out_categories  Receives the distinct values.
+   * \param thread_count  The number of threads to split large inputs across,
+   *                      each hashing its own chunk before the results are
+   *                      merged. Zero or less uses one per hardware thread.
+   */
+  DYND_API array factorize(const array &values, array &out_categories, intptr_t thread_count = 1);
+
+} // namespace dynd::nd
 } // namespace dynd
@@ -7,15 +7,20 @@
 #include <dynd/array.hpp>
 #include <dynd/comparison.hpp>
 
+#include <memory>
+
 #include <dynd/access.hpp>
 #include <dynd/array_iter.hpp>
 #include <dynd/assignment.hpp>
+#include <dynd/callables/call_graph.hpp>
 #include <dynd/exceptions.hpp>
 #include <dynd/kernels/assignment_kernels.hpp>
 #include <dynd/kernels/field_access_kernel.hpp>
 #include <dynd/math.hpp>
 #include <dynd/memblock/memmap_memory_block.hpp>
 #include <dynd/option.hpp>
+#include <dynd/parallel.hpp>
+#include <dynd/type_promotion.hpp>
 #include <dynd/types/base_memory_type.hpp>
 #include <dynd/types/bytes_type.hpp>
 #include <dynd/types/categorical_type.hpp>
@@ -831,59 +836,627 @@ nd::array nd::empty_like(const nd::array &rhs) {
   }
 }
 
-nd::array nd::concatenate(const nd::array &x, const nd::array &y) {
-  if (x.get_ndim() != 1 || y.get_ndim() != 1) {
-    throw runtime_error("TODO: nd::concatenate is WIP");
+namespace {
+
+// The dtype of the result of concatenating or stacking arrays, which is
+// kept when they all agree
+ndt::type common_dtype(const vector<nd::array> &arrays) {
+  ndt::type dtp = arrays[0].get_dtype();
+  for (const nd::array &a : arrays) {
+    if (a.get_dtype() != dtp) {
+      dtp = promote_types_arithmetic(dtp, a.get_dtype());
+    }
+  }
+
+  return dtp;
+}
+
+// Assigns each of src to the corresponding view of the result in dst. All
+// the kernels are built first, so that only running them is spread across
+// threads.
+void assign_pieces(const vector<nd::array> &dst, const vector<nd::array> &src, intptr_t thread_count) {
+  nd::array error_mode = eval::default_eval_context.errmode;
+  vector<unique_ptr<nd::call_graph>> graphs;
+  vector<unique_ptr<nd::kernel_builder>> kernels;
+  for (size_t i = 0; i < src.size(); ++i) {
+    ndt::type src_tp = src[i].get_type();
+    const char *src_arrmeta = src[i]->metadata();
+
+    graphs.emplace_back(new nd::call_graph);
+    nd::assign->resolve(nullptr, nullptr, *graphs.back(), dst[i].get_type(), 1, &src_tp, 1, &error_mode,
+                        std::map<std::string, ndt::type>());
+    kernels.emplace_back(new nd::kernel_builder(graphs.back()->get()));
+    (*kernels.back())(kernel_request_single, nullptr, dst[i]->metadata(), 1, &src_arrmeta);
+  }
+
+  intptr_t piece_count = static_cast<intptr_t>(kernels.size());
+  auto run = [&](intptr_t first, intptr_t step) {
+    for (intptr_t i = first; i < piece_count; i += step) {
+      char *src_data = const_cast<char *>(src[i].cdata());
+      kernels[i]->get()->get_function<kernel_single_t>()(kernels[i]->get(), dst[i].data(), &src_data);
+    }
+  };
+
+  intptr_t threads_used = min(thread_count, piece_count);
+  if (threads_used <= 1) {
+    run(0, 1);
+    return;
+  }
+
+  // Each thread takes every threads_used-th piece
+  parallel_for(threads_used, threads_used, 1, [&](intptr_t begin, intptr_t end) {
+    for (intptr_t t = begin; t < end; ++t) {
+      run(t, threads_used);
+    }
+  });
+}
+
+// Checks that the arrays all have ``ndim`` dimensions with known sizes, and
+// the same ones as ``shape`` apart from ``axis``
+void check_pieces(const char *name, const vector<nd::array> &arrays, intptr_t ndim, const intptr_t *shape,
+                  intptr_t axis) {
+  dimvector piece_shape(ndim);
+  for (const nd::array &a : arrays) {
+    bool match = a.get_ndim() == ndim;
+    if (match) {
+      a.get_shape(piece_shape.get());
+      for (intptr_t i = 0; i < ndim; ++i) {
+        match = match && piece_shape[i] >= 0 && (i == axis || piece_shape[i] == shape[i]);
+      }
+    }
+
+    if (!match) {
+      stringstream ss;
+      ss << "cannot " << name << " arrays of types " << arrays[0].get_type() << " and " << a.get_type();
+      if (axis >= 0) {
+        ss << " along axis " << axis;
+      }
+      throw invalid_argument(ss.str());
+    }
+  }
+}
+
+} // anonymous namespace
+
+nd::array nd::concatenate(const nd::array &x, const nd::array &y) { return concatenate({x, y}); }
+
+nd::array nd::concatenate(const vector<array> &arrays, intptr_t axis, intptr_t thread_count) {
+  if (arrays.empty()) {
+    throw invalid_argument("concatenate requires at least one array");
+  }
+
+  intptr_t ndim = arrays[0].get_ndim();
+  if (axis < -ndim || axis >= ndim) {
+    stringstream ss;
+    ss << "concatenate axis " << axis << " is out of bounds for arrays of type " << arrays[0].get_type();
+    throw invalid_argument(ss.str());
+  }
+  if (axis < 0) {
+    axis += ndim;
+  }
+
+  dimvector shape(ndim);
+  arrays[0].get_shape(shape.get());
+  check_pieces("concatenate", arrays, ndim, shape.get(), axis);
+
+  vector<intptr_t> offset(1, 0);
+  for (const array &a : arrays) {
+    offset.push_back(offset.back() + a.get_dim_size(axis));
+  }
+  shape[axis] = offset.back();
+
+  array res = empty(ndt::make_type(ndim, shape.get(), common_dtype(arrays)));
+
+  vector<array> views;
+  vector<irange> index(ndim);
+  for (size_t i = 0; i < arrays.size(); ++i) {
+    index[axis] = irange(offset[i], offset[i + 1]);
+    views.push_back(res.at_array(ndim, index.data()));
+  }
+  assign_pieces(views, arrays, thread_count);
+
+  return res;
+}
+
+nd::array nd::stack(const vector<array> &arrays, intptr_t axis, intptr_t thread_count) {
+  if (arrays.empty()) {
+    throw invalid_argument("stack requires at least one array");
+  }
+
+  intptr_t ndim = arrays[0].get_ndim();
+  if (axis < -ndim - 1 || axis > ndim) {
+    stringstream ss;
+    ss << "stack axis " << axis << " is out of bounds for arrays of type " << arrays[0].get_type();
+    throw invalid_argument(ss.str());
+  }
+  if (axis < 0) {
+    axis += ndim + 1;
+  }
+
+  dimvector shape(ndim + 1);
+  arrays[0].get_shape(shape.get());
+  check_pieces("stack", arrays, ndim, shape.get(), -1);
+  for (intptr_t i = ndim; i > axis; --i) {
+    shape[i] = shape[i - 1];
+  }
+  shape[axis] = arrays.size();
+
+  array res = empty(ndt::make_type(ndim + 1, shape.get(), common_dtype(arrays)));
+
+  vector<array> views;
+  vector<irange> index(ndim + 1);
+  for (size_t i = 0; i < arrays.size(); ++i) {
+    index[axis] = irange(i);
+    views.push_back(res.at_array(ndim + 1, index.data()));
+  }
+  assign_pieces(views, arrays, thread_count);
+
+  return res;
+}
+
+namespace {
+
+// Computes the strides for viewing elements with shape old_shape and strides
+// old_strides as the shape new_shape in C order, returning false when no
+// strides can do that and the elements must be copied. Dimensions are
+// grouped so that each group of old dimensions has the same number of
+// elements as a group of new ones, and only the old dimensions within a
+// group need to be contiguous with each other.
+bool reshape_strides(intptr_t old_ndim, const intptr_t *old_shape, const intptr_t *old_strides, intptr_t ndim,
+                     const intptr_t *shape, intptr_t *strides, intptr_t element_size) {
+  // Dimensions of size one are never stepped along
+  vector<intptr_t> os, ost;
+  for (intptr_t i = 0; i < old_ndim; ++i) {
+    if (old_shape[i] != 1) {
+      os.push_back(old_shape[i]);
+      ost.push_back(old_strides[i]);
+    }
+  }
+
+  intptr_t oi = 0, oj = 1, ni = 0, nj = 1;
+  while (ni < ndim && oi < static_cast<intptr_t>(os.size())) {
+    intptr_t np = shape[ni], op = os[oi];
+    while (np != op) {
+      if (np < op) {
+        np *= shape[nj++];
+      } else {
+        op *= os[oj++];
+      }
+    }
+
+    for (intptr_t ok = oi; ok < oj - 1; ++ok) {
+      if (ost[ok] != os[ok + 1] * ost[ok + 1]) {
+        return false;
+      }
+    }
+
+    strides[nj - 1] = ost[oj - 1];
+    for (intptr_t nk = nj - 1; nk > ni; --nk) {
+      strides[nk - 1] = strides[nk] * shape[nk];
+    }
+
+    ni = nj++;
+    oi = oj++;
   }
 
-  if (x.get_dtype() != y.get_dtype()) {
-    throw runtime_error("dtypes must be the same for concatenate");
+  // Any remaining new dimensions have size one
+  for (intptr_t nk = ni; nk < ndim; ++nk) {
+    strides[nk] = element_size;
   }
 
-  nd::array res = nd::empty(x.get_dim_size() + y.get_dim_size(), x.get_dtype());
-  res(irange(0, x.get_dim_size())).assign(x);
-  res(irange(x.get_dim_size(), res.get_dim_size())).assign(y);
+  return true;
+}
+
+// The number of elements under any mix of fixed and var dimensions
+intptr_t count_elements(const ndt::type &tp, const char *arrmeta, const char *data) {
+  switch (tp.get_id()) {
+  case fixed_dim_id: {
+    const size_stride_t *ss = reinterpret_cast<const size_stride_t *>(arrmeta);
+    const ndt::type &el_tp = tp.extended<ndt::fixed_dim_type>()->get_element_type();
+    if (el_tp.get_ndim() == 0) {
+      return ss->dim_size;
+    }
+    intptr_t count = 0;
+    for (intptr_t i = 0; i < ss->dim_size; ++i) {
+      count += count_elements(el_tp, arrmeta + sizeof(size_stride_t), data + i * ss->stride);
+    }
+    return count;
+  }
+  case var_dim_id: {
+    const ndt::var_dim_type::metadata_type *md = reinterpret_cast<const ndt::var_dim_type::metadata_type *>(arrmeta);
+    const ndt::var_dim_type::data_type *d = reinterpret_cast<const ndt::var_dim_type::data_type *>(data);
+    const ndt::type &el_tp = tp.extended<ndt::var_dim_type>()->get_element_type();
+    if (el_tp.get_ndim() == 0) {
+      return d->size;
+    }
+    intptr_t count = 0;
+    for (size_t i = 0; i < d->size; ++i) {
+      count += count_elements(el_tp, arrmeta + sizeof(ndt::var_dim_type::metadata_type),
+                              d->begin + md->offset + i * md->stride);
+    }
+    return count;
+  }
+  default:
+    return 1;
+  }
+}
+
+// Copies the POD elements under any mix of fixed and var dimensions into dst
+// in C order, returning the position after the last one
+char *flatten(const ndt::type &tp, const char *arrmeta, const char *data, char *dst) {
+  switch (tp.get_id()) {
+  case fixed_dim_id: {
+    const size_stride_t *ss = reinterpret_cast<const size_stride_t *>(arrmeta);
+    const ndt::type &el_tp = tp.extended<ndt::fixed_dim_type>()->get_element_type();
+    if (el_tp.get_ndim() == 0 && ss->stride == static_cast<intptr_t>(el_tp.get_data_size())) {
+      memcpy(dst, data, ss->dim_size * el_tp.get_data_size());
+      return dst + ss->dim_size * el_tp.get_data_size();
+    }
+    for (intptr_t i = 0; i < ss->dim_size; ++i) {
+      dst = flatten(el_tp, arrmeta + sizeof(size_stride_t), data + i * ss->stride, dst);
+    }
+    return dst;
+  }
+  case var_dim_id: {
+    const ndt::var_dim_type::metadata_type *md = reinterpret_cast<const ndt::var_dim_type::metadata_type *>(arrmeta);
+    const ndt::var_dim_type::data_type *d = reinterpret_cast<const ndt::var_dim_type::data_type *>(data);
+    const ndt::type &el_tp = tp.extended<ndt::var_dim_type>()->get_element_type();
+    const char *begin = d->begin + md->offset;
+    if (el_tp.get_ndim() == 0 && md->stride == static_cast<intptr_t>(el_tp.get_data_size())) {
+      memcpy(dst, begin, d->size * el_tp.get_data_size());
+      return dst + d->size * el_tp.get_data_size();
+    }
+    for (size_t i = 0; i < d->size; ++i) {
+      dst = flatten(el_tp, arrmeta + sizeof(ndt::var_dim_type::metadata_type), begin + i * md->stride, dst);
+    }
+    return dst;
+  }
+  default:
+    memcpy(dst, data, tp.get_data_size());
+    return dst + tp.get_data_size();
+  }
+}
+
+// Views the data of a, whose dtype arrmeta is at dtype_arrmeta, with the given shape and strides
+nd::array make_reshaped_view(const nd::array &a, const char *dtype_arrmeta, intptr_t ndim, const intptr_t *shape,
+                             const intptr_t *strides) {
+  const ndt::type &dtp = a.get_dtype();
+  char *res_dtype_arrmeta = NULL;
+  nd::array res = nd::make_strided_array_from_data(dtp, ndim, shape, strides, a.get_flags(),
+                                                   const_cast<char *>(a.cdata()), a, &res_dtype_arrmeta);
+  if (dtp.get_arrmeta_size() > 0) {
+    dtp.extended()->arrmeta_copy_construct(res_dtype_arrmeta, dtype_arrmeta, nd::memory_block());
+  }
 
   return res;
 }
 
+} // anonymous namespace
+
 nd::array nd::reshape(const nd::array &a, const nd::array &shape) {
   intptr_t ndim = shape.get_dim_size();
+  dimvector new_shape(ndim);
+  intptr_t inferred = -1, known_size = 1;
+  for (intptr_t i = 0; i < ndim; ++i) {
+    new_shape[i] = shape(i).as<intptr_t>();
+    if (new_shape[i] == -1 && inferred == -1) {
+      inferred = i;
+    } else if (new_shape[i] < 0) {
+      stringstream ss;
+      ss << "dynd reshape: invalid shape " << shape << ", only one dimension can be -1 and the rest must be sizes";
+      throw invalid_argument(ss.str());
+    } else {
+      known_size *= new_shape[i];
+    }
+  }
 
+  const ndt::type &dtp = a.get_dtype();
   intptr_t old_ndim = a.get_ndim();
-  dimvector old_shape(old_ndim);
-  a.get_shape(old_shape.get());
+  bool strided = a.get_type().get_strided_ndim() == old_ndim;
 
+  dimvector old_shape(old_ndim), old_strides(old_ndim);
   intptr_t old_size = 1;
-  for (intptr_t i = 0; i < old_ndim; ++i) {
-    old_size *= old_shape[i];
+  if (strided) {
+    a.get_shape(old_shape.get());
+    a.get_strides(old_strides.get());
+    for (intptr_t i = 0; i < old_ndim; ++i) {
+      old_size *= old_shape[i];
+    }
+  } else {
+    old_size = count_elements(a.get_type(), a->metadata(), a.cdata());
   }
-  intptr_t size = 1;
-  for (intptr_t i = 0; i < ndim; ++i) {
-    size *= shape(i).as<intptr_t>();
+
+  if (inferred >= 0) {
+    if (known_size == 0 || old_size % known_size != 0) {
+      stringstream ss;
+      ss << "dynd reshape: cannot infer the missing dimension of " << shape << " for " << old_size << " elements";
+      throw invalid_argument(ss.str());
+    }
+    new_shape[inferred] = old_size / known_size;
+    known_size = old_size;
   }
 
-  if (old_size != size) {
+  if (old_size != known_size) {
     stringstream ss;
     ss << "dynd reshape: cannot reshape to a different total number of "
           "elements, from "
-       << old_size << " to " << size;
+       << old_size << " to " << known_size;
     throw invalid_argument(ss.str());
   }
 
   dimvector strides(ndim);
-  strides[ndim - 1] = a.get_dtype().get_data_size();
-  for (intptr_t i = ndim - 2; i >= 0; --i) {
-    strides[i] = shape(i + 1).as<intptr_t>() * strides[i + 1];
+  if (strided && (old_size == 0 || reshape_strides(old_ndim, old_shape.get(), old_strides.get(), ndim,
+                                                   new_shape.get(), strides.get(), dtp.get_data_size()))) {
+    if (old_size == 0) {
+      fill(strides.get(), strides.get() + ndim, 0);
+    }
+    return make_reshaped_view(a, a->metadata() + old_ndim * sizeof(size_stride_t), ndim, new_shape.get(),
+                              strides.get());
   }
 
-  dimvector shape_copy(ndim);
+  // Otherwise the elements are copied once into C order, which is always a view
+  array tmp;
+  if (strided) {
+    tmp = empty(ndt::make_type(old_ndim, old_shape.get(), dtp));
+    tmp.assign(a);
+  } else {
+    if (!dtp.is_pod() || dtp.get_arrmeta_size() != 0) {
+      stringstream ss;
+      ss << "dynd reshape: cannot flatten the dimensions of " << a.get_type() << ", which requires a POD dtype";
+      throw type_error(ss.str());
+    }
+    tmp = empty(old_size, dtp);
+    flatten(a.get_type(), a->metadata(), a.cdata(), tmp.data());
+  }
+
+  if (ndim > 0) {
+    strides[ndim - 1] = dtp.get_data_size();
+    for (intptr_t i = ndim - 2; i >= 0; --i) {
+      strides[i] = new_shape[i + 1] * strides[i + 1];
+    }
+  }
+
+  return make_reshaped_view(tmp, tmp->metadata() + tmp.get_ndim() * sizeof(size_stride_t), ndim, new_shape.get(),
+                            strides.get());
+}
+
+nd::array nd::to_columnar(const nd::array &a) {
+  intptr_t ndim = a.get_ndim();
+
+  ndt::type dtp = a.get_type();
   for (intptr_t i = 0; i < ndim; ++i) {
-    shape_copy[i] = shape(i).as<intptr_t>();
+    if (dtp.get_id() != fixed_dim_id) {
+      stringstream ss;
+      ss << "dynd to_columnar: expected only fixed dimensions, got " << a.get_type();
+      throw type_error(ss.str());
+    }
+    dtp = dtp.extended<ndt::fixed_dim_type>()->get_element_type();
+  }
+  if (dtp.get_id() != struct_id) {
+    stringstream ss;
+    ss << "dynd to_columnar: expected an array of structs, got " << a.get_type();
+    throw type_error(ss.str());
   }
 
-  return make_strided_array_from_data(a.get_dtype(), ndim, shape_copy.get(), strides.get(), a.get_flags(), a.data(), a,
-                                      NULL);
+  dimvector shape(ndim);
+  a.get_shape(shape.get());
+
+  const std::vector<std::string> &names = dtp.extended<ndt::struct_type>()->get_field_names();
+  std::vector<ndt::type> types(names.size());
+  for (size_t i = 0; i < names.size(); ++i) {
+    types[i] = ndt::make_type(ndim, shape.get(), dtp.extended<ndt::struct_type>()->get_field_type(i));
+  }
+
+  array res = empty(ndt::make_type<ndt::struct_type>(names, types));
+  shortvector<irange> idx(ndim + 1);
+  for (size_t i = 0; i < names.size(); ++i) {
+    idx[ndim] = irange(i);
+    res(i).assign(a.at_array(ndim + 1, idx.get()));
+  }
+
+  return res;
+}
+
+nd::array nd::from_columnar(const nd::array &a, intptr_t ndim) {
+  if (a.get_type().get_id() != struct_id) {
+    stringstream ss;
+    ss << "dynd from_columnar: expected a struct of arrays, got " << a.get_type();
+    throw type_error(ss.str());
+  }
+
+  const std::vector<std::string> &names = a.get_type().extended<ndt::struct_type>()->get_field_names();
+  intptr_t field_count = names.size();
+  std::vector<ndt::type> types(field_count);
+  dimvector shape(ndim);
+  for (intptr_t i = 0; i < field_count; ++i) {
+    array field = a(i);
+    if (field.get_ndim() < ndim) {
+      stringstream ss;
+      ss << "dynd from_columnar: field \"" << names[i] << "\" of type " << field.get_type() << " has fewer than "
+         << ndim << " dimensions";
+      throw invalid_argument(ss.str());
+    }
+
+    dimvector field_shape(field.get_ndim());
+    field.get_shape(field_shape.get());
+    if (i == 0) {
+      std::copy(field_shape.get(), field_shape.get() + ndim, shape.get());
+    } else if (!std::equal(shape.get(), shape.get() + ndim, field_shape.get())) {
+      stringstream ss;
+      ss << "dynd from_columnar: field \"" << names[i] << "\" does not have the same leading dimensions as field \""
+         << names[0] << "\"";
+      throw invalid_argument(ss.str());
+    }
+    types[i] = field.get_type().get_type_at_dimension(NULL, ndim);
+  }
+
+  array res = empty(ndt::make_type(ndim, shape.get(), ndt::make_type<ndt::struct_type>(names, types)));
+  shortvector<irange> idx(ndim + 1);
+  for (intptr_t i = 0; i < field_count; ++i) {
+    idx[ndim] = irange(i);
+    res.at_array(ndim + 1, idx.get()).assign(a(i));
+  }
+
+  return res;
+}
+
+void nd::compact_var_dim(const nd::array &a) {
+  ndt::type tp = a.get_type();
+  const char *arrmeta = a.get()->metadata();
+  intptr_t count = 1;
+  std::vector<std::pair<intptr_t, intptr_t>> fixed_dims;
+  while (tp.get_id() == fixed_dim_id) {
+    const fixed_dim_type_arrmeta *md = reinterpret_cast<const fixed_dim_type_arrmeta *>(arrmeta);
+    fixed_dims.push_back(std::make_pair(md->dim_size, md->stride));
+    count *= md->dim_size;
+    tp = tp.extended<ndt::fixed_dim_type>()->get_element_type();
+    arrmeta += sizeof(fixed_dim_type_arrmeta);
+  }
+  if (tp.get_id() != var_dim_id) {
+    stringstream ss;
+    ss << "dynd compact_var_dim: expected fixed dimensions followed by a var dimension, got " << a.get_type();
+    throw type_error(ss.str());
+  }
+
+  const ndt::var_dim_type::metadata_type *md = reinterpret_cast<const ndt::var_dim_type::metadata_type *>(arrmeta);
+  if (!md->blockref.unique()) {
+    stringstream ss;
+    ss << "dynd compact_var_dim: the var dimension memory block of " << a.get_type()
+       << " is shared with another array, which would be left pointing at the old memory";
+    throw invalid_argument(ss.str());
+  }
+
+  // Gather the begin pointer of every var dimension element, in row-major order
+  std::vector<char **> pointers(count);
+  std::vector<intptr_t> index(fixed_dims.size(), 0);
+  char *data = a.data();
+  for (intptr_t i = 0; i < count; ++i) {
+    char *elem = data;
+    for (size_t j = 0; j < fixed_dims.size(); ++j) {
+      elem += index[j] * fixed_dims[j].second;
+    }
+    pointers[i] = &reinterpret_cast<ndt::var_dim_type::data_type *>(elem)->begin;
+    for (intptr_t j = fixed_dims.size() - 1; j >= 0 && ++index[j] == fixed_dims[j].first; --j) {
+      index[j] = 0;
+    }
+  }
+
+  md->blockref->compact(count, pointers.data());
+}
+
+nd::array nd::to_ragged(const nd::array &a) {
+  const ndt::type &tp = a.get_type();
+  if (tp.get_id() != fixed_dim_id || tp.extended<ndt::fixed_dim_type>()->get_element_type().get_id() != var_dim_id) {
+    stringstream ss;
+    ss << "dynd to_ragged: expected an array of type N * var * T, got " << tp;
+    throw type_error(ss.str());
+  }
+
+  const ndt::type &var_tp = tp.extended<ndt::fixed_dim_type>()->get_element_type();
+  const ndt::type &el_tp = var_tp.extended<ndt::var_dim_type>()->get_element_type();
+  const fixed_dim_type_arrmeta *src_md = reinterpret_cast<const fixed_dim_type_arrmeta *>(a.get()->metadata());
+  const ndt::var_dim_type::metadata_type *src_var_md =
+      reinterpret_cast<const ndt::var_dim_type::metadata_type *>(a.get()->metadata() + sizeof(fixed_dim_type_arrmeta));
+
+  intptr_t size = src_md->dim_size;
+  std::vector<int64_t> offsets(size + 1);
+  offsets[0] = 0;
+  for (intptr_t i = 0; i < size; ++i) {
+    offsets[i + 1] =
+        offsets[i] + reinterpret_cast<const ndt::var_dim_type::data_type *>(a.cdata() + i * src_md->stride)->size;
+  }
+
+  std::vector<std::string> names = {"values", "offsets"};
+  std::vector<ndt::type> types = {ndt::make_fixed_dim(offsets[size], el_tp),
+                                  ndt::make_fixed_dim(size + 1, ndt::make_type<int64_t>())};
+  array res = empty(ndt::make_type<ndt::struct_type>(names, types));
+
+  array values = res(0);
+  intptr_t dst_stride = reinterpret_cast<const fixed_dim_type_arrmeta *>(values.get()->metadata())->stride;
+  if (el_tp.is_pod() && src_var_md->stride == dst_stride) {
+    // Each row is contiguous, so it is copied in one go
+    for (intptr_t i = 0; i < size; ++i) {
+      const ndt::var_dim_type::data_type *row =
+          reinterpret_cast<const ndt::var_dim_type::data_type *>(a.cdata() + i * src_md->stride);
+      memcpy(values.data() + offsets[i] * dst_stride, row->begin + src_var_md->offset, row->size * dst_stride);
+    }
+  } else {
+    for (intptr_t i = 0; i < size; ++i) {
+      values(irange(offsets[i], offsets[i + 1])).assign(a(i));
+    }
+  }
+
+  array res_offsets = res(1);
+  intptr_t offsets_stride = reinterpret_cast<const fixed_dim_type_arrmeta *>(res_offsets.get()->metadata())->stride;
+  for (intptr_t i = 0; i <= size; ++i) {
+    *reinterpret_cast<int64_t *>(res_offsets.data() + i * offsets_stride) = offsets[i];
+  }
+
+  return res;
+}
+
+nd::array nd::from_ragged(const nd::array &a) {
+  const ndt::type &tp = a.get_type();
+  intptr_t values_index = -1, offsets_index = -1;
+  if (tp.get_id() == struct_id) {
+    values_index = tp.extended<ndt::struct_type>()->get_field_index("values");
+    offsets_index = tp.extended<ndt::struct_type>()->get_field_index("offsets");
+  }
+  if (values_index < 0 || offsets_index < 0 || a(values_index).get_type().get_id() != fixed_dim_id ||
+      a(offsets_index).get_type() != ndt::make_fixed_dim(a(offsets_index).get_dim_size(), ndt::make_type<int64_t>())) {
+    stringstream ss;
+    ss << "dynd from_ragged: expected a struct of type {values: M * T, offsets: N+1 * int64}, got " << tp;
+    throw type_error(ss.str());
+  }
+
+  array values = a(values_index), offsets = a(offsets_index);
+  const fixed_dim_type_arrmeta *values_md = reinterpret_cast<const fixed_dim_type_arrmeta *>(values.get()->metadata());
+  const fixed_dim_type_arrmeta *offsets_md =
+      reinterpret_cast<const fixed_dim_type_arrmeta *>(offsets.get()->metadata());
+  intptr_t size = offsets_md->dim_size - 1;
+  if (size < 0) {
+    throw invalid_argument("dynd from_ragged: the offsets must have at least one element");
+  }
+  int64_t previous = 0;
+  for (intptr_t i = 0; i <= size; ++i) {
+    int64_t offset = *reinterpret_cast<const int64_t *>(offsets.cdata() + i * offsets_md->stride);
+    if (offset < previous || offset > values_md->dim_size) {
+      stringstream ss;
+      ss << "dynd from_ragged: offset " << offset << " at index " << i
+         << " is not in order within the range of the values";
+      throw invalid_argument(ss.str());
+    }
+    previous = offset;
+  }
+
+  const ndt::type &el_tp = values.get_type().extended<ndt::fixed_dim_type>()->get_element_type();
+  array res = make_array(ndt::make_fixed_dim(size, ndt::make_type<ndt::var_dim_type>(el_tp)), a.get_flags());
+
+  // The rows point straight into the values, which the var dimension keeps alive
+  fixed_dim_type_arrmeta *res_md = reinterpret_cast<fixed_dim_type_arrmeta *>(res.get()->metadata());
+  res_md->dim_size = size;
+  res_md->stride = sizeof(ndt::var_dim_type::data_type);
+  ndt::var_dim_type::metadata_type *res_var_md = new (res.get()->metadata() + sizeof(fixed_dim_type_arrmeta))
+      ndt::var_dim_type::metadata_type();
+  res_var_md->blockref = values.get_data_memblock();
+  res_var_md->stride = values_md->stride;
+  res_var_md->offset = 0;
+  if (!el_tp.is_builtin()) {
+    el_tp.extended()->arrmeta_copy_construct(reinterpret_cast<char *>(res_var_md + 1),
+                                             values.get()->metadata() + sizeof(fixed_dim_type_arrmeta),
+                                             res_var_md->blockref);
+  }
+
+  for (intptr_t i = 0; i < size; ++i) {
+    int64_t begin = *reinterpret_cast<const int64_t *>(offsets.cdata() + i * offsets_md->stride);
+    int64_t end = *reinterpret_cast<const int64_t *>(offsets.cdata() + (i + 1) * offsets_md->stride);
+    ndt::var_dim_type::data_type *row =
+        reinterpret_cast<ndt::var_dim_type::data_type *>(const_cast<char *>(res.cdata()) + i * res_md->stride);
+    row->begin = const_cast<char *>(values.cdata()) + begin * values_md->stride;
+    row->size = end - begin;
+  }
+
+  return res;
 }
 
 nd::array nd::memmap(const std::string &DYND_UNUSED(filename), intptr_t DYND_UNUSED(begin), intptr_t DYND_UNUSED(end),
@@ -7,9 +7,12 @@
 #include <dynd/callables/assign_callable.hpp>
 #include <dynd/callables/copy_callable.hpp>
 #include <dynd/callables/multidispatch_callable.hpp>
+#include <dynd/callables/permuted_copy_callable.hpp>
 #include <dynd/functional.hpp>
 #include <dynd/kernels/assignment_kernels.hpp>
 #include <dynd/types/any_kind_type.hpp>
+#include <dynd/types/dim_kind_type.hpp>
+#include <dynd/types/expr_kind_type.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -38,6 +41,10 @@ nd::callable make_assign() {
   auto dispatcher =
       nd::callable::make_all<_bind<assign_error_mode, nd::assign_callable>::type, numeric_types, numeric_types>(
           func_ptr);
+  dispatcher.insert(nd::make_callable<nd::assign_callable<float16, float>>());
+  dispatcher.insert(nd::make_callable<nd::assign_callable<float16, double>>());
+  dispatcher.insert(nd::make_callable<nd::assign_callable<float, float16>>());
+  dispatcher.insert(nd::make_callable<nd::assign_callable<double, float16>>());
   dispatcher.insert(nd::make_callable<nd::assign_callable<dynd::string, dynd::string>>());
   dispatcher.insert(nd::make_callable<nd::assign_callable<dynd::bytes, dynd::bytes>>());
   dispatcher.insert(nd::make_callable<nd::assign_callable<ndt::fixed_bytes_type, ndt::fixed_bytes_type>>());
@@ -45,10 +52,15 @@ nd::callable make_assign() {
   dispatcher.insert(nd::make_callable<nd::assign_callable<ndt::fixed_string_type, ndt::fixed_string_type>>());
   dispatcher.insert(nd::make_callable<nd::assign_callable<ndt::char_type, dynd::string>>());
 
-  //  dispatcher.insert(
-  //    {{{adapt_id, ndt::make_type<ndt::any_kind_type>()}, nd::make_callable<nd::adapt_assign_to_callable>()},
-  //   {{ndt::make_type<ndt::any_kind_type>(), adapt_id}, nd::make_callable<nd::adapt_assign_from_callable>()},
-  // {{adapt_id, adapt_id}, nd::make_callable<nd::adapt_assign_from_callable>()}});
+  dispatcher.insert({nd::make_callable<nd::adapt_assign_to_callable>(),
+                     nd::make_callable<nd::adapt_assign_to_callable>(ndt::type("?Any")),
+                     nd::make_callable<nd::adapt_assign_from_callable>(),
+                     nd::make_callable<nd::adapt_assign_from_callable>(ndt::type("?Any")),
+                     nd::make_callable<nd::adapt_assign_from_callable>(ndt::make_type<ndt::expr_kind_type>()),
+                     nd::get_elwise(ndt::make_type<ndt::callable_type>(ndt::make_type<ndt::dim_kind_type>(),
+                                                                       {ndt::make_type<ndt::expr_kind_type>()})),
+                     nd::get_elwise(ndt::make_type<ndt::callable_type>(ndt::make_type<ndt::expr_kind_type>(),
+                                                                       {ndt::make_type<ndt::dim_kind_type>()}))});
   dispatcher.insert(nd::make_callable<nd::assign_callable<ndt::fixed_string_type, ndt::fixed_string_type>>());
   dispatcher.insert(nd::make_callable<nd::assign_callable<dynd::string, ndt::char_type>>());
   dispatcher.insert(nd::make_callable<nd::assign_callable<ndt::type, ndt::type>>());
@@ -100,8 +112,12 @@ nd::callable make_assign() {
   dispatcher.insert(nd::make_callable<nd::assign_callable<double, dynd::string>>());
   dispatcher.insert(nd::make_callable<nd::assign_callable<ndt::tuple_type, ndt::tuple_type>>());
   dispatcher.insert(nd::make_callable<nd::assign_callable<ndt::struct_type, ndt::struct_type>>());
+  dispatcher.insert(nd::make_callable<nd::assign_callable<ndt::categorical_type, dynd::string>>());
+  dispatcher.insert(nd::make_callable<nd::assign_callable<ndt::categorical_type, ndt::int_kind_type>>());
+  dispatcher.insert(nd::make_callable<nd::assign_callable<ndt::categorical_type, ndt::uint_kind_type>>());
+  dispatcher.insert(nd::make_callable<nd::assign_callable<ndt::categorical_type, ndt::float_kind_type>>());
   dispatcher.insert({nd::get_elwise(ndt::type("(Dim) -> Scalar")), nd::get_elwise(ndt::type("(Scalar) -> Dim")),
-                     nd::get_elwise(ndt::type("(Dim) -> Dim"))});
+                     nd::make_callable<nd::permuted_copy_callable>(1, nd::get_elwise(ndt::type("(Dim) -> Dim")))});
 
   return nd::make_callable<nd::multidispatch_callable<2>>(self_tp, dispatcher);
 }
@@ -111,3 +127,11 @@ nd::callable make_assign() {
 DYND_API nd::callable nd::assign = make_assign();
 
 DYND_API nd::callable nd::copy = nd::make_callable<nd::copy_callable>();
+
+nd::callable nd::parallel_copy(intptr_t thread_count) {
+  if (thread_count < 1) {
+    throw invalid_argument("parallel_copy requires a positive thread count");
+  }
+
+  return make_callable<copy_callable>(make_callable<permuted_copy_callable>(thread_count, assign));
+}
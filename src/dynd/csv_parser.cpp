@@ -0,0 +1,375 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include <dynd/csv_parser.hpp>
+#include <dynd/parallel.hpp>
+#include <dynd/types/fixed_dim_type.hpp>
+#include <dynd/types/option_type.hpp>
+#include <dynd/types/string_type.hpp>
+#include <dynd/types/struct_type.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+
+/**
+ * Returns a word with the high bit set in each byte of ``word`` equal to ``c``.
+ * Bytes above the first match may also be flagged, so this is only usable as a
+ * test for whether any byte matches.
+ */
+inline uint64_t match_byte(uint64_t word, char c)
+{
+  uint64_t x = word ^ (0x0101010101010101ULL * static_cast<unsigned char>(c));
+  return (x - 0x0101010101010101ULL) & ~x & 0x8080808080808080ULL;
+}
+
+/**
+ * Returns a pointer to the first of ``a``, ``b`` or ``c`` in [begin, end), or
+ * ``end`` if there is none, skipping over eight bytes at a time.
+ */
+inline const char *find_special(const char *begin, const char *end, char a, char b, char c)
+{
+  while (end - begin >= 8) {
+    uint64_t word;
+    memcpy(&word, begin, 8);
+    if (match_byte(word, a) | match_byte(word, b) | match_byte(word, c)) {
+      break;
+    }
+    begin += 8;
+  }
+  while (begin != end && *begin != a && *begin != b && *begin != c) {
+    ++begin;
+  }
+  return begin;
+}
+
+inline bool is_blank(const char *begin, const char *end)
+{
+  return begin == end || (end - begin == 1 && *begin == '\r');
+}
+
+/**
+ * Appends the start of each non-blank record in [begin, end) to ``rows``, taking
+ * quoted newlines into account. Returns the position just past the last record
+ * terminator. If ``final`` is set, the text after that is a record too.
+ */
+const char *index_rows(const char *begin, const char *end, char quote, bool final, std::vector<const char *> &rows)
+{
+  const char *row = begin;
+  bool quoted = false;
+  for (const char *p = begin;; ++p) {
+    p = quoted ? find_special(p, end, quote, quote, quote) : find_special(p, end, quote, '\n', '\n');
+    if (p == end) {
+      break;
+    }
+    if (*p == quote) {
+      quoted = !quoted;
+    }
+    else {
+      if (!is_blank(row, p)) {
+        rows.push_back(row);
+      }
+      row = p + 1;
+    }
+  }
+
+  if (final && !is_blank(row, end)) {
+    rows.push_back(row);
+    return end;
+  }
+  return row;
+}
+
+struct csv_column {
+  std::string name;
+  type_id_t id;
+  bool option;
+  char *data;
+  intptr_t stride;
+};
+
+void parse_field(const csv_column &col, char *dst, const char *begin, const char *end)
+{
+  if (col.option && begin == end) {
+    if (col.id == string_id) {
+      reinterpret_cast<dynd::string *>(dst)->clear();
+    }
+    else {
+      assign_na_builtin(col.id, dst);
+    }
+    return;
+  }
+
+  switch (col.id) {
+  case bool_id:
+    *reinterpret_cast<bool1 *>(dst) = parse<bool>(begin, end);
+    break;
+  case string_id:
+    reinterpret_cast<dynd::string *>(dst)->assign(begin, end - begin);
+    break;
+  default:
+    string_to_number(dst, col.id, begin, end, eval::default_eval_context.errmode);
+    break;
+  }
+}
+
+class csv_reader {
+  std::vector<csv_column> m_columns;
+  ndt::type m_tp;
+  nd::csv::options m_opts;
+
+  /**
+   * Parses the record starting at ``p`` into row ``i`` of the columns.
+   */
+  void parse_record(const char *p, const char *end, intptr_t i, intptr_t record, std::string &scratch) const
+  {
+    char delimiter = m_opts.delimiter, quote = m_opts.quote;
+    size_t count = m_columns.size();
+    for (size_t j = 0; j < count; ++j) {
+      const csv_column &col = m_columns[j];
+      const char *begin, *fend, *field_start = p;
+      if (p != end && *p == quote) {
+        bool escaped = false;
+        begin = ++p;
+        for (;;) {
+          p = find_special(p, end, quote, quote, quote);
+          if (p == end) {
+            throw csv_parse_error(field_start, record, "unterminated quoted field");
+          }
+          if (end - p > 1 && p[1] == quote) {
+            escaped = true;
+            p += 2;
+            continue;
+          }
+          break;
+        }
+        fend = p++;
+        if (p != end && *p == '\r') {
+          ++p;
+        }
+        if (escaped) {
+          scratch.clear();
+          for (const char *q = begin; q != fend; ++q) {
+            scratch.push_back(*q);
+            if (*q == quote) {
+              ++q;
+            }
+          }
+          begin = scratch.data();
+          fend = begin + scratch.size();
+        }
+      }
+      else {
+        begin = p;
+        p = find_special(p, end, delimiter, '\n', '\n');
+        fend = p;
+        if (fend != begin && fend[-1] == '\r' && (p == end || *p == '\n')) {
+          --fend;
+        }
+      }
+
+      if (j + 1 < count) {
+        if (p == end || *p != delimiter) {
+          stringstream ss;
+          ss << "expected " << count << " fields, got " << (j + 1);
+          throw csv_parse_error(p, record, ss.str());
+        }
+        ++p;
+      }
+      else if (p != end && *p != '\n') {
+        stringstream ss;
+        ss << "expected " << count << " fields, got more";
+        throw csv_parse_error(p, record, ss.str());
+      }
+
+      try {
+        parse_field(col, col.data + i * col.stride, begin, fend);
+      }
+      catch (const csv_parse_error &) {
+        throw;
+      }
+      catch (const std::exception &e) {
+        throw csv_parse_error(field_start, record, "field \"" + col.name + "\": " + e.what());
+      }
+      catch (const dynd_exception &e) {
+        throw csv_parse_error(field_start, record, "field \"" + col.name + "\": " + e.what());
+      }
+    }
+  }
+
+  void parse_records(const std::vector<const char *> &rows, const char *end, size_t first, size_t last,
+                     intptr_t record_offset) const
+  {
+    std::string scratch;
+    for (size_t i = first; i < last; ++i) {
+      const char *row_end = (i + 1 < rows.size()) ? rows[i + 1] : end;
+      parse_record(rows[i], row_end, i, record_offset + i, scratch);
+    }
+  }
+
+public:
+  csv_reader(const ndt::type &tp, const nd::csv::options &opts) : m_tp(tp), m_opts(opts)
+  {
+    if (tp.get_id() != struct_id) {
+      stringstream ss;
+      ss << "dynd csv: expected a struct type for the records, got " << tp;
+      throw type_error(ss.str());
+    }
+    if (m_opts.delimiter == m_opts.quote || m_opts.delimiter == '\n' || m_opts.quote == '\n') {
+      throw invalid_argument("dynd csv: the delimiter, quote and newline characters must differ");
+    }
+
+    const ndt::struct_type *st = tp.extended<ndt::struct_type>();
+    for (intptr_t i = 0; i < st->get_field_count(); ++i) {
+      ndt::type ft = st->get_field_type(i);
+      bool option = ft.get_id() == option_id;
+      if (option) {
+        ft = ft.extended<ndt::option_type>()->get_value_type();
+      }
+
+      bool supported;
+      switch (ft.get_id()) {
+      case bool_id:
+      case int8_id:
+      case int16_id:
+      case int32_id:
+      case int64_id:
+      case int128_id:
+      case float32_id:
+      case float64_id:
+      case string_id:
+        supported = true;
+        break;
+      case uint8_id:
+      case uint16_id:
+      case uint32_id:
+      case uint64_id:
+      case uint128_id:
+        // There is no NA value for the unsigned integers
+        supported = !option;
+        break;
+      default:
+        supported = false;
+        break;
+      }
+      if (!supported) {
+        stringstream ss;
+        ss << "dynd csv: unsupported type " << st->get_field_type(i) << " for field \"" << st->get_field_name(i)
+           << "\"";
+        throw type_error(ss.str());
+      }
+
+      m_columns.push_back({st->get_field_name(i), ft.get_id(), option, nullptr, 0});
+    }
+  }
+
+  /**
+   * Parses the records starting at ``rows[first]`` into a new array.
+   */
+  nd::array parse(const std::vector<const char *> &rows, const char *end, size_t first, intptr_t record_offset)
+  {
+    intptr_t n = rows.size() - first;
+    std::vector<const char *> data_rows(rows.begin() + first, rows.end());
+
+    nd::array res;
+    std::vector<nd::array> cols(m_columns.size());
+    const ndt::struct_type *st = m_tp.extended<ndt::struct_type>();
+    if (m_opts.columnar) {
+      std::vector<ndt::type> types(m_columns.size());
+      for (size_t j = 0; j < m_columns.size(); ++j) {
+        types[j] = ndt::make_type(1, &n, st->get_field_type(j));
+      }
+      res = nd::empty(ndt::make_type<ndt::struct_type>(st->get_field_names(), types));
+      for (size_t j = 0; j < m_columns.size(); ++j) {
+        cols[j] = res(j);
+      }
+    }
+    else {
+      res = nd::empty(n, m_tp);
+      for (size_t j = 0; j < m_columns.size(); ++j) {
+        cols[j] = res(irange(), j);
+      }
+    }
+    for (size_t j = 0; j < m_columns.size(); ++j) {
+      m_columns[j].data = cols[j].data();
+      m_columns[j].stride = reinterpret_cast<const fixed_dim_type_arrmeta *>(cols[j]->metadata())->stride;
+    }
+
+    // Below 1024 rows per thread, threads cost more than they save
+    parallel_for(n, m_opts.thread_count, 1024, [&](intptr_t first_row, intptr_t last_row) {
+      parse_records(data_rows, end, first_row, last_row, record_offset);
+    });
+
+    return res;
+  }
+};
+
+} // anonymous namespace
+
+nd::array nd::csv::parse(const char *begin, const char *end, const ndt::type &tp, const options &opts)
+{
+  csv_reader reader(tp, opts);
+
+  std::vector<const char *> rows;
+  index_rows(begin, end, opts.quote, true, rows);
+  size_t first = (opts.header && !rows.empty()) ? 1 : 0;
+
+  return reader.parse(rows, end, first, first + 1);
+}
+
+nd::array nd::csv::read(const std::string &filename, const ndt::type &tp, const options &opts)
+{
+  std::ifstream f(filename.c_str(), std::ios::in | std::ios::binary);
+  if (!f.good()) {
+    stringstream ss;
+    ss << "dynd csv: error opening file " << filename;
+    throw runtime_error(ss.str());
+  }
+
+  std::string str((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+  return parse(str, tp, opts);
+}
+
+void nd::csv::read(std::istream &in, const ndt::type &tp, const std::function<void(const array &)> &callback,
+                   const options &opts)
+{
+  csv_reader reader(tp, opts);
+
+  std::vector<char> buffer(std::max<size_t>(opts.buffer_size, 1));
+  std::vector<const char *> rows;
+  size_t size = 0;
+  intptr_t record = 1;
+  bool header = opts.header, eof = false;
+  while (!eof) {
+    in.read(buffer.data() + size, buffer.size() - size);
+    size += in.gcount();
+    eof = !in;
+
+    const char *begin = buffer.data(), *end = begin + size;
+    rows.clear();
+    const char *stop = index_rows(begin, end, opts.quote, eof, rows);
+    if (!rows.empty()) {
+      size_t first = header ? 1 : 0;
+      header = false;
+      if (first < rows.size()) {
+        callback(reader.parse(rows, stop, first, record + first));
+      }
+      record += rows.size();
+    }
+
+    size = end - stop;
+    memmove(buffer.data(), stop, size);
+    if (size == buffer.size()) {
+      // Not a single whole record in the buffer, so make room for a longer one
+      buffer.resize(2 * buffer.size());
+    }
+  }
+}
@@ -0,0 +1,131 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <functional>
+#include <map>
+
+#include <dynd/arithmetic.hpp>
+#include <dynd/assignment.hpp>
+#include <dynd/callables/fused_callable.hpp>
+#include <dynd/expression.hpp>
+#include <dynd/functional.hpp>
+
+using namespace std;
+using namespace dynd;
+
+struct nd::expression::node {
+  // The array, when this is a leaf of the expression
+  array value;
+  // Otherwise, the callable applied to the values of args
+  callable f;
+  vector<expression> args;
+};
+
+nd::expression::expression(const array &a) : m_node(make_shared<node>(node{a, callable(), {}})) {}
+
+nd::expression::expression(const callable &f, initializer_list<expression> args)
+    : expression(f, vector<expression>(args)) {}
+
+nd::expression::expression(const callable &f, const vector<expression> &args)
+    : m_node(make_shared<node>(node{array(), f, args})) {}
+
+nd::callable nd::expression::compile(vector<array> &args) const {
+  args.clear();
+
+  vector<ndt::type> arg_tp;
+  vector<callable> step;
+  vector<vector<intptr_t>> step_args;
+  vector<ndt::type> step_tp;
+
+  // Shared subexpressions become one step, and an array used more than once one argument
+  map<const node *, intptr_t> node_index;
+  map<const void *, intptr_t> arg_index;
+  function<intptr_t(const node *)> visit = [&](const node *n) {
+    auto it = node_index.find(n);
+    if (it != node_index.end()) {
+      return it->second;
+    }
+
+    intptr_t i;
+    if (n->f.is_null()) {
+      auto jt = arg_index.find(n->value.get());
+      if (jt == arg_index.end()) {
+        jt = arg_index.emplace(n->value.get(), args.size()).first;
+        args.push_back(n->value);
+        arg_tp.push_back(n->value.get_dtype());
+      }
+      i = jt->second;
+    } else {
+      vector<intptr_t> s_args;
+      vector<ndt::type> s_arg_tp;
+      for (const expression &e : n->args) {
+        intptr_t j = visit(e.m_node.get());
+        s_args.push_back(j);
+        s_arg_tp.push_back((j >= 0) ? arg_tp[j] : step_tp[~j]);
+      }
+
+      callable f = n->f;
+      i = ~static_cast<intptr_t>(step.size());
+      step_tp.push_back(f.resolve(f->get_ret_type(), s_arg_tp.size(), s_arg_tp.data(), 0, nullptr));
+      step.push_back(f);
+      step_args.push_back(s_args);
+    }
+
+    node_index[n] = i;
+    return i;
+  };
+
+  intptr_t res = visit(m_node.get());
+  if (res >= 0) {
+    // An expression that is just an array evaluates to a copy of it
+    step.push_back(copy);
+    step_args.push_back({res});
+    step_tp.push_back(arg_tp[res]);
+  }
+
+  for (size_t s = 0; s + 1 < step.size(); ++s) {
+    if (!step_tp[s].is_pod() || step_tp[s].get_arrmeta_size() != 0) {
+      stringstream ss;
+      ss << "cannot fuse an expression with an intermediate result of type " << step_tp[s];
+      throw type_error(ss.str());
+    }
+  }
+
+  return functional::elwise(make_callable<functional::fused_callable>(
+      ndt::make_type<ndt::callable_type>(step_tp.back(), arg_tp), step, step_args, step_tp));
+}
+
+nd::array nd::expression::eval() const {
+  vector<array> args;
+  callable f = compile(args);
+
+  return f.call(args.size(), args.data(), 0, nullptr);
+}
+
+nd::expression nd::operator-(const expression &e0) { return expression(minus, {e0}); }
+
+nd::expression nd::operator+(const expression &e0, const expression &e1) { return expression(add, {e0, e1}); }
+
+nd::expression nd::operator+(const expression &e0, const array &a1) { return expression(add, {e0, a1}); }
+
+nd::expression nd::operator+(const array &a0, const expression &e1) { return expression(add, {a0, e1}); }
+
+nd::expression nd::operator-(const expression &e0, const expression &e1) { return expression(subtract, {e0, e1}); }
+
+nd::expression nd::operator-(const expression &e0, const array &a1) { return expression(subtract, {e0, a1}); }
+
+nd::expression nd::operator-(const array &a0, const expression &e1) { return expression(subtract, {a0, e1}); }
+
+nd::expression nd::operator*(const expression &e0, const expression &e1) { return expression(multiply, {e0, e1}); }
+
+nd::expression nd::operator*(const expression &e0, const array &a1) { return expression(multiply, {e0, a1}); }
+
+nd::expression nd::operator*(const array &a0, const expression &e1) { return expression(multiply, {a0, e1}); }
+
+nd::expression nd::operator/(const expression &e0, const expression &e1) { return expression(divide, {e0, e1}); }
+
+nd::expression nd::operator/(const expression &e0, const array &a1) { return expression(divide, {e0, a1}); }
+
+nd::expression nd::operator/(const array &a0, const expression &e1) { return expression(divide, {a0, e1}); }
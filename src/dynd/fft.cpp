@@ -0,0 +1,82 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <list>
+#include <map>
+#include <mutex>
+#include <utility>
+
+#include <dynd/callables/batched_fft_callable.hpp>
+#include <dynd/fft.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+
+// The cache keeps this many of the most recently used plans, kernels keep the
+// plans they use alive after they are evicted
+const size_t max_cached_fft_plans = 64;
+
+void check_thread_count(const char *name, intptr_t thread_count) {
+  if (thread_count < 1) {
+    stringstream ss;
+    ss << name << " requires a positive thread count";
+    throw invalid_argument(ss.str());
+  }
+}
+
+} // anonymous namespace
+
+template <typename T>
+shared_ptr<const nd::detail::fft_plan<T>> nd::detail::get_fft_plan(intptr_t size, int sign) {
+  typedef pair<intptr_t, int> key_type;
+  typedef list<pair<key_type, shared_ptr<const fft_plan<T>>>> list_type;
+
+  static mutex cache_mutex;
+  // The plans, most recently used first, and where each key is in that list
+  static list_type cache;
+  static map<key_type, typename list_type::iterator> index;
+
+  lock_guard<mutex> lock(cache_mutex);
+  key_type key(size, sign);
+  auto it = index.find(key);
+  if (it != index.end()) {
+    cache.splice(cache.begin(), cache, it->second);
+    return it->second->second;
+  }
+
+  if (cache.size() >= max_cached_fft_plans) {
+    index.erase(cache.back().first);
+    cache.pop_back();
+  }
+  shared_ptr<const fft_plan<T>> plan = make_shared<fft_plan<T>>(size, sign);
+  cache.emplace_front(key, plan);
+  index[key] = cache.begin();
+
+  return plan;
+}
+
+template DYND_API shared_ptr<const nd::detail::fft_plan<float>> nd::detail::get_fft_plan<float>(intptr_t, int);
+template DYND_API shared_ptr<const nd::detail::fft_plan<double>> nd::detail::get_fft_plan<double>(intptr_t, int);
+
+DYND_API nd::callable nd::fft = nd::make_callable<nd::batched_fft_callable<nd::fft_forward>>(1);
+DYND_API nd::callable nd::ifft = nd::make_callable<nd::batched_fft_callable<nd::fft_inverse>>(1);
+DYND_API nd::callable nd::rfft = nd::make_callable<nd::batched_fft_callable<nd::fft_real_forward>>(1);
+
+nd::callable nd::parallel_fft(intptr_t thread_count) {
+  check_thread_count("parallel_fft", thread_count);
+  return make_callable<batched_fft_callable<fft_forward>>(thread_count);
+}
+
+nd::callable nd::parallel_ifft(intptr_t thread_count) {
+  check_thread_count("parallel_ifft", thread_count);
+  return make_callable<batched_fft_callable<fft_inverse>>(thread_count);
+}
+
+nd::callable nd::parallel_rfft(intptr_t thread_count) {
+  check_thread_count("parallel_rfft", thread_count);
+  return make_callable<batched_fft_callable<fft_real_forward>>(thread_count);
+}
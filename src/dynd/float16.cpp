@@ -3,18 +3,35 @@
 // BSD 2-Clause License, see LICENSE.txt
 //
 
+#include <cstring>
 #include <sstream>
 #include <stdexcept>
 
 #include <dynd/config.hpp>
 
+#if !defined(__CUDACC__) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define DYND_FLOAT16_F16C
+#define DYND_F16C_TARGET __attribute__((target("avx,f16c")))
+#elif !defined(__CUDACC__) && defined(_MSC_VER) && defined(_M_X64)
+#include <immintrin.h>
+#include <intrin.h>
+#define DYND_FLOAT16_F16C
+#define DYND_F16C_TARGET
+#endif
+
 using namespace std;
 using namespace dynd;
 
 // This chooses between 'ties to even' and 'ties away from zero'.
 #define DYND_FLOAT16_ROUND_TIES_TO_EVEN 1
 
-uint16_t dynd::float_to_halfbits(float value)
+namespace {
+
+// With Check, underflow and rounding up to inf raise as documented in float16.hpp. Without it, every value rounds
+// quietly to nearest even, giving signed zero, a subnormal or signed inf.
+template <bool Check>
+uint16_t float_to_halfbits_impl(float value)
 {
   union {
     float f;
@@ -66,7 +83,7 @@ uint16_t dynd::float_to_halfbits(float value)
     // exponents all convert to signed zero halfs.
     if (f_exp < 0x33000000u) {
       // If f != 0, it underflowed to 0
-      if ((f & 0x7fffffff) != 0) {
+      if (Check && (f & 0x7fffffff) != 0) {
 // assign_error_inexact
 #ifndef __CUDA_ARCH__
         stringstream ss;
@@ -80,7 +97,7 @@ uint16_t dynd::float_to_halfbits(float value)
     f_exp >>= 23;
     f_sig = (0x00800000u + (f & 0x007fffffu));
     // If it's not exactly represented, it underflowed
-    if ((f_sig & (((uint32_t)1 << (126 - f_exp)) - 1)) != 0) {
+    if (Check && (f_sig & (((uint32_t)1 << (126 - f_exp)) - 1)) != 0) {
 // assign_error_underflow
 
 #ifndef __CUDA_ARCH__
@@ -95,7 +112,8 @@ uint16_t dynd::float_to_halfbits(float value)
     // If the last bit in the float16 significand is 0 (already even), and
     // the remaining bit pattern is 1000...0, then we do not add one
     // to the bit after the float16 significand.  In all other cases, we do.
-    if ((f_sig & 0x00003fffu) != 0x00001000u) {
+    // The shift above can drop up to 11 bits, so those are checked in f.
+    if ((f_sig & 0x00003fffu) != 0x00001000u || (f & 0x000007ffu) != 0) {
       f_sig += 0x00001000u;
     }
 #else
@@ -128,7 +146,7 @@ uint16_t dynd::float_to_halfbits(float value)
   // correct result.  h_exp may increment to 15, at greatest, in
   // which case the result overflows to a signed inf.
   h_sig += h_exp;
-  if (h_sig == 0x7c00u) {
+  if (Check && h_sig == 0x7c00u) {
 // assign_error_overflow
 #ifndef __CUDA_ARCH__
     stringstream ss;
@@ -139,7 +157,8 @@ uint16_t dynd::float_to_halfbits(float value)
   return h_sgn + h_sig;
 }
 
-uint16_t dynd::double_to_halfbits(double value)
+template <bool Check>
+uint16_t double_to_halfbits_impl(double value)
 {
   union {
     double d;
@@ -191,7 +210,7 @@ uint16_t dynd::double_to_halfbits(double value)
     // exponents all convert to signed zero halfs.
     if (d_exp < 0x3e60000000000000ULL) {
       // If d != 0, it underflowed to 0
-      if ((d & 0x7fffffffffffffffULL) != 0) {
+      if (Check && (d & 0x7fffffffffffffffULL) != 0) {
 // assign_error_inexact
 #ifndef __CUDA_ARCH__
         stringstream ss;
@@ -205,7 +224,7 @@ uint16_t dynd::double_to_halfbits(double value)
     d_exp >>= 52;
     d_sig = (0x0010000000000000ULL + (d & 0x000fffffffffffffULL));
     // If it's not exactly represented, it underflowed
-    if ((d_sig & (((uint64_t)1 << (1051 - d_exp)) - 1)) != 0) {
+    if (Check && (d_sig & (((uint64_t)1 << (1051 - d_exp)) - 1)) != 0) {
 // assign_error_inexact
 #ifndef __CUDA_ARCH__
       stringstream ss;
@@ -219,7 +238,8 @@ uint16_t dynd::double_to_halfbits(double value)
     // If the last bit in the float16 significand is 0 (already even), and
     // the remaining bit pattern is 1000...0, then we do not add one
     // to the bit after the float16 significand.  In all other cases, we do.
-    if ((d_sig & 0x000007ffffffffffULL) != 0x0000020000000000ULL) {
+    // The shift above can drop up to 11 bits, so those are checked in d.
+    if ((d_sig & 0x000007ffffffffffULL) != 0x0000020000000000ULL || (d & 0x00000000000007ffULL) != 0) {
       d_sig += 0x0000020000000000ULL;
     }
 #else
@@ -253,7 +273,7 @@ uint16_t dynd::double_to_halfbits(double value)
   // correct result.  h_exp may increment to 15, at greatest, in
   // which case the result overflows to a signed inf.
   h_sig += h_exp;
-  if (h_sig == 0x7c00u) {
+  if (Check && h_sig == 0x7c00u) {
 // assign_error_overflow
 #ifndef __CUDA_ARCH__
     stringstream ss;
@@ -264,6 +284,28 @@ uint16_t dynd::double_to_halfbits(double value)
   return h_sgn + h_sig;
 }
 
+} // anonymous namespace
+
+uint16_t dynd::float_to_halfbits(float value)
+{
+  return float_to_halfbits_impl<true>(value);
+}
+
+uint16_t dynd::double_to_halfbits(double value)
+{
+  return double_to_halfbits_impl<true>(value);
+}
+
+uint16_t dynd::float_to_halfbits_nocheck(float value)
+{
+  return float_to_halfbits_impl<false>(value);
+}
+
+uint16_t dynd::double_to_halfbits_nocheck(double value)
+{
+  return double_to_halfbits_impl<false>(value);
+}
+
 float dynd::halfbits_to_float(uint16_t h)
 {
   union {
@@ -345,6 +387,209 @@ double dynd::halfbits_to_double(uint16_t h)
   }
 }
 
+namespace {
+
+template <typename DstType, typename SrcType>
+DstType bit_cast(SrcType value)
+{
+  DstType res;
+  memcpy(&res, &value, sizeof(res));
+  return res;
+}
+
+// Branch-free versions of halfbits_to_float and halfbits_to_double for the bulk conversions without F16C.
+// Subnormals are renormalized by subtracting the implicit leading bit in floating point.
+//
+// The float version selects with masks rather than conditionals, which GCC treats as control flow. Its loop is
+// then vectorized with SSE2 and is about 3 times as fast. The double version can't be vectorized with SSE2,
+// which has no 64-bit compares, and the masks only slow it down, so it keeps the conditionals.
+inline float halfbits_to_float_nobranch(uint16_t h)
+{
+  uint32_t o = static_cast<uint32_t>(h & 0x7fffu) << 13;
+  uint32_t h_exp = o & 0x0f800000u;
+  o += (127 - 15) << 23;
+  // Inf or NaN needs the exponent all ones
+  o += static_cast<uint32_t>(h_exp == 0x0f800000u) * ((128 - 16) << 23);
+  uint32_t subnormal = bit_cast<uint32_t>(bit_cast<float>(o + (1u << 23)) - bit_cast<float>(113u << 23));
+  uint32_t subnormal_mask = 0u - static_cast<uint32_t>(h_exp == 0);
+  o = (subnormal & subnormal_mask) | (o & ~subnormal_mask);
+  return bit_cast<float>(o | (static_cast<uint32_t>(h & 0x8000u) << 16));
+}
+
+inline double halfbits_to_double_nobranch(uint16_t h)
+{
+  uint64_t o = static_cast<uint64_t>(h & 0x7fffu) << 42;
+  uint64_t h_exp = o & 0x01f0000000000000ULL;
+  o += static_cast<uint64_t>(1023 - 15) << 52;
+  // Inf or NaN needs the exponent all ones
+  o += (h_exp == 0x01f0000000000000ULL) ? (static_cast<uint64_t>(1024 - 16) << 52) : 0;
+  double d = bit_cast<double>(o);
+  double subnormal = bit_cast<double>(o + (1ULL << 52)) - bit_cast<double>(1009ULL << 52);
+  d = (h_exp == 0) ? subnormal : d;
+  return bit_cast<double>(bit_cast<uint64_t>(d) | (static_cast<uint64_t>(h & 0x8000u) << 48));
+}
+
+#ifdef DYND_FLOAT16_F16C
+
+bool has_f16c()
+{
+#if defined(__GNUC__)
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx") && __builtin_cpu_supports("f16c");
+#else
+  int info[4];
+  __cpuid(info, 1);
+  // OSXSAVE, AVX and F16C, and the OS has to save the AVX state
+  return (info[2] & 0x38000000) == 0x38000000 && (_xgetbv(0) & 0x6) == 0x6;
+#endif
+}
+
+const bool f16c = has_f16c();
+
+DYND_F16C_TARGET void float_to_halfbits_f16c(uint16_t *dst, const float *src, size_t count)
+{
+  const __m256 abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+  const __m256 min_normal = _mm256_set1_ps(6.103515625e-05f);
+  const __m256 max_rounded = _mm256_set1_ps(65520.0f);
+  const __m256 min_overflow = _mm256_set1_ps(65536.0f);
+
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256 f = _mm256_loadu_ps(src + i);
+    __m128i h = _mm256_cvtps_ph(f, _MM_FROUND_TO_NEAREST_INT);
+    // The instruction rounds quietly where float_to_halfbits raises on underflow and on rounding up to inf, and it
+    // doesn't keep the NaN payload, so only take its result when every value is one for which the two agree
+    __m256 a = _mm256_and_ps(f, abs_mask);
+    __m256 exact = _mm256_cmp_ps(_mm256_cvtph_ps(h), f, _CMP_EQ_OQ);
+    __m256 ok = _mm256_or_ps(_mm256_cmp_ps(a, min_overflow, _CMP_GE_OQ),
+                             _mm256_and_ps(_mm256_cmp_ps(a, max_rounded, _CMP_LT_OQ),
+                                           _mm256_or_ps(_mm256_cmp_ps(a, min_normal, _CMP_GE_OQ), exact)));
+    if (_mm256_movemask_ps(ok) == 0xff) {
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), h);
+    } else {
+      for (size_t j = i; j < i + 8; ++j) {
+        dst[j] = float_to_halfbits(src[j]);
+      }
+    }
+  }
+  for (; i < count; ++i) {
+    dst[i] = float_to_halfbits(src[i]);
+  }
+}
+
+DYND_F16C_TARGET void float_to_halfbits_nocheck_f16c(uint16_t *dst, const float *src, size_t count)
+{
+  // Without checks the instruction's rounding is what's wanted for every value, only NaN payloads come out quieted
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), h);
+  }
+  for (; i < count; ++i) {
+    dst[i] = float_to_halfbits_nocheck(src[i]);
+  }
+}
+
+DYND_F16C_TARGET void halfbits_to_float_f16c(float *dst, const uint16_t *src, size_t count)
+{
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(h));
+  }
+  for (; i < count; ++i) {
+    dst[i] = halfbits_to_float_nobranch(src[i]);
+  }
+}
+
+DYND_F16C_TARGET void halfbits_to_double_f16c(double *dst, const uint16_t *src, size_t count)
+{
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256 f = _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i)));
+    _mm256_storeu_pd(dst + i, _mm256_cvtps_pd(_mm256_castps256_ps128(f)));
+    _mm256_storeu_pd(dst + i + 4, _mm256_cvtps_pd(_mm256_extractf128_ps(f, 1)));
+  }
+  for (; i < count; ++i) {
+    dst[i] = halfbits_to_double_nobranch(src[i]);
+  }
+}
+
+#endif // DYND_FLOAT16_F16C
+
+} // anonymous namespace
+
+void dynd::float_to_halfbits(uint16_t *dst, const float *src, size_t count)
+{
+#ifdef DYND_FLOAT16_F16C
+  if (f16c) {
+    float_to_halfbits_f16c(dst, src, count);
+    return;
+  }
+#endif
+
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = float_to_halfbits(src[i]);
+  }
+}
+
+void dynd::double_to_halfbits(uint16_t *dst, const double *src, size_t count)
+{
+  // Going through float would round twice, so there is no F16C path for double
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = double_to_halfbits(src[i]);
+  }
+}
+
+void dynd::float_to_halfbits_nocheck(uint16_t *dst, const float *src, size_t count)
+{
+#ifdef DYND_FLOAT16_F16C
+  if (f16c) {
+    float_to_halfbits_nocheck_f16c(dst, src, count);
+    return;
+  }
+#endif
+
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = float_to_halfbits_nocheck(src[i]);
+  }
+}
+
+void dynd::double_to_halfbits_nocheck(uint16_t *dst, const double *src, size_t count)
+{
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = double_to_halfbits_nocheck(src[i]);
+  }
+}
+
+void dynd::halfbits_to_float(float *dst, const uint16_t *src, size_t count)
+{
+#ifdef DYND_FLOAT16_F16C
+  if (f16c) {
+    halfbits_to_float_f16c(dst, src, count);
+    return;
+  }
+#endif
+
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = halfbits_to_float_nobranch(src[i]);
+  }
+}
+
+void dynd::halfbits_to_double(double *dst, const uint16_t *src, size_t count)
+{
+#ifdef DYND_FLOAT16_F16C
+  if (f16c) {
+    halfbits_to_double_f16c(dst, src, count);
+    return;
+  }
+#endif
+
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = halfbits_to_double_nobranch(src[i]);
+  }
+}
+
 dynd::float16::float16(int128 value)
 {
   m_bits = double_to_halfbits((double)value);
@@ -9,12 +9,15 @@
 #include <dynd/callables/constant_callable.hpp>
 #include <dynd/callables/elwise_entry_callable.hpp>
 #include <dynd/callables/neighborhood_callable.hpp>
+#include <dynd/callables/outer_arithmetic_callable.hpp>
 #include <dynd/callables/outer_callable.hpp>
 #include <dynd/callables/outer_entry_callable.hpp>
 #include <dynd/callables/reduction_callable.hpp>
 #include <dynd/callables/state_callable.hpp>
 #include <dynd/callables/where_callable.hpp>
+#include <dynd/arithmetic.hpp>
 #include <dynd/functional.hpp>
+#include <dynd/kernels/arithmetic.hpp>
 #include <dynd/types/ellipsis_dim_type.hpp>
 
 using namespace std;
@@ -134,8 +137,30 @@ nd::callable nd::functional::elwise(const callable &child, bool res_ignore) {
 
 nd::callable nd::functional::outer_entry_callable::dispatch_child = nd::make_callable<dispatch_callable>();
 
-nd::callable nd::functional::outer(const callable &child) {
-  return make_callable<outer_entry_callable>(outer_make_type(child->get_type().extended<ndt::callable_type>()), child);
+nd::callable nd::functional::outer(const callable &child, intptr_t thread_count) {
+  if (thread_count < 1) {
+    throw invalid_argument("outer: thread_count must be at least 1");
+  }
+
+  callable f =
+      make_callable<outer_entry_callable>(outer_make_type(child->get_type().extended<ndt::callable_type>()), child);
+
+  // The arithmetic functions have a blocked kernel for the outer product of
+  // two vectors. Integer division is left out because it checks for zero.
+  if (child.get() == add.get()) {
+    return make_callable<outer_arithmetic_callable<dynd::detail::inline_add>>(thread_count, true, f);
+  }
+  if (child.get() == subtract.get()) {
+    return make_callable<outer_arithmetic_callable<dynd::detail::inline_subtract>>(thread_count, true, f);
+  }
+  if (child.get() == multiply.get()) {
+    return make_callable<outer_arithmetic_callable<dynd::detail::inline_multiply>>(thread_count, true, f);
+  }
+  if (child.get() == divide.get()) {
+    return make_callable<outer_arithmetic_callable<dynd::detail::inline_divide>>(thread_count, false, f);
+  }
+
+  return f;
 }
 
 ndt::type nd::functional::outer_make_type(const ndt::callable_type *child_tp) {
@@ -156,20 +181,46 @@ ndt::type nd::functional::outer_make_type(const ndt::callable_type *child_tp) {
       ret_tp, ndt::make_type<ndt::tuple_type>(out_param_types.size(), out_param_types.data()), kwd_tp);
 }
 
-nd::callable nd::functional::neighborhood(const callable &neighborhood_op, const callable &boundary_child) {
-  const ndt::callable_type *funcproto_tp = neighborhood_op->get_type().extended<ndt::callable_type>();
+// The neighborhood signature takes the "shape" and an optional "offset" of the neighborhood, along with the keywords
+// of the child
+static ndt::type neighborhood_make_type(const nd::callable &child) {
+  std::vector<std::pair<ndt::type, std::string>> kwds{
+      {ndt::type("Fixed * int32"), "shape"},
+      {ndt::make_type<ndt::option_type>(ndt::type("Fixed * int32")), "offset"}};
+  const std::vector<std::pair<ndt::type, std::string>> &child_kwds = child->get_kwd_types();
+  kwds.insert(kwds.end(), child_kwds.begin(), child_kwds.end());
+
+  ndt::type arg_tp = ndt::make_type<ndt::ellipsis_dim_type>("Dims", child->get_arg_types()[0].get_dtype());
+  return ndt::make_type<ndt::callable_type>(
+      ndt::make_type<ndt::ellipsis_dim_type>("Dims", child->get_ret_type().get_dtype()), 1, &arg_tp, kwds);
+}
+
+nd::callable nd::functional::neighborhood(const callable &child, const callable &boundary_child,
+                                          intptr_t thread_count) {
+  if (boundary_child.is_null()) {
+    return neighborhood(child, neighborhood_boundary_zero, thread_count);
+  }
 
-  intptr_t nh_ndim = funcproto_tp->get_argument_types()[0].get_ndim();
-  std::vector<ndt::type> arg_tp(2);
-  arg_tp[0] = ndt::type("?" + std::to_string(nh_ndim) + " * int");
-  arg_tp[1] = ndt::type("?" + std::to_string(nh_ndim) + " * int");
+  if (child.is_null()) {
+    throw invalid_argument("'child' cannot be null");
+  }
+
+  return make_callable<neighborhood_callable>(neighborhood_make_type(child), child, boundary_child,
+                                              neighborhood_boundary_fill, thread_count);
+}
+
+nd::callable nd::functional::neighborhood(const callable &child, neighborhood_boundary_mode boundary_mode,
+                                          intptr_t thread_count) {
+  if (child.is_null()) {
+    throw invalid_argument("'child' cannot be null");
+  }
+
+  if (boundary_mode == neighborhood_boundary_fill) {
+    throw invalid_argument("neighborhood_boundary_fill requires a boundary callable");
+  }
 
-  return make_callable<neighborhood_callable<1>>(
-      ndt::make_type<ndt::callable_type>(
-          funcproto_tp->get_argument_types()[0].with_replaced_dtype(funcproto_tp->get_return_type()),
-          funcproto_tp->get_pos_tuple(),
-          ndt::make_type<ndt::struct_type>(std::vector<std::string>{"shape", "offset"}, arg_tp)),
-      neighborhood_op, boundary_child);
+  return make_callable<neighborhood_callable>(neighborhood_make_type(child), child, callable(), boundary_mode,
+                                              thread_count);
 }
 
 nd::callable nd::functional::reduction(const callable &identity, const callable &child) {
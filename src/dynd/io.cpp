@@ -3,12 +3,485 @@
 // BSD 2-Clause License, see LICENSE.txt
 //
 
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <sstream>
+
 #include <dynd/callables/serialize_callable.hpp>
 #include <dynd/functional.hpp>
 #include <dynd/io.hpp>
+#include <dynd/memblock/memmap_memory_block.hpp>
+#include <dynd/types/fixed_dim_type.hpp>
+#include <dynd/types/option_type.hpp>
+#include <dynd/types/string_type.hpp>
+#include <dynd/types/struct_type.hpp>
+#include <dynd/types/var_dim_type.hpp>
 
 using namespace std;
 using namespace dynd;
 
 DYND_API nd::callable nd::serialize = nd::functional::reduction(
     [] { return bytes(); }, nd::make_callable<nd::serialize_callable<ndt::scalar_kind_type>>());
+
+namespace {
+
+// The binary format is a header of
+//
+//   char magic[8]; uint32 version; uint32 byte_order; uint64 datashape_size; uint64 payload_offset;
+//
+// followed by the datashape of the type and then, at payload_offset, the payload. The payload
+// starts with the value in the default layout of the type, with each string, bytes and var dim
+// replaced by a {uint64 offset, uint64 size} pair. The offsets point into a heap after the value,
+// relative to the start of the payload, and var dim elements in the heap use the same encoding.
+const char binary_magic[8] = {'D', 'Y', 'N', 'D', 'B', 'I', 'N', '\0'};
+const uint32_t binary_version = 1;
+const uint32_t binary_byte_order = 0x01020304;
+const size_t binary_header_size = 32;
+const size_t binary_payload_alignment = 64;
+const size_t binary_heap_alignment = 16;
+
+/**
+ * Returns true if values of the type are stored entirely in their fixed-size
+ * part, with no references into the heap. Throws for types the binary format
+ * does not support.
+ */
+bool is_flat(const ndt::type &tp);
+
+bool is_flat(const std::vector<ndt::type> &field_types)
+{
+  bool flat = true;
+  for (const ndt::type &field_tp : field_types) {
+    flat = is_flat(field_tp) && flat;
+  }
+  return flat;
+}
+
+bool is_flat(const ndt::type &tp)
+{
+  switch (tp.get_id()) {
+  case fixed_dim_id:
+    return is_flat(tp.extended<ndt::fixed_dim_type>()->get_element_type());
+  case struct_id:
+    return is_flat(tp.extended<ndt::struct_type>()->get_field_types());
+  case tuple_id:
+    return is_flat(tp.extended<ndt::tuple_type>()->get_field_types());
+  case option_id:
+    return is_flat(tp.extended<ndt::option_type>()->get_value_type());
+  case string_id:
+  case bytes_id:
+  case var_dim_id:
+    return false;
+  default:
+    if (tp.is_builtin() || (tp.is_pod() && tp.get_arrmeta_size() == 0)) {
+      return true;
+    }
+    break;
+  }
+
+  stringstream ss;
+  ss << "dynd binary serialization does not support type " << tp;
+  throw type_error(ss.str());
+}
+
+/**
+ * Holds the default arrmeta for a type, which describes the layout used by the
+ * binary format.
+ */
+class default_arrmeta {
+  ndt::type m_tp;
+  std::vector<char> m_arrmeta;
+
+public:
+  default_arrmeta(const ndt::type &tp) : m_tp(tp), m_arrmeta(tp.get_arrmeta_size())
+  {
+    if (!m_arrmeta.empty()) {
+      m_tp.extended()->arrmeta_default_construct(m_arrmeta.data(), false);
+    }
+  }
+
+  ~default_arrmeta()
+  {
+    if (!m_arrmeta.empty()) {
+      m_tp.extended()->arrmeta_destruct(m_arrmeta.data());
+    }
+  }
+
+  const char *get() const { return m_arrmeta.data(); }
+};
+
+class binary_writer {
+  struct heap_item {
+    ndt::type tp;
+    const char *arrmeta;
+    const char *default_arrmeta;
+    const char *data;
+    intptr_t stride;
+    size_t count;
+    uint64_t offset;
+  };
+
+  std::ostream &m_o;
+  std::vector<char> m_buffer;
+  uint64_t m_pos, m_heap_end;
+  std::deque<heap_item> m_heap;
+
+  void flush()
+  {
+    m_o.write(m_buffer.data(), m_buffer.size());
+    m_buffer.clear();
+  }
+
+  void write(const char *data, size_t size)
+  {
+    if (size >= 65536) {
+      flush();
+      m_o.write(data, size);
+    }
+    else {
+      m_buffer.insert(m_buffer.end(), data, data + size);
+      if (m_buffer.size() >= 65536) {
+        flush();
+      }
+    }
+    m_pos += size;
+  }
+
+  void pad_to(uint64_t pos)
+  {
+    m_buffer.insert(m_buffer.end(), pos - m_pos, '\0');
+    m_pos = pos;
+  }
+
+  void write_ref(uint64_t offset, uint64_t size)
+  {
+    uint64_t ref[2] = {offset, size};
+    write(reinterpret_cast<const char *>(ref), sizeof(ref));
+  }
+
+  uint64_t alloc(uint64_t size)
+  {
+    uint64_t offset = m_heap_end;
+    m_heap_end = inc_to_alignment(m_heap_end + size, binary_heap_alignment);
+    return offset;
+  }
+
+  void write_bytes_ref(const char *data, size_t size)
+  {
+    uint64_t offset = alloc(size);
+    if (size > 0) {
+      m_heap.push_back({ndt::type(), nullptr, nullptr, data, 1, size, offset});
+    }
+    write_ref(offset, size);
+  }
+
+public:
+  binary_writer(std::ostream &o, const ndt::type &tp)
+      : m_o(o), m_pos(0), m_heap_end(inc_to_alignment(tp.get_default_data_size(), binary_heap_alignment))
+  {
+    m_buffer.reserve(65536);
+  }
+
+  void write_value(const ndt::type &tp, const char *arrmeta, const char *default_arrmeta, const char *data)
+  {
+    switch (tp.get_id()) {
+    case fixed_dim_id: {
+      const fixed_dim_type_arrmeta *md = reinterpret_cast<const fixed_dim_type_arrmeta *>(arrmeta);
+      write_elements(tp.extended<ndt::fixed_dim_type>()->get_element_type(), arrmeta + sizeof(fixed_dim_type_arrmeta),
+                     default_arrmeta + sizeof(fixed_dim_type_arrmeta), data, md->stride, md->dim_size);
+      break;
+    }
+    case struct_id:
+      write_fields(tp.extended<ndt::struct_type>(), arrmeta, default_arrmeta, data);
+      break;
+    case tuple_id:
+      write_fields(tp.extended<ndt::tuple_type>(), arrmeta, default_arrmeta, data);
+      break;
+    case option_id:
+      write_value(tp.extended<ndt::option_type>()->get_value_type(), arrmeta, default_arrmeta, data);
+      break;
+    case string_id: {
+      const dynd::string *s = reinterpret_cast<const dynd::string *>(data);
+      write_bytes_ref(s->data(), s->size());
+      break;
+    }
+    case bytes_id: {
+      const bytes *b = reinterpret_cast<const bytes *>(data);
+      write_bytes_ref(b->data(), b->size());
+      break;
+    }
+    case var_dim_id: {
+      const ndt::type &element_tp = tp.extended<ndt::var_dim_type>()->get_element_type();
+      const ndt::var_dim_type::metadata_type *md = reinterpret_cast<const ndt::var_dim_type::metadata_type *>(arrmeta);
+      const ndt::var_dim_type::data_type *d = reinterpret_cast<const ndt::var_dim_type::data_type *>(data);
+      uint64_t offset = alloc(d->size * element_tp.get_default_data_size());
+      if (d->size > 0) {
+        m_heap.push_back({element_tp, arrmeta + sizeof(ndt::var_dim_type::metadata_type),
+                          default_arrmeta + sizeof(ndt::var_dim_type::metadata_type), d->begin + md->offset, md->stride,
+                          d->size, offset});
+      }
+      write_ref(offset, d->size);
+      break;
+    }
+    default:
+      write(data, tp.get_data_size());
+      break;
+    }
+  }
+
+  template <typename FieldsType>
+  void write_fields(const FieldsType *ft, const char *arrmeta, const char *default_arrmeta, const char *data)
+  {
+    const uintptr_t *data_offsets = reinterpret_cast<const uintptr_t *>(arrmeta);
+    const uintptr_t *default_data_offsets = reinterpret_cast<const uintptr_t *>(default_arrmeta);
+    const uintptr_t *arrmeta_offsets = ft->get_arrmeta_offsets_raw();
+    uint64_t start = m_pos;
+    for (intptr_t i = 0; i < ft->get_field_count(); ++i) {
+      pad_to(start + default_data_offsets[i]);
+      write_value(ft->get_field_type(i), arrmeta + arrmeta_offsets[i], default_arrmeta + arrmeta_offsets[i],
+                  data + data_offsets[i]);
+    }
+    pad_to(start + ft->get_default_data_size());
+  }
+
+  void write_elements(const ndt::type &tp, const char *arrmeta, const char *default_arrmeta, const char *data,
+                      intptr_t stride, size_t count)
+  {
+    if (tp.get_arrmeta_size() == 0 && is_flat(tp) && stride == static_cast<intptr_t>(tp.get_data_size())) {
+      write(data, count * stride);
+    }
+    else {
+      for (size_t i = 0; i < count; ++i, data += stride) {
+        write_value(tp, arrmeta, default_arrmeta, data);
+      }
+    }
+  }
+
+  /**
+   * Writes the heap referenced by the values written so far. The heap items are
+   * queued in the order their offsets were assigned, so this is sequential too.
+   */
+  void write_heap()
+  {
+    while (!m_heap.empty()) {
+      heap_item item = m_heap.front();
+      m_heap.pop_front();
+      pad_to(item.offset);
+      if (item.tp.is_null()) {
+        write(item.data, item.count);
+      }
+      else {
+        write_elements(item.tp, item.arrmeta, item.default_arrmeta, item.data, item.stride, item.count);
+      }
+    }
+    pad_to(m_heap_end);
+    flush();
+  }
+};
+
+class binary_reader {
+  const char *m_payload;
+  uint64_t m_size;
+
+  const char *get_ref(const char *src, uint64_t element_size, uint64_t &out_count) const
+  {
+    uint64_t ref[2];
+    memcpy(ref, src, sizeof(ref));
+    if (ref[0] > m_size || (element_size > 0 && ref[1] > (m_size - ref[0]) / element_size)) {
+      throw runtime_error("dynd load: reference out of bounds, the data is corrupt");
+    }
+    out_count = ref[1];
+    return m_payload + ref[0];
+  }
+
+public:
+  binary_reader(const char *payload, uint64_t size) : m_payload(payload), m_size(size) {}
+
+  void read_value(const ndt::type &tp, const char *arrmeta, char *dst, const char *src) const
+  {
+    switch (tp.get_id()) {
+    case fixed_dim_id: {
+      const fixed_dim_type_arrmeta *md = reinterpret_cast<const fixed_dim_type_arrmeta *>(arrmeta);
+      read_elements(tp.extended<ndt::fixed_dim_type>()->get_element_type(), arrmeta + sizeof(fixed_dim_type_arrmeta),
+                    dst, src, md->stride, md->dim_size);
+      break;
+    }
+    case struct_id:
+      read_fields(tp.extended<ndt::struct_type>(), arrmeta, dst, src);
+      break;
+    case tuple_id:
+      read_fields(tp.extended<ndt::tuple_type>(), arrmeta, dst, src);
+      break;
+    case option_id:
+      read_value(tp.extended<ndt::option_type>()->get_value_type(), arrmeta, dst, src);
+      break;
+    case string_id: {
+      uint64_t size;
+      const char *data = get_ref(src, 1, size);
+      reinterpret_cast<dynd::string *>(dst)->assign(data, size);
+      break;
+    }
+    case bytes_id: {
+      uint64_t size;
+      const char *data = get_ref(src, 1, size);
+      reinterpret_cast<bytes *>(dst)->assign(data, size);
+      break;
+    }
+    case var_dim_id: {
+      const ndt::type &element_tp = tp.extended<ndt::var_dim_type>()->get_element_type();
+      const ndt::var_dim_type::metadata_type *md = reinterpret_cast<const ndt::var_dim_type::metadata_type *>(arrmeta);
+      ndt::var_dim_type::data_type *d = reinterpret_cast<ndt::var_dim_type::data_type *>(dst);
+      uint64_t count;
+      const char *data = get_ref(src, element_tp.get_default_data_size(), count);
+      d->begin = md->blockref->alloc(count);
+      d->size = count;
+      read_elements(element_tp, arrmeta + sizeof(ndt::var_dim_type::metadata_type), d->begin, data, md->stride, count);
+      break;
+    }
+    default:
+      memcpy(dst, src, tp.get_data_size());
+      break;
+    }
+  }
+
+  template <typename FieldsType>
+  void read_fields(const FieldsType *ft, const char *arrmeta, char *dst, const char *src) const
+  {
+    const uintptr_t *data_offsets = reinterpret_cast<const uintptr_t *>(arrmeta);
+    const uintptr_t *arrmeta_offsets = ft->get_arrmeta_offsets_raw();
+    for (intptr_t i = 0; i < ft->get_field_count(); ++i) {
+      read_value(ft->get_field_type(i), arrmeta + arrmeta_offsets[i], dst + data_offsets[i], src + data_offsets[i]);
+    }
+  }
+
+  void read_elements(const ndt::type &tp, const char *arrmeta, char *dst, const char *src, intptr_t stride,
+                     size_t count) const
+  {
+    if (is_flat(tp)) {
+      memcpy(dst, src, count * stride);
+    }
+    else {
+      for (size_t i = 0; i < count; ++i, dst += stride, src += stride) {
+        read_value(tp, arrmeta, dst, src);
+      }
+    }
+  }
+};
+
+template <typename T>
+T read_header_field(const char *begin, size_t offset)
+{
+  T value;
+  memcpy(&value, begin + offset, sizeof(T));
+  return value;
+}
+
+} // anonymous namespace
+
+void nd::save(std::ostream &o, const array &a)
+{
+  const ndt::type &tp = a.get_type();
+  is_flat(tp);
+
+  stringstream ss;
+  ss << tp;
+  std::string datashape = ss.str();
+
+  char header[binary_header_size];
+  uint32_t version = binary_version, byte_order = binary_byte_order;
+  uint64_t datashape_size = datashape.size();
+  uint64_t payload_offset = inc_to_alignment(binary_header_size + datashape_size, binary_payload_alignment);
+  memcpy(header, binary_magic, sizeof(binary_magic));
+  memcpy(header + 8, &version, sizeof(version));
+  memcpy(header + 12, &byte_order, sizeof(byte_order));
+  memcpy(header + 16, &datashape_size, sizeof(datashape_size));
+  memcpy(header + 24, &payload_offset, sizeof(payload_offset));
+  o.write(header, sizeof(header));
+  o.write(datashape.data(), datashape.size());
+  std::string padding(payload_offset - binary_header_size - datashape_size, '\0');
+  o.write(padding.data(), padding.size());
+
+  default_arrmeta layout(tp);
+  binary_writer writer(o, tp);
+  writer.write_value(tp, a->metadata(), layout.get(), a.cdata());
+  writer.write_heap();
+
+  if (!o.good()) {
+    throw runtime_error("dynd save: error writing to the stream");
+  }
+}
+
+void nd::save(const std::string &filename, const array &a)
+{
+  std::ofstream f(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!f.good()) {
+    stringstream ss;
+    ss << "dynd save: error opening file " << filename;
+    throw runtime_error(ss.str());
+  }
+
+  save(f, a);
+}
+
+nd::array nd::load(const char *begin, const char *end, const memory_block &owner)
+{
+  size_t size = end - begin;
+  if (size < binary_header_size || memcmp(begin, binary_magic, sizeof(binary_magic)) != 0) {
+    throw runtime_error("dynd load: the data is not in the dynd binary format");
+  }
+  if (read_header_field<uint32_t>(begin, 8) != binary_version) {
+    throw runtime_error("dynd load: unsupported version of the dynd binary format");
+  }
+  if (read_header_field<uint32_t>(begin, 12) != binary_byte_order) {
+    throw runtime_error("dynd load: the data was written with a different byte order");
+  }
+  uint64_t datashape_size = read_header_field<uint64_t>(begin, 16);
+  uint64_t payload_offset = read_header_field<uint64_t>(begin, 24);
+  if (datashape_size > size - binary_header_size || payload_offset < binary_header_size + datashape_size ||
+      payload_offset > size) {
+    throw runtime_error("dynd load: invalid header, the data is corrupt");
+  }
+
+  ndt::type tp(std::string(begin + binary_header_size, datashape_size));
+  const char *payload = begin + payload_offset;
+  uint64_t payload_size = size - payload_offset;
+  if (payload_size < tp.get_default_data_size()) {
+    throw runtime_error("dynd load: the data is truncated");
+  }
+
+  if (is_flat(tp)) {
+    if (owner && reinterpret_cast<uintptr_t>(payload) % tp.get_data_alignment() == 0) {
+      array res = make_array(tp, const_cast<char *>(payload), owner, read_access_flag | immutable_access_flag);
+      if (tp.get_arrmeta_size() > 0) {
+        tp.extended()->arrmeta_default_construct(res->metadata(), false);
+      }
+      return res;
+    }
+
+    array res = empty(tp);
+    memcpy(res.data(), payload, tp.get_default_data_size());
+    return res;
+  }
+
+  array res = empty(tp);
+  binary_reader(payload, payload_size).read_value(tp, res->metadata(), res.data(), payload);
+  return res;
+}
+
+nd::array nd::load(std::istream &in)
+{
+  std::string str((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+  // Copy into an 8-byte aligned buffer, so fixed-size values can be viewed in place
+  array buf = empty(str.size() / sizeof(int64_t) + 1, ndt::make_type<int64_t>());
+  memcpy(buf.data(), str.data(), str.size());
+  return load(buf.cdata(), buf.cdata() + str.size(), buf);
+}
+
+nd::array nd::load(const std::string &filename)
+{
+  char *data;
+  intptr_t size;
+  memory_block mm = make_memory_block<memmap_memory_block>(filename, read_access_flag, &data, &size);
+  return load(data, data + size, mm);
+}
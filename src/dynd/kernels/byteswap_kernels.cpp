@@ -3,10 +3,28 @@
 // BSD 2-Clause License, see LICENSE.txt
 //
 
+#include <dynd/array.hpp>
 #include <dynd/callables/byteswap_callable.hpp>
+#include <dynd/types/adapt_type.hpp>
+#include <dynd/types/fixed_bytes_type.hpp>
 
 using namespace std;
 using namespace dynd;
 
 DYND_API nd::callable nd::byteswap = nd::make_callable<nd::byteswap_callable>();
 DYND_API nd::callable nd::pairwise_byteswap = nd::make_callable<nd::pairwise_byteswap_callable>();
+
+nd::array nd::view_byteswapped(const array &a) {
+  const ndt::type &value_tp = a.get_dtype();
+  if (!value_tp.is_builtin()) {
+    stringstream ss;
+    ss << "view_byteswapped requires a builtin dtype, but was given " << value_tp;
+    throw type_error(ss.str());
+  }
+
+  // Complex values swap their real and imaginary parts separately
+  const callable &swap = value_tp.get_base_id() == complex_kind_id ? pairwise_byteswap : byteswap;
+  return a.replace_dtype(ndt::make_type<ndt::adapt_type>(
+      value_tp, ndt::make_type<ndt::fixed_bytes_type>(value_tp.get_data_size(), value_tp.get_data_alignment()), swap,
+      swap));
+}
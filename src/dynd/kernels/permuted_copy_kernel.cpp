@@ -0,0 +1,68 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <algorithm>
+#include <cstring>
+
+#include <dynd/kernels/permuted_copy_kernel.hpp>
+#include <dynd/parallel.hpp>
+
+#if !defined(__CUDACC__) && (defined(__SSE2__) || defined(_M_X64))
+#include <emmintrin.h>
+#define DYND_STREAMING_STORES
+#endif
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+
+// Each thread gets a whole number of cache lines
+const size_t cache_line_size = 64;
+
+void copy_chunk(char *dst, const char *src, size_t size, bool streaming) {
+#ifdef DYND_STREAMING_STORES
+  if (streaming) {
+    size_t head = (16 - reinterpret_cast<uintptr_t>(dst) % 16) % 16;
+    head = min(head, size);
+    memcpy(dst, src, head);
+    dst += head;
+    src += head;
+    size -= head;
+
+    // Write around the cache, since the destination would only evict the
+    // data that is going to be used next
+    for (; size >= 64; size -= 64, dst += 64, src += 64) {
+      __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+      __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 16));
+      __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 32));
+      __m128i v3 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 48));
+      _mm_stream_si128(reinterpret_cast<__m128i *>(dst), v0);
+      _mm_stream_si128(reinterpret_cast<__m128i *>(dst + 16), v1);
+      _mm_stream_si128(reinterpret_cast<__m128i *>(dst + 32), v2);
+      _mm_stream_si128(reinterpret_cast<__m128i *>(dst + 48), v3);
+    }
+    memcpy(dst, src, size);
+    _mm_sfence();
+    return;
+  }
+#else
+  (void)streaming;
+#endif
+
+  memcpy(dst, src, size);
+}
+
+} // anonymous namespace
+
+void nd::bulk_copy(char *dst, const char *src, size_t size, intptr_t thread_count) {
+  bool streaming = size >= streaming_copy_threshold;
+  intptr_t line_count = static_cast<intptr_t>((size + cache_line_size - 1) / cache_line_size);
+  parallel_for(line_count, max(thread_count, static_cast<intptr_t>(1)),
+               static_cast<intptr_t>(parallel_copy_threshold / cache_line_size), [&](intptr_t begin, intptr_t end) {
+                 size_t offset = begin * cache_line_size;
+                 copy_chunk(dst + offset, src + offset, min(end * cache_line_size, size) - offset, streaming);
+               });
+}
@@ -0,0 +1,20 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <dynd/callables/matmul_callable.hpp>
+#include <dynd/linalg.hpp>
+
+using namespace std;
+using namespace dynd;
+
+DYND_API nd::callable nd::matmul = nd::make_callable<nd::matmul_callable>(1);
+
+nd::callable nd::parallel_matmul(intptr_t thread_count) {
+  if (thread_count < 1) {
+    throw invalid_argument("parallel_matmul requires a positive thread count");
+  }
+
+  return make_callable<matmul_callable>(thread_count);
+}
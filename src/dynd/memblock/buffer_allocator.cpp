@@ -0,0 +1,222 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#elif defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#include <dynd/memblock/buffer_allocator.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+
+const size_t min_class_shift = 6;
+const size_t class_count = 7; // 64, 128, ..., 4096 bytes
+const size_t max_class_size = size_t(1) << (min_class_shift + class_count - 1);
+const size_t max_cached_per_class = 64;
+const size_t huge_page_size = size_t(1) << 21;
+
+// Every block is preceded by a header recording how to free it. It sits at the end
+// of the alignment padding, so the block itself keeps the requested alignment.
+struct block_header {
+  size_t size;
+  nd::buffer_allocator *allocator;
+};
+
+std::atomic<nd::buffer_allocator *> current_allocator(nullptr);
+std::atomic<bool> huge_pages(false);
+
+std::atomic<uint64_t> allocation_count(0), cached_count(0), large_count(0), bytes_in_use(0);
+
+size_t get_size_class(size_t size)
+{
+  size_t i = 0;
+  while ((size_t(1) << (min_class_shift + i)) < size) {
+    ++i;
+  }
+  return i;
+}
+
+// The caches are trivially destructible, so a block freed while a thread is exiting
+// (for instance by a static array) can still check whether its cache was flushed.
+struct free_list {
+  void *head;
+  size_t count;
+};
+
+thread_local free_list thread_cache[class_count];
+thread_local bool thread_cache_closed = false;
+
+struct thread_cache_flusher {
+  ~thread_cache_flusher()
+  {
+    for (free_list &list : thread_cache) {
+      while (list.head != nullptr) {
+        void *next = *reinterpret_cast<void **>(list.head);
+        free(list.head);
+        list.head = next;
+      }
+      list.count = 0;
+    }
+    thread_cache_closed = true;
+  }
+};
+
+thread_local thread_cache_flusher thread_cache_owner;
+
+void *aligned_malloc(size_t size, size_t alignment)
+{
+#if defined(_WIN32)
+  void *ptr = _aligned_malloc(size, alignment);
+#else
+  void *ptr = nullptr;
+  if (posix_memalign(&ptr, alignment, size) != 0) {
+    ptr = nullptr;
+  }
+#endif
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void aligned_free(void *ptr)
+{
+#if defined(_WIN32)
+  _aligned_free(ptr);
+#else
+  free(ptr);
+#endif
+}
+
+class default_buffer_allocator : public nd::buffer_allocator {
+public:
+  void *allocate(size_t size, size_t alignment)
+  {
+    if (alignment > 16) {
+      if (size < huge_page_size || !huge_pages.load(std::memory_order_relaxed)) {
+        return aligned_malloc(size, alignment);
+      }
+
+      // Huge pages need the block to start on a huge page boundary
+      void *ptr = aligned_malloc(size, huge_page_size);
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+      madvise(ptr, size, MADV_HUGEPAGE);
+#endif
+      return ptr;
+    }
+
+    if (size <= max_class_size) {
+      size_t i = get_size_class(size);
+      free_list &list = thread_cache[i];
+      if (list.head != nullptr) {
+        void *ptr = list.head;
+        list.head = *reinterpret_cast<void **>(ptr);
+        --list.count;
+        cached_count.fetch_add(1, std::memory_order_relaxed);
+        return ptr;
+      }
+      size = size_t(1) << (min_class_shift + i);
+    }
+
+    void *ptr = malloc(size);
+    if (ptr == nullptr) {
+      throw std::bad_alloc();
+    }
+    return ptr;
+  }
+
+  void deallocate(void *ptr, size_t size, size_t alignment)
+  {
+    if (alignment > 16) {
+      aligned_free(ptr);
+      return;
+    }
+
+    if (size <= max_class_size && !thread_cache_closed) {
+      // Touch the owner so that this thread's cache is flushed when it exits
+      (void)&thread_cache_owner;
+      free_list &list = thread_cache[get_size_class(size)];
+      if (list.count < max_cached_per_class) {
+        *reinterpret_cast<void **>(ptr) = list.head;
+        list.head = ptr;
+        ++list.count;
+        return;
+      }
+    }
+
+    free(ptr);
+  }
+};
+
+default_buffer_allocator default_allocator;
+
+} // anonymous namespace
+
+nd::buffer_allocator::~buffer_allocator() {}
+
+nd::buffer_allocator *nd::get_default_buffer_allocator() { return &default_allocator; }
+
+void nd::set_buffer_allocator(buffer_allocator *allocator) { current_allocator.store(allocator); }
+
+nd::buffer_allocator *nd::get_buffer_allocator()
+{
+  buffer_allocator *allocator = current_allocator.load(std::memory_order_relaxed);
+  return (allocator == nullptr) ? &default_allocator : allocator;
+}
+
+void nd::set_huge_pages(bool enable) { huge_pages.store(enable); }
+
+nd::buffer_allocation_stats nd::get_buffer_allocation_stats()
+{
+  buffer_allocation_stats stats;
+  stats.allocation_count = allocation_count.load();
+  stats.cached_count = cached_count.load();
+  stats.large_count = large_count.load();
+  stats.bytes_in_use = bytes_in_use.load();
+
+  return stats;
+}
+
+void *nd::detail::allocate_buffer(size_t size)
+{
+  size_t alignment = (size >= large_buffer_size) ? large_buffer_alignment : 16;
+  buffer_allocator *allocator = get_buffer_allocator();
+  char *ptr = reinterpret_cast<char *>(allocator->allocate(size + alignment, alignment)) + alignment;
+
+  block_header *header = reinterpret_cast<block_header *>(ptr) - 1;
+  header->size = size;
+  header->allocator = allocator;
+
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  if (alignment != 16) {
+    large_count.fetch_add(1, std::memory_order_relaxed);
+  }
+  bytes_in_use.fetch_add(size, std::memory_order_relaxed);
+
+  return ptr;
+}
+
+void nd::detail::deallocate_buffer(void *ptr)
+{
+  if (ptr == nullptr) {
+    return;
+  }
+
+  const block_header *header = reinterpret_cast<const block_header *>(ptr) - 1;
+  size_t size = header->size;
+  size_t alignment = (size >= large_buffer_size) ? large_buffer_alignment : 16;
+  bytes_in_use.fetch_sub(size, std::memory_order_relaxed);
+
+  header->allocator->deallocate(reinterpret_cast<char *>(ptr) - alignment, size + alignment, alignment);
+}
@@ -6,8 +6,10 @@
 #include <dynd/arithmetic.hpp>
 #include <dynd/assignment.hpp>
 #include <dynd/comparison.hpp>
+#include <dynd/fft.hpp>
 #include <dynd/index.hpp>
 #include <dynd/io.hpp>
+#include <dynd/linalg.hpp>
 #include <dynd/math.hpp>
 #include <dynd/option.hpp>
 #include <dynd/pointer.hpp>
@@ -36,8 +38,10 @@ registry_entry &dynd::registered() {
                                                 {"divide", nd::divide},
                                                 {"equal", nd::equal},
                                                 {"exp", nd::exp},
+                                                {"fft", nd::fft},
                                                 {"greater", nd::greater},
                                                 {"greater_equal", nd::greater_equal},
+                                                {"ifft", nd::ifft},
                                                 {"imag", nd::imag},
                                                 {"is_na", nd::is_na},
                                                 {"left_shift", nd::left_shift},
@@ -47,6 +51,7 @@ registry_entry &dynd::registered() {
                                                 {"logical_not", nd::logical_not},
                                                 {"logical_or", nd::logical_or},
                                                 {"logical_xor", nd::logical_xor},
+                                                {"matmul", nd::matmul},
                                                 {"max", nd::max},
                                                 {"min", nd::min},
                                                 {"minus", nd::minus},
@@ -57,6 +62,7 @@ registry_entry &dynd::registered() {
                                                 {"pow", nd::pow},
                                                 {"range", nd::range},
                                                 {"real", nd::real},
+                                                {"rfft", nd::rfft},
                                                 {"right_shift", nd::right_shift},
                                                 {"serialize", nd::serialize},
                                                 {"sin", nd::sin},
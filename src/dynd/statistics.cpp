@@ -3,10 +3,12 @@
 // BSD 2-Clause License, see LICENSE.txt
 //
 
+#include <dynd/arithmetic.hpp>
 #include <dynd/callables/max_callable.hpp>
 #include <dynd/callables/mean_callable.hpp>
 #include <dynd/callables/min_callable.hpp>
 #include <dynd/callables/multidispatch_callable.hpp>
+#include <dynd/callables/rolling_callable.hpp>
 #include <dynd/functional.hpp>
 #include <dynd/limits.hpp>
 #include <dynd/statistics.hpp>
@@ -37,3 +39,31 @@ DYND_API nd::callable nd::min = nd::functional::reduction(
                          ndt::make_type<ndt::callable_type>(ndt::make_type<ndt::scalar_kind_type>(),
                                                             {ndt::make_type<ndt::scalar_kind_type>()}),
                          nd::callable::make_all<nd::min_callable, arithmetic_types>(func_ptr)));
+
+nd::callable nd::rolling(rolling_statistic statistic, intptr_t window, intptr_t min_periods) {
+  if (window < 1) {
+    throw invalid_argument("rolling window must be positive");
+  }
+
+  if (min_periods < 0) {
+    min_periods = window;
+  } else if (min_periods > window) {
+    throw invalid_argument("rolling min_periods cannot be larger than the window");
+  }
+
+  return make_callable<rolling_callable>(make_callable<rolling_dim_callable>(statistic, window, min_periods));
+}
+
+nd::callable nd::rolling(const callable &reduction, intptr_t window, intptr_t min_periods) {
+  if (reduction.get() == nd::sum.get()) {
+    return rolling(rolling_sum, window, min_periods);
+  } else if (reduction.get() == nd::mean.get()) {
+    return rolling(rolling_mean, window, min_periods);
+  } else if (reduction.get() == nd::min.get()) {
+    return rolling(rolling_min, window, min_periods);
+  } else if (reduction.get() == nd::max.get()) {
+    return rolling(rolling_max, window, min_periods);
+  }
+
+  throw invalid_argument("rolling supports nd::sum, nd::mean, nd::min and nd::max, or a rolling_statistic");
+}
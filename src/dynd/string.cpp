@@ -14,6 +14,7 @@
 #include <dynd/callables/string_endswith_callable.hpp>
 #include <dynd/callables/string_contains_callable.hpp>
 #include <dynd/string.hpp>
+#include <dynd/types/fixed_dim_type.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -29,10 +30,52 @@ DYND_API nd::callable nd::string_rfind = nd::functional::elwise(nd::make_callabl
 
 DYND_API nd::callable nd::string_replace = nd::functional::elwise(nd::make_callable<nd::string_replace_callable>());
 
-DYND_API nd::callable nd::string_split = nd::functional::elwise(nd::make_callable<nd::string_split_callable>());
+DYND_API nd::callable nd::string_split =
+    nd::functional::elwise(nd::make_callable<nd::string_split_callable<dynd::string>>());
+
+DYND_API nd::callable nd::string_split_offsets =
+    nd::functional::elwise(nd::make_callable<nd::string_split_callable<nd::string_piece_offsets>>());
 
 DYND_API nd::callable nd::string_startswith = nd::functional::elwise(nd::make_callable<nd::string_startswith_callable>());
 
 DYND_API nd::callable nd::string_endswith = nd::functional::elwise(nd::make_callable<nd::string_endswith_callable>());
 
 DYND_API nd::callable nd::string_contains = nd::functional::elwise(nd::make_callable<nd::string_contains_callable>());
+
+nd::array nd::string_tokenize(const array &a, const std::string &sep)
+{
+  const ndt::type &tp = a.get_type();
+  if (tp.get_id() != fixed_dim_id || tp.extended<ndt::fixed_dim_type>()->get_element_type().get_id() != string_id) {
+    stringstream ss;
+    ss << "dynd string_tokenize: expected an array of type N * string, got " << tp;
+    throw type_error(ss.str());
+  }
+
+  intptr_t size = a.get_dim_size();
+  intptr_t src_stride = reinterpret_cast<const fixed_dim_type_arrmeta *>(a->metadata())->stride;
+  array res = empty(size, ndt::make_type<ndt::var_dim_type>(ndt::make_type<dynd::string>()));
+  intptr_t dst_stride = reinterpret_cast<const fixed_dim_type_arrmeta *>(res->metadata())->stride;
+  const ndt::var_dim_type::metadata_type *md =
+      reinterpret_cast<const ndt::var_dim_type::metadata_type *>(res->metadata() + sizeof(fixed_dim_type_arrmeta));
+
+  // The allocation moves as it grows, so record where each row starts and point at it afterwards
+  dynd::string needle(sep);
+  std::vector<size_t> starts(size + 1);
+  detail::string_split_appender<dynd::string> f(md->blockref, 2 * size + 1);
+  const char *src = a.cdata();
+  for (intptr_t i = 0; i < size; ++i, src += src_stride) {
+    starts[i] = f.size();
+    f.split(*reinterpret_cast<const dynd::string *>(src), needle);
+  }
+  starts[size] = f.size();
+
+  char *pieces = f.finish();
+  char *dst = res.data();
+  for (intptr_t i = 0; i < size; ++i, dst += dst_stride) {
+    ndt::var_dim_type::data_type *dst_v = reinterpret_cast<ndt::var_dim_type::data_type *>(dst);
+    dst_v->begin = pieces + starts[i] * md->stride;
+    dst_v->size = starts[i + 1] - starts[i];
+  }
+
+  return res;
+}
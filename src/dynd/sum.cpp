@@ -3,8 +3,11 @@
 // BSD 2-Clause License, see LICENSE.txt
 //
 
+#include <cstring>
+
 #include <dynd/arithmetic.hpp>
 #include <dynd/callable.hpp>
+#include <dynd/callables/default_instantiable_callable.hpp>
 #include <dynd/callables/multidispatch_callable.hpp>
 #include <dynd/callables/sum_callable.hpp>
 #include <dynd/functional.hpp>
@@ -19,14 +22,36 @@ static std::vector<ndt::type> func_ptr(const ndt::type &DYND_UNUSED(dst_tp), siz
   return {src_tp[0].get_dtype()};
 }
 
+static std::vector<ndt::type> zero_func_ptr(const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc),
+                                            const ndt::type *DYND_UNUSED(src_tp)) {
+  return {dst_tp};
+}
+
+// The identity of the sum, written at the width of the accumulator. All of
+// the summed types represent zero with zero bits.
+template <typename ReturnType>
+struct zero_kernel : nd::base_strided_kernel<zero_kernel<ReturnType>, 0> {
+  void single(char *dst, char *const *DYND_UNUSED(src)) { memset(dst, 0, sizeof(ReturnType)); }
+};
+
+template <typename ReturnType>
+class zero_callable : public nd::default_instantiable_callable<zero_kernel<ReturnType>> {
+public:
+  zero_callable()
+      : nd::default_instantiable_callable<zero_kernel<ReturnType>>(
+            ndt::make_type<ndt::callable_type>(ndt::make_type<ReturnType>(), {})) {}
+};
+
+typedef type_sequence<int8_t, int16_t, int32_t, int64_t, uint8_t, uint16_t, uint32_t, uint64_t, float16, float, double,
+                      dynd::complex<float>, dynd::complex<double>>
+    sum_types;
+
 } // unnamed namespace
 
 DYND_API nd::callable nd::sum = nd::functional::reduction(
-    [] { return 0; },
+    nd::make_callable<nd::multidispatch_callable<1>>(ndt::type("() -> Any"),
+                                                     nd::callable::make_all<zero_callable, sum_types>(zero_func_ptr)),
     nd::make_callable<nd::multidispatch_callable<1>>(
         ndt::make_type<ndt::callable_type>(ndt::make_type<ndt::scalar_kind_type>(),
                                            {ndt::make_type<ndt::scalar_kind_type>()}),
-        nd::callable::make_all<nd::sum_callable,
-                               type_sequence<int8_t, int16_t, int32_t, int64_t, uint8_t, uint16_t, uint32_t, uint64_t,
-                                             float16, float, double, dynd::complex<float>, dynd::complex<double>>>(
-            func_ptr)));
+        nd::callable::make_all<nd::sum_callable, sum_types>(func_ptr)));
@@ -3,6 +3,7 @@
 // BSD 2-Clause License, see LICENSE.txt
 //
 
+#include <algorithm>
 #include <cstring>
 #include <map>
 #include <set>
@@ -10,6 +11,7 @@
 #include <dynd/array_range.hpp>
 #include <dynd/assignment.hpp>
 #include <dynd/callable.hpp>
+#include <dynd/parallel.hpp>
 #include <dynd/search.hpp>
 #include <dynd/types/categorical_type.hpp>
 #include <dynd/types/fixed_dim_type.hpp>
@@ -54,6 +56,237 @@ public:
   }
 };
 
+// Hashes a run of bytes a word at a time. Category strings are mostly short,
+// so this beats a byte at a time hash by a wide margin.
+inline uint64_t hash_bytes(const char *data, size_t size) {
+  uint64_t h = 0x9e3779b97f4a7c15ULL ^ size;
+  for (; size >= 8; data += 8, size -= 8) {
+    uint64_t word;
+    memcpy(&word, data, 8);
+    h = (h ^ word) * 0xff51afd7ed558ccdULL;
+    h ^= h >> 32;
+  }
+  if (size > 0) {
+    uint64_t word = 0;
+    memcpy(&word, data, size);
+    h = (h ^ word) * 0xc4ceb9fe1a85ec53ULL;
+  }
+
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  return h;
+}
+
+// Folds -0 into +0 and every NaN into one quiet NaN, in a float held as the
+// unsigned integer of the same size
+template <typename UIntType, int MantissaBits>
+void canonicalize_float(char *data) {
+  const UIntType sign = UIntType(1) << (8 * sizeof(UIntType) - 1);
+  const UIntType mantissa = (UIntType(1) << MantissaBits) - 1;
+  const UIntType exponent = static_cast<UIntType>(~sign & ~mantissa);
+
+  UIntType bits;
+  memcpy(&bits, data, sizeof(UIntType));
+  if ((bits & static_cast<UIntType>(~sign)) == 0) {
+    bits = 0;
+  } else if ((bits & exponent) == exponent && (bits & mantissa) != 0) {
+    bits = static_cast<UIntType>(exponent | (UIntType(1) << (MantissaBits - 1)));
+  }
+  memcpy(data, &bits, sizeof(UIntType));
+}
+
+inline void canonicalize_float128(char *data) {
+  float128 value;
+  memcpy(&value, data, sizeof(float128));
+  const uint64_t sign = 1ULL << 63, exponent = 0x7fff000000000000ULL, mantissa_hi = 0x0000ffffffffffffULL;
+  if ((value.m_hi & ~sign) == 0 && value.m_lo == 0) {
+    value.m_hi = 0;
+  } else if ((value.m_hi & exponent) == exponent && ((value.m_hi & mantissa_hi) != 0 || value.m_lo != 0)) {
+    value.m_hi = exponent | 0x0000800000000000ULL;
+    value.m_lo = 0;
+  }
+  memcpy(data, &value, sizeof(float128));
+}
+
+/**
+ * Hashes and compares category values by their bytes, which works for
+ * strings and for POD types without arrmeta. Floating point values, and
+ * the parts of complex ones, are canonicalized first so that they compare
+ * by value: -0.0 matches 0.0, and any NaN matches any other NaN.
+ */
+class category_hasher {
+  bool m_string;
+  size_t m_data_size;
+  type_id_t m_float_id;
+
+  /** Returns ``data``, or a canonical copy of it in ``buffer`` for floating point values */
+  const char *canonical(const char *data, char *buffer) const {
+    switch (m_float_id) {
+    case float16_id:
+      memcpy(buffer, data, 2);
+      canonicalize_float<uint16_t, 10>(buffer);
+      return buffer;
+    case float32_id:
+    case complex_float32_id:
+      memcpy(buffer, data, m_data_size);
+      for (size_t i = 0; i < m_data_size; i += 4) {
+        canonicalize_float<uint32_t, 23>(buffer + i);
+      }
+      return buffer;
+    case float64_id:
+    case complex_float64_id:
+      memcpy(buffer, data, m_data_size);
+      for (size_t i = 0; i < m_data_size; i += 8) {
+        canonicalize_float<uint64_t, 52>(buffer + i);
+      }
+      return buffer;
+    case float128_id:
+      memcpy(buffer, data, 16);
+      canonicalize_float128(buffer);
+      return buffer;
+    default:
+      return data;
+    }
+  }
+
+public:
+  category_hasher(const ndt::type &tp)
+      : m_string(tp.get_id() == string_id), m_data_size(tp.get_data_size()), m_float_id(tp.get_id()) {}
+
+  static bool is_hashable(const ndt::type &tp) {
+    return tp.get_id() == string_id ||
+           (tp.is_pod() && tp.get_arrmeta_size() == 0 && tp.get_base_id() != expr_kind_id);
+  }
+
+  uint64_t hash(const char *data) const {
+    if (m_string) {
+      const dynd::string *s = reinterpret_cast<const dynd::string *>(data);
+      return hash_bytes(s->begin(), s->size());
+    }
+
+    char buffer[16];
+    return hash_bytes(canonical(data, buffer), m_data_size);
+  }
+
+  bool equal(const char *lhs, const char *rhs) const {
+    if (m_string) {
+      const dynd::string *l = reinterpret_cast<const dynd::string *>(lhs);
+      const dynd::string *r = reinterpret_cast<const dynd::string *>(rhs);
+      return l->size() == r->size() && memcmp(l->begin(), r->begin(), l->size()) == 0;
+    }
+
+    char lhs_buffer[16], rhs_buffer[16];
+    return memcmp(canonical(lhs, lhs_buffer), canonical(rhs, rhs_buffer), m_data_size) == 0;
+  }
+
+  /** Copies a value into default constructed destination memory */
+  void copy(char *dst, const char *src) const {
+    if (m_string) {
+      *reinterpret_cast<dynd::string *>(dst) = *reinterpret_cast<const dynd::string *>(src);
+    } else {
+      memcpy(dst, src, m_data_size);
+    }
+  }
+};
+
+/** The number of hash slots to use for a given number of values, a power of two */
+inline size_t hash_slot_count(size_t value_count) {
+  size_t slot_count = 16;
+  while (slot_count < 2 * value_count) {
+    slot_count *= 2;
+  }
+
+  return slot_count;
+}
+
+/**
+ * Finds the slot of ``data`` in an open addressing table whose used slots
+ * hold index + 1, returning either the slot holding an equal value or the
+ * empty slot where it belongs. ``get_value`` maps an index to its value.
+ */
+template <typename GetValue>
+size_t find_slot(const std::vector<uint32_t> &slots, const category_hasher &hasher, const char *data,
+                 GetValue get_value) {
+  size_t mask = slots.size() - 1;
+  size_t i = static_cast<size_t>(hasher.hash(data)) & mask;
+  while (slots[i] != 0 && !hasher.equal(get_value(slots[i] - 1), data)) {
+    i = (i + 1) & mask;
+  }
+
+  return i;
+}
+
+/**
+ * Writes the values of ``count`` strided categories found in ``slots`` as
+ * ``StorageType``, stopping at the first one that is missing. Returns the
+ * number of categories written.
+ */
+template <typename StorageType, typename GetValue>
+size_t lookup_values(const std::vector<uint32_t> &slots, const category_hasher &hasher, char *dst,
+                     intptr_t dst_stride, const char *src, intptr_t src_stride, size_t count, GetValue get_value) {
+  for (size_t i = 0; i != count; ++i, dst += dst_stride, src += src_stride) {
+    uint32_t value = slots[find_slot(slots, hasher, src, get_value)];
+    if (value == 0) {
+      return i;
+    }
+    *reinterpret_cast<StorageType *>(dst) = static_cast<StorageType>(value - 1);
+  }
+
+  return count;
+}
+
+/**
+ * Accumulates the distinct values of a strided range, in order of first
+ * appearance, assigning each value the index of its category.
+ */
+class factorizer {
+  const category_hasher &m_hasher;
+  std::vector<uint32_t> m_slots;
+  std::vector<const char *> m_uniques;
+
+  void grow() {
+    std::vector<uint32_t> slots(m_slots.size() * 2);
+    size_t mask = slots.size() - 1;
+    for (uint32_t j = 0; j != m_uniques.size(); ++j) {
+      size_t i = static_cast<size_t>(m_hasher.hash(m_uniques[j])) & mask;
+      while (slots[i] != 0) {
+        i = (i + 1) & mask;
+      }
+      slots[i] = j + 1;
+    }
+
+    m_slots.swap(slots);
+  }
+
+public:
+  factorizer(const category_hasher &hasher) : m_hasher(hasher), m_slots(hash_slot_count(0)) {}
+
+  const std::vector<const char *> &uniques() const { return m_uniques; }
+
+  uint32_t insert(const char *data) {
+    size_t i = find_slot(m_slots, m_hasher, data, [this](uint32_t j) { return m_uniques[j]; });
+    if (m_slots[i] != 0) {
+      return m_slots[i] - 1;
+    }
+
+    uint32_t code = static_cast<uint32_t>(m_uniques.size());
+    m_uniques.push_back(data);
+    m_slots[i] = code + 1;
+    if (2 * m_uniques.size() > m_slots.size()) {
+      grow();
+    }
+
+    return code;
+  }
+
+  void insert(const char *data, intptr_t stride, intptr_t count, uint32_t *out_codes) {
+    for (intptr_t i = 0; i < count; ++i, data += stride) {
+      out_codes[i] = insert(data);
+    }
+  }
+};
+
 // struct assign_from_commensurate_category {
 //     static void general_kernel(char *dst, intptr_t dst_stride, const char
 //     *src, intptr_t src_stride,
@@ -198,6 +431,17 @@ ndt::categorical_type::categorical_type(type_id_t id, const nd::array &categorie
     m_categories = make_sorted_categories(uniques, m_category_tp, categories_element_arrmeta);
   }
 
+  // Index the categories by hash, so looking up a value doesn't need a search
+  if (category_hasher::is_hashable(m_category_tp)) {
+    category_hasher hasher(m_category_tp);
+    auto get_value = [this](uint32_t value) { return get_category_data_from_value(value); };
+    m_value_hash_slots.resize(hash_slot_count(category_count));
+    for (uint32_t value = 0; value != static_cast<uint32_t>(category_count); ++value) {
+      m_value_hash_slots[find_slot(m_value_hash_slots, hasher, get_category_data_from_value(value), get_value)] =
+          value + 1;
+    }
+  }
+
   // Use the number of categories to set which underlying integer storage to use
   if (category_count <= 256) {
     m_storage_type = make_type<uint8_t>();
@@ -260,6 +504,20 @@ void ndt::categorical_type::get_shape(intptr_t ndim, intptr_t i, intptr_t *out_s
 }
 
 uint32_t ndt::categorical_type::get_value_from_category(const char *category_arrmeta, const char *category_data) const {
+  if (!m_value_hash_slots.empty()) {
+    uint32_t value = m_value_hash_slots[find_slot(m_value_hash_slots, category_hasher(m_category_tp), category_data,
+                                                  [this](uint32_t v) { return get_category_data_from_value(v); })];
+    if (value == 0) {
+      stringstream ss;
+      ss << "Unrecognized category value ";
+      m_category_tp.print_data(ss, category_arrmeta, category_data);
+      ss << " assigning to dynd type " << type(this, true);
+      throw std::runtime_error(ss.str());
+    }
+
+    return value - 1;
+  }
+
   type dst_tp = make_type<intptr_t>();
   type src_tp[2] = {m_categories.get_type(), m_category_tp};
   const char *src_arrmeta[2] = {m_categories.get()->metadata(), category_arrmeta};
@@ -289,6 +547,10 @@ uint32_t ndt::categorical_type::get_value_from_category(const nd::array &categor
     c.assign(category);
   }
 
+  if (!m_value_hash_slots.empty()) {
+    return get_value_from_category(c.get()->metadata(), c.cdata());
+  }
+
   intptr_t i = nd::binary_search(m_categories, c).as<intptr_t>();
   if (i < 0) {
     stringstream ss;
@@ -301,6 +563,47 @@ uint32_t ndt::categorical_type::get_value_from_category(const nd::array &categor
   }
 }
 
+void ndt::categorical_type::get_values_from_categories(char *dst, intptr_t dst_stride, const char *category_arrmeta,
+                                                       const char *src, intptr_t src_stride, size_t count) const {
+  if (m_value_hash_slots.empty()) {
+    for (size_t i = 0; i != count; ++i, dst += dst_stride, src += src_stride) {
+      uint32_t value = get_value_from_category(category_arrmeta, src);
+      switch (m_storage_type.get_id()) {
+      case uint8_id:
+        *reinterpret_cast<uint8_t *>(dst) = static_cast<uint8_t>(value);
+        break;
+      case uint16_id:
+        *reinterpret_cast<uint16_t *>(dst) = static_cast<uint16_t>(value);
+        break;
+      default:
+        *reinterpret_cast<uint32_t *>(dst) = value;
+        break;
+      }
+    }
+    return;
+  }
+
+  category_hasher hasher(m_category_tp);
+  auto get_value = [this](uint32_t v) { return get_category_data_from_value(v); };
+  size_t written;
+  switch (m_storage_type.get_id()) {
+  case uint8_id:
+    written = lookup_values<uint8_t>(m_value_hash_slots, hasher, dst, dst_stride, src, src_stride, count, get_value);
+    break;
+  case uint16_id:
+    written = lookup_values<uint16_t>(m_value_hash_slots, hasher, dst, dst_stride, src, src_stride, count, get_value);
+    break;
+  default:
+    written = lookup_values<uint32_t>(m_value_hash_slots, hasher, dst, dst_stride, src, src_stride, count, get_value);
+    break;
+  }
+
+  if (written != count) {
+    // Raises the usual error for the category that is missing
+    get_value_from_category(category_arrmeta, src + written * src_stride);
+  }
+}
+
 const char *ndt::categorical_type::get_category_arrmeta() const {
   const char *arrmeta = m_categories.get()->metadata();
   m_categories.get_type().extended()->at_single(0, &arrmeta, NULL);
@@ -389,10 +692,20 @@ ndt::type ndt::factor_categorical(const nd::array &values) {
   cmp less(fn, k.get());
   set<const char *, cmp> uniques(less);
 
-  for (intptr_t i = 0; i < dim_size; ++i) {
-    const char *data = values_eval.cdata() + i * stride;
-    if (uniques.find(data) == uniques.end()) {
-      uniques.insert(data);
+  if (category_hasher::is_hashable(el_tp)) {
+    // Find the distinct values by hashing, so only they need to be sorted
+    category_hasher hasher(el_tp);
+    factorizer f(hasher);
+    for (intptr_t i = 0; i < dim_size; ++i) {
+      f.insert(values_eval.cdata() + i * stride);
+    }
+    uniques.insert(f.uniques().begin(), f.uniques().end());
+  } else {
+    for (intptr_t i = 0; i < dim_size; ++i) {
+      const char *data = values_eval.cdata() + i * stride;
+      if (uniques.find(data) == uniques.end()) {
+        uniques.insert(data);
+      }
     }
   }
 
@@ -402,6 +715,82 @@ ndt::type ndt::factor_categorical(const nd::array &values) {
   return make_type<categorical_type>(categories, true);
 }
 
+nd::array nd::factorize(const nd::array &values, nd::array &out_categories, intptr_t thread_count) {
+  nd::array values_eval = values.eval();
+
+  intptr_t dim_size, stride;
+  ndt::type el_tp;
+  const char *el_arrmeta;
+  if (values_eval.get_ndim() != 1 ||
+      !values_eval.get_type().get_as_strided(values_eval.get()->metadata(), &dim_size, &stride, &el_tp, &el_arrmeta)) {
+    stringstream ss;
+    ss << "dynd factorize requires a one-dimensional strided array, got " << values.get_type();
+    throw type_error(ss.str());
+  }
+  if (!category_hasher::is_hashable(el_tp)) {
+    stringstream ss;
+    ss << "dynd factorize does not support values of type " << el_tp;
+    throw type_error(ss.str());
+  }
+
+  category_hasher hasher(el_tp);
+  nd::array codes = nd::empty(dim_size, ndt::make_type<uint32_t>());
+  uint32_t *codes_data = reinterpret_cast<uint32_t *>(codes.data());
+  const char *data = values_eval.cdata();
+
+  // Below this many values per thread, threads cost more than they save
+  intptr_t chunk_count = parallel_chunk_count(dim_size, thread_count, 65536);
+  auto chunk_begin = [&](intptr_t t) { return dim_size * t / chunk_count; };
+
+  std::vector<const char *> uniques;
+  if (chunk_count <= 1) {
+    factorizer f(hasher);
+    f.insert(data, stride, dim_size, codes_data);
+    uniques = f.uniques();
+  } else {
+    // Each thread factorizes its own chunk, then the chunk's local codes are
+    // remapped to the codes of a merged table, which preserves the order of
+    // first appearance
+    std::vector<factorizer> chunks(chunk_count, factorizer(hasher));
+    parallel_for(chunk_count, chunk_count, 1, [&](intptr_t t_begin, intptr_t t_end) {
+      for (intptr_t t = t_begin; t < t_end; ++t) {
+        intptr_t begin = chunk_begin(t);
+        chunks[t].insert(data + begin * stride, stride, chunk_begin(t + 1) - begin, codes_data + begin);
+      }
+    });
+
+    factorizer merged(hasher);
+    std::vector<std::vector<uint32_t>> remaps(chunk_count);
+    for (intptr_t t = 0; t < chunk_count; ++t) {
+      for (const char *value : chunks[t].uniques()) {
+        remaps[t].push_back(merged.insert(value));
+      }
+    }
+
+    parallel_for(chunk_count, chunk_count, 1, [&](intptr_t t_begin, intptr_t t_end) {
+      for (intptr_t t = t_begin; t < t_end; ++t) {
+        const std::vector<uint32_t> &remap = remaps[t];
+        for (uint32_t *code = codes_data + chunk_begin(t), *end = codes_data + chunk_begin(t + 1); code != end;
+             ++code) {
+          *code = remap[*code];
+        }
+      }
+    });
+    uniques = merged.uniques();
+  }
+
+  out_categories = nd::empty(uniques.size(), el_tp);
+  intptr_t categories_stride =
+      reinterpret_cast<const fixed_dim_type_arrmeta *>(out_categories.get()->metadata())->stride;
+  char *dst = out_categories.data();
+  for (const char *value : uniques) {
+    hasher.copy(dst, value);
+    dst += categories_stride;
+  }
+
+  return codes;
+}
+
 std::map<std::string, std::pair<ndt::type, const char *>> ndt::categorical_type::get_dynamic_type_properties() const {
   std::map<std::string, std::pair<ndt::type, const char *>> properties;
   properties["storage_type"] = {ndt::type("type"), reinterpret_cast<const char *>(&m_storage_type)};
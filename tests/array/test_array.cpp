@@ -12,6 +12,7 @@
 
 #include <dynd/array.hpp>
 #include <dynd/gtest.hpp>
+#include <dynd/json_parser.hpp>
 #include <dynd/types/fixed_bytes_type.hpp>
 #include <dynd/types/string_type.hpp>
 
@@ -661,6 +662,54 @@ TEST(Array, ConstructAssign) {
   EXPECT_EQ(4, v2[4].value());
 }
 
+TEST(Array, Concatenate) {
+  EXPECT_ARRAY_EQ((nd::array{1, 2, 3, 4, 5, 6}),
+                  nd::concatenate({nd::array{1, 2}, nd::array{3}, nd::array{4, 5, 6}}));
+  EXPECT_ARRAY_EQ((nd::array{1.5, 2.5, 3.5}), nd::concatenate(nd::array{1.5}, nd::array{2.5, 3.5}));
+
+  // Along an inner axis, with the dtypes promoted
+  nd::array a = parse_json("2 * 2 * int32", "[[1, 2], [3, 4]]");
+  nd::array b = parse_json("2 * 1 * float64", "[[5.5], [6.5]]");
+  EXPECT_ARRAY_EQ(parse_json("2 * 3 * float64", "[[1, 2, 5.5], [3, 4, 6.5]]"), nd::concatenate({a, b}, 1));
+  EXPECT_ARRAY_EQ(parse_json("2 * 3 * float64", "[[5.5, 1, 2], [6.5, 3, 4]]"), nd::concatenate({b, a}, -1));
+  EXPECT_ARRAY_EQ(parse_json("4 * 2 * int32", "[[1, 2], [3, 4], [1, 2], [3, 4]]"), nd::concatenate({a, a}));
+
+  EXPECT_ARRAY_EQ(parse_json("3 * string", "[\"a\", \"bc\", \"d\"]"),
+                  nd::concatenate({parse_json("1 * string", "[\"a\"]"), parse_json("2 * string", "[\"bc\", \"d\"]")}));
+
+  // Many pieces split across threads
+  vector<nd::array> pieces;
+  for (intptr_t i = 0; i < 10; ++i) {
+    nd::array piece = nd::empty(1000, ndt::make_type<double>());
+    for (intptr_t j = 0; j < 1000; ++j) {
+      reinterpret_cast<double *>(piece.data())[j] = static_cast<double>(i * 1000 + j);
+    }
+    pieces.push_back(piece);
+  }
+  nd::array c = nd::concatenate(pieces, 0, 4);
+  ASSERT_EQ(10000, c.get_dim_size());
+  for (intptr_t i = 0; i < 10000; ++i) {
+    ASSERT_EQ(static_cast<double>(i), reinterpret_cast<const double *>(c.cdata())[i]);
+  }
+
+  EXPECT_THROW(nd::concatenate(vector<nd::array>()), invalid_argument);
+  EXPECT_THROW(nd::concatenate({a, b}), invalid_argument);
+  EXPECT_THROW(nd::concatenate({a, nd::array{1, 2}}), invalid_argument);
+  EXPECT_THROW(nd::concatenate({a, a}, 2), invalid_argument);
+  EXPECT_THROW(nd::concatenate({nd::array(1), nd::array(2)}), invalid_argument);
+}
+
+TEST(Array, Stack) {
+  nd::array a{1, 2, 3}, b{4, 5, 6};
+  EXPECT_ARRAY_EQ(parse_json("2 * 3 * int32", "[[1, 2, 3], [4, 5, 6]]"), nd::stack({a, b}));
+  EXPECT_ARRAY_EQ(parse_json("3 * 2 * int32", "[[1, 4], [2, 5], [3, 6]]"), nd::stack({a, b}, 1));
+  EXPECT_ARRAY_EQ(parse_json("3 * 2 * int32", "[[1, 4], [2, 5], [3, 6]]"), nd::stack({a, b}, -1));
+  EXPECT_ARRAY_EQ((nd::array{1.0, 2.5}), nd::stack({nd::array(1), nd::array(2.5)}));
+
+  EXPECT_THROW(nd::stack({a, nd::array{1, 2}}), invalid_argument);
+  EXPECT_THROW(nd::stack({a, b}, 2), invalid_argument);
+}
+
 REGISTER_TYPED_TEST_CASE_P(Array, ScalarConstructor, OneDimConstructor, TwoDimConstructor, ThreeDimConstructor,
                            AsScalar);
 
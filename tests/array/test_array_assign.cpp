@@ -4,6 +4,7 @@
 //
 
 #include <cmath>
+#include <cstring>
 #include <iostream>
 #include <stdexcept>
 
@@ -13,6 +14,8 @@
 #include <dynd/assignment.hpp>
 #include <dynd/gtest.hpp>
 #include <dynd/json_parser.hpp>
+#include <dynd/kernels/permuted_copy_kernel.hpp>
+#include <dynd/types/fixed_bytes_type.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -596,6 +599,170 @@ TEST(ArrayAssign, ArrayValsAtType) {
   }
 }
 
+TEST(ArrayAssign, CheckedBlocks) {
+  // Large enough to span several checked blocks
+  const intptr_t size = 1000;
+
+  nd::array a = nd::empty(size, "int64");
+  int64_t *a_data = reinterpret_cast<int64_t *>(a.data());
+  for (intptr_t i = 0; i < size; ++i) {
+    a_data[i] = i % 256 - 128;
+  }
+  nd::array b = nd::empty(size, "int8");
+  b.assign(a, assign_error_overflow);
+  const int8_t *b_data = reinterpret_cast<const int8_t *>(b.cdata());
+  for (intptr_t i = 0; i < size; ++i) {
+    EXPECT_EQ(i % 256 - 128, b_data[i]);
+  }
+
+  // An offending element in a later block is reported, and everything before it has been assigned
+  a_data[777] = 128;
+  b.assign(0);
+  try {
+    b.assign(a, assign_error_overflow);
+    FAIL() << "expected an overflow_error";
+  } catch (const overflow_error &e) {
+    EXPECT_NE(std::string::npos, std::string(e.what()).find("at index 777")) << e.what();
+  }
+  for (intptr_t i = 0; i < 777; ++i) {
+    EXPECT_EQ(i % 256 - 128, b_data[i]);
+  }
+
+  // Strided source
+  nd::array c = nd::empty(2 * size, "float64");
+  double *c_data = reinterpret_cast<double *>(c.data());
+  for (intptr_t i = 0; i < 2 * size; ++i) {
+    c_data[i] = static_cast<double>(i / 2);
+  }
+  nd::array d = nd::empty(size, "int32");
+  d.assign(c(irange().by(2)), assign_error_fractional);
+  const int32_t *d_data = reinterpret_cast<const int32_t *>(d.cdata());
+  for (intptr_t i = 0; i < size; ++i) {
+    EXPECT_EQ(i, d_data[i]);
+  }
+  c_data[2 * 500] = 0.5;
+  EXPECT_THROW(d.assign(c(irange().by(2)), assign_error_fractional), runtime_error);
+  c_data[2 * 500] = 1e30;
+  try {
+    d.assign(c(irange().by(2)), assign_error_overflow);
+    FAIL() << "expected an overflow_error";
+  } catch (const overflow_error &e) {
+    EXPECT_NE(std::string::npos, std::string(e.what()).find("at index 500")) << e.what();
+  }
+
+  // Floating point inexact checking
+  nd::array e = nd::empty(size, "float32");
+  c_data[2 * 500] = 500;
+  e.assign(c(irange().by(2)), assign_error_inexact);
+  EXPECT_EQ(500.0f, reinterpret_cast<const float *>(e.cdata())[500]);
+  c_data[2 * 999] = 1 / 3.0;
+  EXPECT_THROW(e.assign(c(irange().by(2)), assign_error_inexact), runtime_error);
+}
+
+TEST(ArrayAssign, Permuted) {
+  // Big enough for several tiles, with partial tiles and blocks at the edges
+  const intptr_t m = 150, n = 203;
+
+  nd::array a = nd::empty(m, n, "float32");
+  float *a_data = reinterpret_cast<float *>(a.data());
+  for (intptr_t i = 0; i < m * n; ++i) {
+    a_data[i] = static_cast<float>(i);
+  }
+  nd::array b = nd::empty(n, m, "float32");
+  b.assign(a.transpose());
+  const float *b_data = reinterpret_cast<const float *>(b.cdata());
+  for (intptr_t i = 0; i < n; ++i) {
+    for (intptr_t j = 0; j < m; ++j) {
+      ASSERT_EQ(a_data[j * n + i], b_data[i * m + j]) << "at " << i << ", " << j;
+    }
+  }
+
+  // A permutation of three dimensions, with the source contiguous along the outermost one
+  nd::array c = nd::empty(3, 37, 41, "int16");
+  int16_t *c_data = reinterpret_cast<int16_t *>(c.data());
+  for (intptr_t i = 0; i < 3 * 37 * 41; ++i) {
+    c_data[i] = static_cast<int16_t>(i);
+  }
+  intptr_t axes[3] = {2, 0, 1};
+  nd::array d = nd::copy(c.permute(3, axes));
+  EXPECT_EQ(ndt::type("41 * 3 * 37 * int16"), d.get_type());
+  const int16_t *d_data = reinterpret_cast<const int16_t *>(d.cdata());
+  for (intptr_t i = 0; i < 41; ++i) {
+    for (intptr_t j = 0; j < 3; ++j) {
+      for (intptr_t k = 0; k < 37; ++k) {
+        ASSERT_EQ(c_data[(j * 37 + k) * 41 + i], d_data[(i * 3 + j) * 37 + k]);
+      }
+    }
+  }
+
+  // Reversed and complex elements
+  nd::array e = nd::empty(2, 3, ndt::make_type<dynd::complex<double>>());
+  dynd::complex<double> *e_data = reinterpret_cast<dynd::complex<double> *>(e.data());
+  for (intptr_t i = 0; i < 6; ++i) {
+    e_data[i] = dynd::complex<double>(static_cast<double>(i), -static_cast<double>(i));
+  }
+  nd::array e_copy = nd::copy(e(irange(), irange().by(-1)).transpose());
+  const dynd::complex<double> *e_copy_data = reinterpret_cast<const dynd::complex<double> *>(e_copy.cdata());
+  for (intptr_t i = 0; i < 3; ++i) {
+    for (intptr_t j = 0; j < 2; ++j) {
+      EXPECT_EQ(e_data[j * 3 + 2 - i], e_copy_data[i * 2 + j]);
+    }
+  }
+
+  // Split across threads
+  nd::array f = nd::empty(1100, 1000, "float64");
+  double *f_data = reinterpret_cast<double *>(f.data());
+  for (intptr_t i = 0; i < 1100 * 1000; ++i) {
+    f_data[i] = static_cast<double>(i);
+  }
+  nd::array g = nd::parallel_copy(4)(f.transpose());
+  const double *g_data = reinterpret_cast<const double *>(g.cdata());
+  for (intptr_t i = 0; i < 1000; ++i) {
+    for (intptr_t j = 0; j < 1100; ++j) {
+      ASSERT_EQ(f_data[j * 1000 + i], g_data[i * 1100 + j]);
+    }
+  }
+
+  EXPECT_THROW(nd::parallel_copy(0), invalid_argument);
+}
+
+TEST(ArrayAssign, BulkCopy) {
+  // POD elements of an odd size, contiguous and transposed
+  nd::array a = nd::empty(4, 5, ndt::make_type<ndt::fixed_bytes_type>(3, 1));
+  char *a_data = a.data();
+  for (intptr_t i = 0; i < 4 * 5 * 3; ++i) {
+    a_data[i] = static_cast<char>(i);
+  }
+  nd::array b = nd::copy(a);
+  EXPECT_EQ(a.get_type(), b.get_type());
+  EXPECT_EQ(0, memcmp(a_data, b.cdata(), 4 * 5 * 3));
+  b = nd::copy(a.transpose());
+  EXPECT_EQ(ndt::type("5 * 4 * fixed_bytes[3]"), b.get_type());
+  for (intptr_t i = 0; i < 5; ++i) {
+    for (intptr_t j = 0; j < 4; ++j) {
+      EXPECT_EQ(0, memcmp(a_data + (j * 5 + i) * 3, b.cdata() + (i * 4 + j) * 3, 3));
+    }
+  }
+
+  // Large enough to be streamed and split across threads
+  const intptr_t n = 1 << 23;
+  nd::array c = nd::empty(2, n, "int32");
+  int32_t *c_data = reinterpret_cast<int32_t *>(c.data());
+  for (intptr_t i = 0; i < 2 * n; ++i) {
+    c_data[i] = static_cast<int32_t>(i);
+  }
+  for (intptr_t thread_count : {1, 3}) {
+    nd::array d = nd::parallel_copy(thread_count)(c);
+    const int32_t *d_data = reinterpret_cast<const int32_t *>(d.cdata());
+    for (intptr_t i = 0; i < 2 * n; ++i) {
+      ASSERT_EQ(static_cast<int32_t>(i), d_data[i]);
+    }
+  }
+
+  nd::bulk_copy(c.data() + 1, c.cdata() + 4 * n + 3, 4 * n - 5, 2);
+  EXPECT_EQ(0, memcmp(c.cdata() + 1, c.cdata() + 4 * n + 3, 4 * n - 5));
+}
+
 #if !(defined(_WIN32) && !defined(_M_X64)) // TODO: How to mark as expected failures in googletest?
 REGISTER_TYPED_TEST_CASE_P(ArrayAssign, ScalarAssignment_Bool, ScalarAssignment_Int8, ScalarAssignment_UInt16,
                            ScalarAssignment_Float32, ScalarAssignment_Float64, ScalarAssignment_Uint64,
@@ -11,6 +11,7 @@
 #include <dynd/array.hpp>
 #include <dynd/array_range.hpp>
 #include <dynd/gtest.hpp>
+#include <dynd/json_parser.hpp>
 #include <dynd/random.hpp>
 #include <dynd/types/fixed_bytes_type.hpp>
 
@@ -299,3 +300,102 @@ TEST(ArrayViews, Reshape) {
                                                  {24}));
 }
 #endif // DYND_NESTED_INIT_LIST_BUG
+
+TEST(ArrayViews, ReshapeStrided) {
+  nd::array a = nd::reshape(nd::old_range(24), {4, 6});
+
+  // Splitting a dimension of a transposed array keeps a view
+  nd::array t = a.transpose();
+  nd::array b = nd::reshape(t, {6, 2, 2});
+  EXPECT_EQ(t.cdata(), b.cdata());
+  for (int i = 0; i < 6; ++i) {
+    for (int j = 0; j < 2; ++j) {
+      for (int k = 0; k < 2; ++k) {
+        EXPECT_EQ((j * 2 + k) * 6 + i, b(i, j, k).as<int>());
+      }
+    }
+  }
+
+  // Merging its dimensions needs a copy
+  nd::array c = nd::reshape(t, {24});
+  EXPECT_NE(t.cdata(), c.cdata());
+  for (int i = 0; i < 24; ++i) {
+    EXPECT_EQ(i % 4 * 6 + i / 4, c(i).as<int>());
+  }
+
+  nd::array d = nd::old_range(10)(irange().by(2));
+  EXPECT_ARRAY_EQ(parse_json("1 * 5 * int32", "[[0, 2, 4, 6, 8]]"), nd::reshape(d, {1, 5}));
+  EXPECT_EQ(d.cdata(), nd::reshape(d, {1, 5}).cdata());
+
+  EXPECT_EQ(ndt::type("2 * 4 * 3 * int32"), nd::reshape(a, {2, -1, 3}).get_type());
+  EXPECT_THROW(nd::reshape(a, {-1, -1}), invalid_argument);
+  EXPECT_THROW(nd::reshape(a, {5, -1}), invalid_argument);
+  EXPECT_THROW(nd::reshape(a, {5, 5}), invalid_argument);
+}
+
+TEST(ArrayViews, ReshapeVar) {
+  nd::array a = parse_json("3 * var * int32", "[[1, 2], [], [3, 4, 5, 6]]");
+  EXPECT_ARRAY_EQ(parse_json("2 * 3 * int32", "[[1, 2, 3], [4, 5, 6]]"), nd::reshape(a, {2, 3}));
+  EXPECT_ARRAY_EQ(parse_json("6 * int32", "[1, 2, 3, 4, 5, 6]"), nd::reshape(a, {-1}));
+  EXPECT_THROW(nd::reshape(a, {4, 2}), invalid_argument);
+}
+
+TEST(ArrayViews, Columnar) {
+  nd::array a = nd::empty(ndt::type("5 * {x: int32, y: float64, z: string}"));
+  for (int i = 0; i < 5; ++i) {
+    a(i, 0).vals() = i;
+    a(i, 1).vals() = i + 0.5;
+    a(i, 2).vals() = "s" + std::to_string(i);
+  }
+
+  nd::array c = nd::to_columnar(a);
+  EXPECT_EQ(ndt::type("{x: 5 * int32, y: 5 * float64, z: 5 * string}"), c.get_type());
+
+  // Each field is a unit-stride fixed dimension array
+  EXPECT_EQ(static_cast<intptr_t>(sizeof(int32)),
+            reinterpret_cast<const fixed_dim_type_arrmeta *>(c(0)->metadata())->stride);
+  EXPECT_EQ(static_cast<intptr_t>(sizeof(double)),
+            reinterpret_cast<const fixed_dim_type_arrmeta *>(c(1)->metadata())->stride);
+  EXPECT_ARRAY_EQ(nd::array({0, 1, 2, 3, 4}), c(0));
+  EXPECT_ARRAY_EQ(nd::array({0.5, 1.5, 2.5, 3.5, 4.5}), c(1));
+  EXPECT_EQ("s3", c(2)(3).as<std::string>());
+
+  nd::array b = nd::from_columnar(c);
+  EXPECT_EQ(a.get_type(), b.get_type());
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(i, b(i, 0).as<int32>());
+    EXPECT_EQ(i + 0.5, b(i, 1).as<double>());
+    EXPECT_EQ("s" + std::to_string(i), b(i, 2).as<std::string>());
+  }
+
+  EXPECT_THROW(nd::to_columnar(nd::empty(ndt::type("5 * int32"))), type_error);
+  EXPECT_THROW(nd::from_columnar(nd::empty(ndt::type("{x: 3 * int32, y: 4 * int32}"))), invalid_argument);
+}
+
+TEST(ArrayViews, Ragged) {
+  nd::array a = parse_json("4 * var * float64", "[[1, 2.5], [], [3, 4, 5], [6]]");
+
+  nd::array r = nd::to_ragged(a);
+  EXPECT_EQ(ndt::type("{values: 6 * float64, offsets: 5 * int64}"), r.get_type());
+  EXPECT_ARRAY_EQ(nd::array({1.0, 2.5, 3.0, 4.0, 5.0, 6.0}), r(0));
+  EXPECT_EQ(2, r(1)(2).as<int64_t>());
+  EXPECT_EQ(6, r(1)(4).as<int64_t>());
+
+  // The rows of the result are adjacent slices of the values
+  nd::array b = nd::from_ragged(r);
+  EXPECT_EQ(a.get_type(), b.get_type());
+  EXPECT_EQ(0, b(1).get_dim_size());
+  EXPECT_EQ(4.0, b(2, 1).as<double>());
+  const ndt::var_dim_type::data_type *rows = reinterpret_cast<const ndt::var_dim_type::data_type *>(b.cdata());
+  EXPECT_EQ(r(0).cdata(), rows[0].begin);
+  EXPECT_EQ(rows[0].begin + 5 * sizeof(double), rows[3].begin);
+
+  nd::array s = nd::to_ragged(parse_json("2 * var * string", "[[\"x\", \"yz\"], [\"w\"]]"));
+  EXPECT_EQ("w", s(0)(2).as<std::string>());
+  EXPECT_EQ("x", nd::from_ragged(s)(0, 0).as<std::string>());
+
+  EXPECT_THROW(nd::to_ragged(nd::empty(ndt::type("5 * int32"))), type_error);
+  nd::array bad = nd::empty(ndt::type("{values: 3 * int32, offsets: 3 * int64}"));
+  bad(1).vals() = {0, 2, 4};
+  EXPECT_THROW(nd::from_ragged(bad), invalid_argument);
+}
@@ -0,0 +1,105 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <cstdlib>
+
+#include <dynd/array.hpp>
+#include <dynd/gtest.hpp>
+#include <dynd/memblock/buffer_allocator.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+
+class counting_allocator : public nd::buffer_allocator {
+public:
+  int allocated, deallocated;
+
+  counting_allocator() : allocated(0), deallocated(0) {}
+
+  void *allocate(size_t size, size_t alignment) {
+    ++allocated;
+    return nd::get_default_buffer_allocator()->allocate(size, alignment);
+  }
+
+  void deallocate(void *ptr, size_t size, size_t alignment) {
+    ++deallocated;
+    nd::get_default_buffer_allocator()->deallocate(ptr, size, alignment);
+  }
+};
+
+} // anonymous namespace
+
+TEST(BufferAllocator, Stats) {
+  nd::buffer_allocation_stats before = nd::get_buffer_allocation_stats();
+  {
+    nd::array a = nd::empty(ndt::make_type<int32_t>());
+    nd::buffer_allocation_stats during = nd::get_buffer_allocation_stats();
+    EXPECT_EQ(before.allocation_count + 1, during.allocation_count);
+    EXPECT_LT(before.bytes_in_use, during.bytes_in_use);
+  }
+  EXPECT_EQ(before.bytes_in_use, nd::get_buffer_allocation_stats().bytes_in_use);
+
+  // A freed small block is reused by the next allocation of its size class
+  before = nd::get_buffer_allocation_stats();
+  nd::empty(ndt::make_type<int32_t>());
+  EXPECT_EQ(before.cached_count + 1, nd::get_buffer_allocation_stats().cached_count);
+}
+
+TEST(BufferAllocator, Custom) {
+  counting_allocator allocator;
+  nd::set_buffer_allocator(&allocator);
+  nd::array a = nd::empty(ndt::make_type<double>());
+  nd::set_buffer_allocator(nullptr);
+  a.assign(1.5);
+  EXPECT_EQ(nd::get_default_buffer_allocator(), nd::get_buffer_allocator());
+
+  // The array is still freed through the allocator that allocated it
+  nd::array b = nd::empty(ndt::make_type<double>());
+  EXPECT_EQ(1, allocator.allocated);
+  EXPECT_EQ(1.5, a.as<double>());
+  a = b;
+  EXPECT_EQ(1, allocator.deallocated);
+}
+
+TEST(BufferAllocator, LargeAlignment) {
+  nd::buffer_allocation_stats before = nd::get_buffer_allocation_stats();
+  nd::array a = nd::empty(100000, ndt::make_type<uint8_t>());
+  EXPECT_EQ(before.large_count + 1, nd::get_buffer_allocation_stats().large_count);
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(a.cdata()) % nd::large_buffer_alignment);
+
+  nd::array b = nd::empty(3, ndt::make_type<uint8_t>());
+  EXPECT_EQ(before.large_count + 1, nd::get_buffer_allocation_stats().large_count);
+}
+
+TEST(BufferAllocator, HugePages) {
+  const size_t size = size_t(3) << 20, huge_page_size = size_t(1) << 21;
+  nd::buffer_allocator *allocator = nd::get_default_buffer_allocator();
+
+  // Without huge pages, large blocks only get the alignment they ask for. Any
+  // one of them may land on a 2MB boundary by chance, but not all of them
+  void *ptrs[4];
+  int huge_aligned = 0;
+  for (void *&ptr : ptrs) {
+    ptr = allocator->allocate(size, nd::large_buffer_alignment);
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(ptr) % nd::large_buffer_alignment);
+    huge_aligned += reinterpret_cast<uintptr_t>(ptr) % huge_page_size == 0;
+  }
+  EXPECT_LT(huge_aligned, 4);
+  for (void *ptr : ptrs) {
+    allocator->deallocate(ptr, size, nd::large_buffer_alignment);
+  }
+
+  nd::set_huge_pages(true);
+  for (void *&ptr : ptrs) {
+    ptr = allocator->allocate(size, nd::large_buffer_alignment);
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(ptr) % huge_page_size);
+  }
+  nd::set_huge_pages(false);
+  for (void *ptr : ptrs) {
+    allocator->deallocate(ptr, size, nd::large_buffer_alignment);
+  }
+}
@@ -0,0 +1,105 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include <dynd/csv_parser.hpp>
+#include <dynd/gtest.hpp>
+#include <dynd/option.hpp>
+#include <dynd/types/option_type.hpp>
+#include <dynd/types/string_type.hpp>
+#include <dynd/types/struct_type.hpp>
+
+using namespace std;
+using namespace dynd;
+
+TEST(CSVParser, Basic) {
+  nd::array a =
+      nd::csv::parse("1,2.5,abc\n-3,4,\"x,\"\"y\"\"\"\r\n\n7,1e3,z", ndt::type("{a: int32, b: float64, c: string}"));
+  EXPECT_EQ(ndt::type("3 * {a: int32, b: float64, c: string}"), a.get_type());
+  EXPECT_EQ(1, a(0, 0).as<int>());
+  EXPECT_EQ(2.5, a(0, 1).as<double>());
+  EXPECT_EQ("abc", a(0, 2).as<std::string>());
+  EXPECT_EQ(-3, a(1, 0).as<int>());
+  EXPECT_EQ("x,\"y\"", a(1, 2).as<std::string>());
+  EXPECT_EQ(7, a(2, 0).as<int>());
+  EXPECT_EQ(1000.0, a(2, 1).as<double>());
+  EXPECT_EQ("z", a(2, 2).as<std::string>());
+}
+
+TEST(CSVParser, Options) {
+  nd::csv::options opts;
+  opts.delimiter = '\t';
+  opts.header = true;
+  opts.columnar = true;
+  nd::array a = nd::csv::parse("a\tb\tc\n1\t\ttrue\n\t\"multi\nline\"\tfalse\n",
+                               ndt::type("{a: ?int64, b: ?string, c: bool}"), opts);
+  EXPECT_EQ(ndt::type("{a: 2 * ?int64, b: 2 * ?string, c: 2 * bool}"), a.get_type());
+  EXPECT_EQ(1, a(0, 0).as<int64_t>());
+  EXPECT_TRUE(nd::is_na(a(0, 1)).as<bool>());
+  EXPECT_EQ(0u, reinterpret_cast<const dynd::string *>(a(1, 0).cdata())->size());
+  EXPECT_EQ("multi\nline", a(1, 1).as<std::string>());
+  EXPECT_TRUE(a(2, 0).as<bool>());
+  EXPECT_FALSE(a(2, 1).as<bool>());
+}
+
+TEST(CSVParser, Threads) {
+  std::string text;
+  for (int i = 0; i < 10000; ++i) {
+    text += std::to_string(i) + ",\"" + std::to_string(2 * i) + "\"\n";
+  }
+
+  nd::csv::options opts;
+  opts.thread_count = 4;
+  nd::array a = nd::csv::parse(text, ndt::type("{x: int32, y: string}"), opts);
+  ASSERT_EQ(10000, a.get_dim_size());
+  for (int i = 0; i < 10000; i += 997) {
+    EXPECT_EQ(i, a(i, 0).as<int>());
+    EXPECT_EQ(std::to_string(2 * i), a(i, 1).as<std::string>());
+  }
+  EXPECT_EQ(9999, a(9999, 0).as<int>());
+}
+
+TEST(CSVParser, Stream) {
+  std::string text = "x,y\n";
+  for (int i = 0; i < 100; ++i) {
+    text += std::to_string(i) + ",\"" + std::string(i % 30, 'q') + "\"\n";
+  }
+  std::istringstream in(text);
+
+  nd::csv::options opts;
+  opts.header = true;
+  opts.buffer_size = 16;
+  int count = 0;
+  nd::csv::read(in, ndt::type("{x: int16, y: string}"), [&](const nd::array &a) {
+    for (intptr_t i = 0; i < a.get_dim_size(); ++i, ++count) {
+      EXPECT_EQ(count, a(i, 0).as<int>());
+      EXPECT_EQ(std::string(count % 30, 'q'), a(i, 1).as<std::string>());
+    }
+  }, opts);
+  EXPECT_EQ(100, count);
+}
+
+TEST(CSVParser, Errors) {
+  EXPECT_THROW(nd::csv::parse("1", ndt::type("int32")), type_error);
+  EXPECT_THROW(nd::csv::parse("1", ndt::type("{a: ?uint32}")), type_error);
+  EXPECT_THROW(nd::csv::parse("1,2\n3", ndt::type("{a: int32, b: int32}")), csv_parse_error);
+  EXPECT_THROW(nd::csv::parse("1,2,3", ndt::type("{a: int32, b: int32}")), csv_parse_error);
+  EXPECT_THROW(nd::csv::parse("\"1,2", ndt::type("{a: string, b: int32}")), csv_parse_error);
+
+  try {
+    nd::csv::parse("a\n1\nx\n", ndt::type("{a: int8}"), [] {
+      nd::csv::options opts;
+      opts.header = true;
+      return opts;
+    }());
+    FAIL() << "expected a csv_parse_error";
+  }
+  catch (const csv_parse_error &e) {
+    EXPECT_EQ(3, e.get_record());
+  }
+}
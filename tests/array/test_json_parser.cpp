@@ -108,6 +108,47 @@ TEST(JSONParser, BuiltinsFromFloat) {
   EXPECT_EQ(1.5e2, n.as<double>());
 }
 
+TEST(JSONParser, FloatRounding) {
+  // Values that need correct rounding, including ties, subnormals and more
+  // digits than fit in 64 bits
+  EXPECT_EQ(0.1, parse_json(ndt::make_type<double>(), "0.1").as<double>());
+  EXPECT_EQ(9007199254740992., parse_json(ndt::make_type<double>(), "9007199254740993").as<double>());
+  EXPECT_EQ(1.7976931348623157e308, parse_json(ndt::make_type<double>(), "1.7976931348623157e308").as<double>());
+  EXPECT_EQ(2.2250738585072014e-308, parse_json(ndt::make_type<double>(), "2.2250738585072014e-308").as<double>());
+  EXPECT_EQ(4.9406564584124654e-324, parse_json(ndt::make_type<double>(), "4.9e-324").as<double>());
+  EXPECT_EQ(0., parse_json(ndt::make_type<double>(), "2.4703282292062327e-324").as<double>());
+  EXPECT_EQ(4.9406564584124654e-324, parse_json(ndt::make_type<double>(), "2.4703282292062328e-324").as<double>());
+  EXPECT_EQ(1.234567890123456789012e-30,
+            parse_json(ndt::make_type<double>(), "0.000000000000000000000000000001234567890123456789012").as<double>());
+  EXPECT_EQ(std::numeric_limits<double>::infinity(), parse_json(ndt::make_type<double>(), "1e309").as<double>());
+  EXPECT_EQ(-0., parse_json(ndt::make_type<double>(), "-0").as<double>());
+  EXPECT_TRUE(std::signbit(parse_json(ndt::make_type<double>(), "-0").as<double>()));
+  EXPECT_EQ(1.00000005960464477550f, parse_json(ndt::make_type<float>(), "1.00000005960464477550").as<float>());
+  EXPECT_EQ(3.40282347e38f, parse_json(ndt::make_type<float>(), "3.4028235e38").as<float>());
+
+  // The range doesn't need to be NUL-terminated
+  const char digits[] = {'1', '.', '2', '5', '7'};
+  double value;
+  EXPECT_TRUE(parse_float(digits, digits + 4, value));
+  EXPECT_EQ(1.25, value);
+  EXPECT_TRUE(parse_float(digits, digits + 1, value));
+  EXPECT_EQ(1., value);
+  EXPECT_FALSE(parse_float(digits + 1, digits + 1, value));
+  EXPECT_FALSE(parse_float("1e", "1e" + 2, value));
+  EXPECT_FALSE(parse_float("1.5x", "1.5x" + 4, value));
+
+  // Without checking, input that isn't a number keeps the number it starts with
+  EXPECT_EQ(1.5, parse<double>(std::string("1.5x"), nocheck));
+  EXPECT_EQ(-2.5e3, parse<double>(std::string("  -2.5e3 apples"), nocheck));
+  EXPECT_EQ(12., parse<double>(std::string("12e"), nocheck));
+  EXPECT_EQ(0.25f, parse<float>(std::string("0.25.5"), nocheck));
+  EXPECT_EQ(0., parse<double>(std::string("x1.5"), nocheck));
+  EXPECT_EQ(0., parse<double>(std::string(""), nocheck));
+  EXPECT_TRUE(parse_float_prefix("1.5e+x", "1.5e+x" + 6, value));
+  EXPECT_EQ(1.5, value);
+  EXPECT_FALSE(parse_float_prefix("-.e1", "-.e1" + 4, value));
+}
+
 TEST(JSONParser, Struct) {
   nd::array n;
   ndt::type sdt = ndt::make_type<ndt::struct_type>({{ndt::make_type<int>(), "id"},
@@ -218,6 +218,53 @@ TEST(Elwise, Binary_FixedDim) {
   EXPECT_ARRAY_EQ((nd::array{3, 5, 7}), f({{0, 1, 2}, {3, 4, 5}}, {}));
 }
 
+TEST(Elwise, Binary_CoalescedFixedDims) {
+  nd::callable f = nd::functional::elwise(nd::functional::apply([](int x, int y) { return 100 * x + y; }));
+
+  nd::array a = nd::empty(3, 4, 5, ndt::make_type<int>());
+  nd::array b = nd::empty(5, 4, 3, ndt::make_type<int>());
+  for (int i = 0; i < 60; ++i) {
+    reinterpret_cast<int *>(a.data())[i] = i;
+    reinterpret_cast<int *>(b.data())[i] = 2 * i;
+  }
+
+  // Contiguous operands, transposed operands, and strided views
+  nd::array res = f(a, a);
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      for (int k = 0; k < 5; ++k) {
+        EXPECT_EQ(101 * (20 * i + 5 * j + k), res(i, j, k).as<int>());
+      }
+    }
+  }
+
+  res = f(a.transpose(), b);
+  EXPECT_EQ(ndt::type("5 * 4 * 3 * int32"), res.get_type());
+  for (int i = 0; i < 5; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      for (int k = 0; k < 3; ++k) {
+        EXPECT_EQ(100 * (20 * k + 5 * j + i) + 2 * (12 * i + 3 * j + k), res(i, j, k).as<int>());
+      }
+    }
+  }
+
+  res = f(a(irange().by(2), irange(), irange().by(2)), b(irange().by(2), irange(), irange().by(2)).transpose());
+  EXPECT_EQ(ndt::type("2 * 4 * 3 * int32"), res.get_type());
+  for (int i = 0; i < 2; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      for (int k = 0; k < 3; ++k) {
+        EXPECT_EQ(100 * (40 * i + 5 * j + 2 * k) + 2 * (24 * k + 3 * j + 2 * i), res(i, j, k).as<int>());
+      }
+    }
+  }
+
+  // Dimensions of size one and missing dimensions broadcast
+  EXPECT_ARRAY_EQ(parse_json("2 * 3 * 2 * int32", "[[[101, 202], [103, 204], [105, 206]],"
+                                                  "[[301, 402], [303, 404], [305, 406]]]"),
+                  f(parse_json("2 * 1 * 2 * int32", "[[[1, 2]], [[3, 4]]]"),
+                    parse_json("3 * 2 * int32", "[[1, 2], [3, 4], [5, 6]]")));
+}
+
 /*
 // TODO Reenable once there's a convenient way to make the binary callable
 TEST(LiftCallable, Expr_MultiDimVarToVarDim) {
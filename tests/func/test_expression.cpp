@@ -0,0 +1,62 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <stdexcept>
+
+#include <dynd/arithmetic.hpp>
+#include <dynd/expression.hpp>
+#include <dynd/gtest.hpp>
+#include <dynd/index.hpp>
+#include <dynd/json_parser.hpp>
+
+using namespace std;
+using namespace dynd;
+
+TEST(Expression, Arithmetic) {
+  nd::array a{1.0, 2.0, 3.0}, b{4.0, 5.0, 6.0}, c{7.0, 8.0, 9.0}, d{1.0, 0.5, 0.25}, e{0.5, 0.5, 0.5};
+
+  EXPECT_ARRAY_EQ(a * b + c * d - e, (nd::lazy(a) * b + nd::lazy(c) * d - e).eval());
+  EXPECT_ARRAY_EQ(-a / b, (-nd::lazy(a) / b).eval());
+  EXPECT_ARRAY_EQ(a * a, (nd::lazy(a) * a).eval());
+  EXPECT_ARRAY_EQ(a, nd::lazy(a).eval());
+}
+
+TEST(Expression, Broadcast) {
+  nd::array a = parse_json("2 * 3 * int32", "[[1, 2, 3], [4, 5, 6]]");
+  nd::array b = parse_json("3 * int32", "[10, 20, 30]");
+
+  // A subexpression used twice is evaluated once
+  nd::expression x = nd::lazy(a) + b;
+  EXPECT_ARRAY_EQ(parse_json("2 * 3 * int32", "[[121, 484, 1089], [196, 625, 1296]]"), (x * x).eval());
+
+  EXPECT_ARRAY_EQ(nd::array(12), (nd::lazy(nd::array(3)) * 4).eval());
+}
+
+TEST(Expression, Blocks) {
+  // Long enough for several blocks, and a strided view
+  intptr_t size = 1000;
+  nd::array a = nd::empty(size, ndt::make_type<double>());
+  nd::array b = nd::empty(size, ndt::make_type<double>());
+  for (intptr_t i = 0; i < size; ++i) {
+    reinterpret_cast<double *>(a.data())[i] = static_cast<double>(i);
+    reinterpret_cast<double *>(b.data())[i] = static_cast<double>(size - i);
+  }
+
+  EXPECT_ARRAY_EQ(a * b - a / b, (nd::lazy(a) * b - nd::lazy(a) / b).eval());
+
+  nd::array c = a(irange().by(3));
+  EXPECT_ARRAY_EQ(c * c + c, (nd::lazy(c) * c + c).eval());
+}
+
+TEST(Expression, Compile) {
+  nd::array a{1, 2, 3}, b{4, 5, 6};
+
+  vector<nd::array> args;
+  nd::callable f = (nd::lazy(a) * b + a).compile(args);
+  ASSERT_EQ(2u, args.size());
+  EXPECT_ARRAY_EQ((nd::array{5, 12, 21}), f(a, b));
+  EXPECT_ARRAY_EQ((nd::array{2, 2, 2}), f(nd::array{1, 1, 1}, nd::array{1, 1, 1}));
+}
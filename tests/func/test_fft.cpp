@@ -3,20 +3,194 @@
 // BSD 2-Clause License, see LICENSE.txt
 //
 
-#include <iostream>
-#include <stdexcept>
 #include <algorithm>
 #include <cmath>
-
-#include "inc_gtest.hpp"
-#include "dynd_assertions.hpp"
+#include <complex>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
 
 #include <dynd/fft.hpp>
+#include <dynd/gtest.hpp>
+#include <dynd/kernels/batched_fft_kernel.hpp>
 #include <dynd/random.hpp>
 
 using namespace std;
 using namespace dynd;
 
+namespace {
+
+// An m x n complex[float64] array of arbitrary values, which are also stored row-major in ``values``
+nd::array make_signal(intptr_t m, intptr_t n, vector<std::complex<double>> &values) {
+  nd::array a = nd::empty(m, n, ndt::make_type<dynd::complex<double>>());
+  values.resize(m * n);
+  for (intptr_t i = 0; i < m * n; ++i) {
+    values[i] = std::complex<double>(std::sin(0.37 * i) + 0.5, static_cast<double>((i * 7919) % 23) / 11.0 - 1.0);
+  }
+  memcpy(a.data(), values.data(), values.size() * sizeof(dynd::complex<double>));
+
+  return a;
+}
+
+// The direct O(n^2) transform of the ``count`` sequences of length n at ``x + i * stride``, with
+// consecutive elements ``step`` apart
+vector<std::complex<double>> dft(const std::complex<double> *x, intptr_t n, intptr_t count, intptr_t stride, int sign,
+                                 intptr_t step = 1) {
+  const double pi = 3.14159265358979323846;
+  vector<std::complex<double>> y(n * count);
+  for (intptr_t i = 0; i < count; ++i) {
+    for (intptr_t k = 0; k < n; ++k) {
+      for (intptr_t j = 0; j < n; ++j) {
+        double theta = sign * 2 * pi * static_cast<double>((j * k) % n) / n;
+        y[i * n + k] += x[i * stride + j * step] * std::polar(1.0, theta);
+      }
+    }
+  }
+
+  return y;
+}
+
+template <typename T>
+void expect_near(const vector<std::complex<double>> &expected, const nd::array &actual, double tolerance) {
+  ASSERT_EQ(ndt::make_type<dynd::complex<T>>(), actual.get_dtype());
+  const T *actual_data = reinterpret_cast<const T *>(actual.cdata());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    ASSERT_NEAR(expected[i].real(), actual_data[2 * i], tolerance) << "at " << i;
+    ASSERT_NEAR(expected[i].imag(), actual_data[2 * i + 1], tolerance) << "at " << i;
+  }
+}
+
+} // unnamed namespace
+
+TEST(FFT, Simple) {
+  nd::array x = nd::empty(4, ndt::make_type<dynd::complex<double>>());
+  x.assign(nd::array{1.0, 0.0, 0.0, 0.0});
+  expect_near<double>({1.0, 1.0, 1.0, 1.0}, nd::fft(x), 0.0);
+
+  x.assign(nd::array{1.0, 2.0, 3.0, 4.0});
+  nd::array y = nd::fft(x);
+  EXPECT_EQ(ndt::type("4 * complex[float64]"), y.get_type());
+  expect_near<double>({{10.0, 0.0}, {-2.0, 2.0}, {-2.0, 0.0}, {-2.0, -2.0}}, y, 1e-12);
+
+  y = nd::rfft(nd::array{1.0, 2.0, 3.0, 4.0});
+  EXPECT_EQ(ndt::type("3 * complex[float64]"), y.get_type());
+  expect_near<double>({{10.0, 0.0}, {-2.0, 2.0}, {-2.0, 0.0}}, y, 1e-12);
+}
+
+TEST(FFT, Lengths) {
+  // Powers of two, mixed radices and primes, with the ones from 127 on through Bluestein's algorithm
+  for (intptr_t n : {1, 2, 8, 12, 17, 30, 64, 99, 127, 203, 256, 262, 1009}) {
+    vector<std::complex<double>> values;
+    nd::array x = make_signal(3, n, values);
+    expect_near<double>(dft(values.data(), n, 3, n, -1), nd::fft({x}, {{"axes", {1}}}), 1e-9 * n);
+    expect_near<double>(dft(values.data(), n, 3, n, 1), nd::ifft({x}, {{"axes", {1}}}), 1e-9 * n);
+  }
+}
+
+TEST(FFT, PlanCache) {
+  shared_ptr<const nd::detail::fft_plan<double>> plan = nd::detail::get_fft_plan<double>(100, -1);
+  EXPECT_EQ(plan, nd::detail::get_fft_plan<double>(100, -1));
+  EXPECT_NE(plan, nd::detail::get_fft_plan<double>(100, 1));
+
+  // A plan in steady use stays cached while many others come and go
+  for (intptr_t n = 1; n <= 200; ++n) {
+    nd::detail::get_fft_plan<double>(1000 + n, -1);
+    EXPECT_EQ(plan, nd::detail::get_fft_plan<double>(100, -1));
+  }
+}
+
+TEST(FFT, Axes) {
+  vector<std::complex<double>> values;
+  nd::array x = make_signal(6, 10, values);
+
+  // Along the leading axis, as a batch of strided columns
+  nd::array y = nd::fft({x}, {{"axes", {0}}});
+  nd::array y_t = nd::fft({x.transpose()}, {{"axes", {1}}});
+  for (intptr_t j = 0; j < 10; ++j) {
+    vector<std::complex<double>> expected = dft(values.data() + j, 6, 1, 0, -1, 10);
+    for (intptr_t i = 0; i < 6; ++i) {
+      EXPECT_NEAR(expected[i].real(), y(i, j).as<dynd::complex<double>>().real(), 1e-9);
+      EXPECT_NEAR(expected[i].imag(), y_t(j, i).as<dynd::complex<double>>().imag(), 1e-9);
+    }
+  }
+
+  // Along both axes, in either order, and back
+  y = nd::fft(x);
+  EXPECT_EQ(ndt::type("6 * 10 * complex[float64]"), y.get_type());
+  vector<std::complex<double>> rows = dft(values.data(), 10, 6, 10, -1);
+  vector<std::complex<double>> expected(60);
+  for (intptr_t j = 0; j < 10; ++j) {
+    vector<std::complex<double>> column = dft(rows.data() + j, 6, 1, 0, -1, 10);
+    for (intptr_t i = 0; i < 6; ++i) {
+      expected[i * 10 + j] = column[i];
+    }
+  }
+  expect_near<double>(expected, y, 1e-9);
+  expect_near<double>(expected, nd::fft({x}, {{"axes", {-1, 0}}}), 1e-9);
+  expect_near<double>(values, nd::ifft({y}, {{"scale", 1.0 / 60}}), 1e-12);
+
+  EXPECT_THROW(nd::fft({x}, {{"axes", {2}}}), invalid_argument);
+  EXPECT_THROW(nd::fft({x}, {{"axes", {1, -1}}}), invalid_argument);
+}
+
+TEST(FFT, Real) {
+  for (intptr_t n : {1, 6, 15, 64, 127}) {
+    // An odd number of rows leaves one of them without a partner
+    nd::array x = nd::empty(5, n, ndt::make_type<double>());
+    vector<std::complex<double>> values(5 * n);
+    double *x_data = reinterpret_cast<double *>(x.data());
+    for (intptr_t i = 0; i < 5 * n; ++i) {
+      x_data[i] = std::cos(0.91 * i) - 0.25;
+      values[i] = x_data[i];
+    }
+
+    nd::array y = nd::rfft({x}, {{"axes", {1}}});
+    EXPECT_EQ(ndt::make_fixed_dim(5, ndt::make_fixed_dim(n / 2 + 1, ndt::make_type<dynd::complex<double>>())),
+              y.get_type());
+    vector<std::complex<double>> spectrum = dft(values.data(), n, 5, n, -1);
+    for (intptr_t i = 0; i < 5; ++i) {
+      for (intptr_t k = 0; k <= n / 2; ++k) {
+        dynd::complex<double> actual = y(i, k).as<dynd::complex<double>>();
+        EXPECT_NEAR(spectrum[i * n + k].real(), actual.real(), 1e-9 * n);
+        EXPECT_NEAR(spectrum[i * n + k].imag(), actual.imag(), 1e-9 * n);
+      }
+    }
+  }
+
+  // float32 values, with the half spectrum along the leading axis
+  nd::array x = nd::empty(8, 3, ndt::make_type<float>());
+  float *x_data = reinterpret_cast<float *>(x.data());
+  for (intptr_t i = 0; i < 24; ++i) {
+    x_data[i] = static_cast<float>(i % 5);
+  }
+  nd::array y = nd::rfft({x}, {{"axes", {0}}});
+  EXPECT_EQ(ndt::type("5 * 3 * complex[float32]"), y.get_type());
+  nd::array z = nd::fft({nd::empty(8, 3, ndt::make_type<dynd::complex<float>>()).assign(x)}, {{"axes", {0}}});
+  const float *y_data = reinterpret_cast<const float *>(y.cdata());
+  const float *z_data = reinterpret_cast<const float *>(z.cdata());
+  for (intptr_t i = 0; i < 5 * 3 * 2; ++i) {
+    EXPECT_NEAR(z_data[i], y_data[i], 1e-4f);
+  }
+
+  EXPECT_THROW(nd::rfft(nd::empty(4, ndt::make_type<dynd::complex<double>>())), type_error);
+  EXPECT_THROW(nd::fft(nd::array{1, 2}), type_error);
+}
+
+TEST(FFT, Parallel) {
+  vector<std::complex<double>> values;
+  nd::array x = make_signal(1000, 64, values);
+  nd::array expected = nd::fft({x}, {{"axes", {1}}});
+  for (intptr_t thread_count : {1, 3}) {
+    nd::array y = nd::parallel_fft(thread_count)({x}, {{"axes", {1}}});
+    EXPECT_EQ(0, memcmp(expected.cdata(), y.cdata(), 1000 * 64 * sizeof(dynd::complex<double>)));
+  }
+  expect_near<double>(values, nd::parallel_ifft(2)({expected}, {{"axes", {1}}, {"scale", 1.0 / 64}}), 1e-12);
+
+  EXPECT_THROW(nd::parallel_fft(0), invalid_argument);
+  EXPECT_THROW(nd::parallel_rfft(-1), invalid_argument);
+}
+
 #ifdef DYND_FFTW
 
 class FFT1D : public ::testing::TestWithParam<std::tr1::tuple<const char *, const char *, const char *>> {
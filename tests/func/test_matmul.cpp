@@ -0,0 +1,129 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include <dynd/gtest.hpp>
+#include <dynd/index.hpp>
+#include <dynd/json_parser.hpp>
+#include <dynd/linalg.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+
+// An m x n float64 matrix of arbitrary values, which are also stored row-major in ``values``
+nd::array make_matrix(intptr_t m, intptr_t n, vector<double> &values) {
+  nd::array a = nd::empty(m, n, ndt::make_type<double>());
+  values.resize(m * n);
+  for (intptr_t i = 0; i < m * n; ++i) {
+    values[i] = static_cast<double>((i * 7919) % 23) - 11.0;
+  }
+  memcpy(a.data(), values.data(), values.size() * sizeof(double));
+
+  return a;
+}
+
+void expect_product(intptr_t m, intptr_t k, intptr_t n, const vector<double> &a, const vector<double> &b,
+                    const nd::array &actual) {
+  ASSERT_EQ(ndt::make_type<double>(), actual.get_dtype());
+  ASSERT_EQ(m, actual.get_dim_size());
+  ASSERT_EQ(n, actual(0).get_dim_size());
+  for (intptr_t i = 0; i < m; ++i) {
+    for (intptr_t j = 0; j < n; ++j) {
+      double expected = 0.0;
+      for (intptr_t l = 0; l < k; ++l) {
+        expected += a[i * k + l] * b[l * n + j];
+      }
+      EXPECT_NEAR(expected, actual(i, j).as<double>(), 1e-9 * max(1.0, abs(expected))) << "at " << i << ", " << j;
+    }
+  }
+}
+
+} // unnamed namespace
+
+TEST(Matmul, Simple) {
+  nd::array a = parse_json("2 * 3 * float64", "[[1, 2, 3], [4, 5, 6]]");
+  nd::array b = parse_json("3 * 2 * float64", "[[7, 8], [9, 10], [11, 12]]");
+  EXPECT_ARRAY_EQ(parse_json("2 * 2 * float64", "[[58, 64], [139, 154]]"), nd::matmul(a, b));
+
+  a = parse_json("2 * 2 * float32", "[[1, 2], [3, 4]]");
+  EXPECT_ARRAY_EQ(parse_json("2 * 2 * float32", "[[7, 10], [15, 22]]"), nd::matmul(a, a));
+
+  nd::array c = nd::empty(2, 2, ndt::make_type<dynd::complex<double>>());
+  dynd::complex<double> *c_data = reinterpret_cast<dynd::complex<double> *>(c.data());
+  c_data[0] = dynd::complex<double>(1, 1);
+  c_data[1] = 2;
+  c_data[2] = 0;
+  c_data[3] = dynd::complex<double>(0, 1);
+  nd::array res = nd::matmul(c, c);
+  EXPECT_EQ(dynd::complex<double>(0, 2), res(0, 0).as<dynd::complex<double>>());
+  EXPECT_EQ(dynd::complex<double>(2, 4), res(0, 1).as<dynd::complex<double>>());
+  EXPECT_EQ(dynd::complex<double>(0, 0), res(1, 0).as<dynd::complex<double>>());
+  EXPECT_EQ(dynd::complex<double>(-1, 0), res(1, 1).as<dynd::complex<double>>());
+}
+
+TEST(Matmul, Strided) {
+  vector<double> a, b, bt;
+  nd::array a_arr = make_matrix(10, 6, a);
+  nd::array bt_arr = make_matrix(7, 6, bt);
+
+  // A column-major right operand
+  b.resize(6 * 7);
+  for (intptr_t i = 0; i < 6; ++i) {
+    for (intptr_t j = 0; j < 7; ++j) {
+      b[i * 7 + j] = bt[j * 6 + i];
+    }
+  }
+  expect_product(10, 6, 7, a, b, nd::matmul(a_arr, bt_arr.transpose()));
+
+  // Every other row of the left operand
+  vector<double> a_rows;
+  for (intptr_t i = 0; i < 10; i += 2) {
+    a_rows.insert(a_rows.end(), a.begin() + i * 6, a.begin() + (i + 1) * 6);
+  }
+  expect_product(5, 6, 7, a_rows, b, nd::matmul(a_arr(irange().by(2)), bt_arr.transpose()));
+}
+
+TEST(Matmul, Broadcast) {
+  nd::array a = parse_json("2 * 2 * 2 * float64", "[[[1, 0], [0, 1]], [[1, 2], [3, 4]]]");
+  nd::array b = parse_json("2 * 3 * float64", "[[1, 2, 3], [4, 5, 6]]");
+  EXPECT_ARRAY_EQ(parse_json("2 * 2 * 3 * float64", "[[[1, 2, 3], [4, 5, 6]], [[9, 12, 15], [19, 26, 33]]]"),
+                  nd::matmul(a, b));
+
+  a = parse_json("3 * 1 * 1 * 2 * float64", "[[[[1, 1]]], [[[1, 2]]], [[[2, 0]]]]");
+  EXPECT_ARRAY_EQ(parse_json("3 * 1 * 1 * 3 * float64", "[[[[5, 7, 9]]], [[[9, 12, 15]]], [[[2, 4, 6]]]]"),
+                  nd::matmul(a, b));
+}
+
+TEST(Matmul, Large) {
+  vector<double> a, b;
+  nd::array a_arr = make_matrix(150, 130, a);
+  nd::array b_arr = make_matrix(130, 170, b);
+
+  expect_product(150, 130, 170, a, b, nd::matmul(a_arr, b_arr));
+  expect_product(150, 130, 170, a, b, nd::parallel_matmul(4)(a_arr, b_arr));
+
+  EXPECT_THROW(nd::parallel_matmul(0), invalid_argument);
+}
+
+TEST(Matmul, Empty) {
+  nd::array a = nd::empty(2, 0, ndt::make_type<double>());
+  nd::array b = nd::empty(0, 3, ndt::make_type<double>());
+  EXPECT_ARRAY_EQ(parse_json("2 * 3 * float64", "[[0, 0, 0], [0, 0, 0]]"), nd::matmul(a, b));
+}
+
+TEST(Matmul, Errors) {
+  nd::array a = parse_json("2 * 3 * float64", "[[1, 2, 3], [4, 5, 6]]");
+  EXPECT_THROW(nd::matmul(a, a), type_error);
+  EXPECT_THROW(nd::matmul(a, parse_json("3 * 2 * float32", "[[1, 2], [3, 4], [5, 6]]")), type_error);
+  nd::array b = parse_json("2 * 2 * int32", "[[1, 2], [3, 4]]");
+  EXPECT_THROW(nd::matmul(b, b), type_error);
+  EXPECT_THROW(nd::matmul(nd::array{1.0, 2.0}, nd::array{1.0, 2.0}), type_error);
+}
@@ -10,6 +10,7 @@
 
 #include <dynd/gtest.hpp>
 #include <dynd/json_parser.hpp>
+#include <dynd/arithmetic.hpp>
 #include <dynd/functional.hpp>
 #include <dynd/types/struct_type.hpp>
 
@@ -20,9 +21,7 @@ using namespace dynd;
 
 TEST(Neighborhood, Sum1D)
 {
-  return;
-
-  nd::callable f = nd::functional::neighborhood(nd::functional::apply([](fixed_dim<int> vals) {
+  nd::callable f = nd::functional::neighborhood(nd::functional::apply([](dynd::fixed<int> vals) {
                                                   int res = 0;
                                                   for (auto val : vals) {
                                                     res += val;
@@ -48,9 +47,7 @@ TEST(Neighborhood, Sum1D)
 
 TEST(Neighborhood, Sum2D)
 {
-  return;
-
-  nd::callable f = nd::functional::neighborhood(nd::functional::apply([](fixed_dim<fixed_dim<int>> vals) {
+  nd::callable f = nd::functional::neighborhood(nd::functional::apply([](dynd::fixed<dynd::fixed<int>> vals) {
                                                   int res = 0;
                                                   for (auto vals0 : vals) {
                                                     for (auto val : vals0) {
@@ -135,20 +132,18 @@ TEST(Neighborhood, Sum2D)
 
 TEST(Neighborhood, Sum3D)
 {
-  return;
-
-  nd::callable f = nd::functional::neighborhood(nd::functional::apply([](fixed_dim<fixed_dim<fixed_dim<int>>> vals) {
-                                                  int res = 0;
-                                                  for (auto vals0 : vals) {
-                                                    for (auto vals1 : vals0) {
-                                                      for (auto val : vals1) {
-                                                        res += val;
-                                                      }
-                                                    }
-                                                  }
-                                                  return res;
-                                                }),
-                                                nd::functional::apply([]() { return NA; }));
+  nd::callable child = nd::functional::apply([](dynd::fixed<dynd::fixed<dynd::fixed<int>>> vals) {
+    int res = 0;
+    for (auto vals0 : vals) {
+      for (auto vals1 : vals0) {
+        for (auto val : vals1) {
+          res += val;
+        }
+      }
+    }
+    return res;
+  });
+  nd::callable f = nd::functional::neighborhood(child, nd::functional::apply([]() { return NA; }));
 
   EXPECT_ARRAY_EQ((nd::array{{{567, 594, NA, NA}, {675, 702, NA, NA}, {NA, NA, NA, NA}, {NA, NA, NA, NA}},
                              {{999, 1026, NA, NA}, {1107, 1134, NA, NA}, {NA, NA, NA, NA}, {NA, NA, NA, NA}},
@@ -213,3 +208,139 @@ TEST(Neighborhood, Sum3D)
         "[[888, 672, 452, 228], [690, 522, 351, 177], [476, 360, 242, 122], [246, 186, 125, 63]]]",
         af(a, kwds("shape", parse_json("3 * int", "[3, 5, 7]"))));
 */
+
+TEST(Neighborhood, SumReduction1D) {
+  nd::callable f = nd::functional::neighborhood(nd::sum, nd::functional::apply([]() { return NA; }));
+
+  EXPECT_ARRAY_EQ((nd::array{3, 6, NA, NA}), f({nd::array{0, 1, 2, 3}}, {{"shape", nd::array{3}}}));
+
+  EXPECT_ARRAY_EQ((nd::array{NA, 3, 6, NA}),
+                  f({nd::array{0, 1, 2, 3}}, {{"shape", nd::array{3}}, {"offset", nd::array{-1}}}));
+
+  EXPECT_ARRAY_EQ((nd::array{15, 21, 27, 33, 39, NA, NA, NA, NA, NA}),
+                  f({nd::array{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}}, {{"shape", nd::array{6}}}));
+
+  EXPECT_ARRAY_EQ((nd::array{NA, 15, 21, 27, 33, 39, NA, NA, NA, NA}),
+                  f({nd::array{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}}, {{"shape", nd::array{6}}, {"offset", nd::array{-1}}}));
+
+  EXPECT_ARRAY_EQ((nd::array{NA, NA, 3, 6, 9, 12, 15, 18, 21, 24}),
+                  f({nd::array{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}}, {{"shape", nd::array{3}}, {"offset", nd::array{-2}}}));
+}
+
+TEST(Neighborhood, SumReduction2D) {
+  nd::callable f = nd::functional::neighborhood(nd::sum, nd::functional::apply([]() { return NA; }));
+
+  EXPECT_ARRAY_EQ((nd::array{{10, 14, 18, NA}, {NA, NA, NA, NA}}),
+                  f({nd::array{{0, 1, 2, 3}, {4, 5, 6, 7}}}, {{"shape", nd::array{2, 2}}}));
+
+  EXPECT_ARRAY_EQ(
+      (nd::array{{45, 54, NA, NA}, {81, 90, NA, NA}, {NA, NA, NA, NA}, {NA, NA, NA, NA}}),
+      f({nd::array{{0, 1, 2, 3}, {4, 5, 6, 7}, {8, 9, 10, 11}, {12, 13, 14, 15}}}, {{"shape", nd::array{3, 3}}}));
+
+  // Windows crossing an edge are padded with zeros
+  nd::callable g = nd::functional::neighborhood(nd::sum);
+  nd::array a = parse_json("4 * 4 * int32", "[[0, 1, 2, 3], [4, 5, 6, 7], [8, 9, 10, 11], [12, 13, 14, 15]]");
+
+  EXPECT_ARRAY_EQ(parse_json("4 * 4 * int32", "[[45, 54, 39, 21], [81, 90, 63, 33], [66, 72, 50, 26],"
+                                              "[39, 42, 29, 15]]"),
+                  g({a}, {{"shape", nd::array{3, 3}}}));
+  EXPECT_ARRAY_EQ(parse_json("4 * 4 * int32", "[[10, 18, 24, 18], [27, 45, 54, 39], [51, 81, 90, 63],"
+                                              "[42, 66, 72, 50]]"),
+                  g({a}, {{"shape", nd::array{3, 3}}, {"offset", nd::array{-1, -1}}}));
+}
+
+TEST(Neighborhood, SumReduction3D) {
+  nd::callable f = nd::functional::neighborhood(nd::sum, nd::functional::apply([]() { return NA; }));
+  nd::array a = parse_json("4 * 4 * 4 * int32",
+                           "[[[0, 1, 2, 3], [4, 5, 6, 7], [8, 9, 10, 11], [12, 13, 14, 15]],"
+                           "[[16, 17, 18, 19], [20, 21, 22, 23], [24, 25, 26, 27], [28, 29, 30, 31]],"
+                           "[[32, 33, 34, 35], [36, 37, 38, 39], [40, 41, 42, 43], [44, 45, 46, 47]],"
+                           "[[48, 49, 50, 51], [52, 53, 54, 55], [56, 57, 58, 59], [60, 61, 62, 63]]]");
+
+  EXPECT_ARRAY_EQ((nd::array{{{567, 594, NA, NA}, {675, 702, NA, NA}, {NA, NA, NA, NA}, {NA, NA, NA, NA}},
+                             {{999, 1026, NA, NA}, {1107, 1134, NA, NA}, {NA, NA, NA, NA}, {NA, NA, NA, NA}},
+                             {{NA, NA, NA, NA}, {NA, NA, NA, NA}, {NA, NA, NA, NA}, {NA, NA, NA, NA}},
+                             {{NA, NA, NA, NA}, {NA, NA, NA, NA}, {NA, NA, NA, NA}, {NA, NA, NA, NA}}}),
+                  f({a}, {{"shape", nd::array{3, 3, 3}}}));
+
+  nd::callable g = nd::functional::neighborhood(nd::sum);
+
+  nd::array expected =
+      parse_json("4 * 4 * 4 * int32",
+                 "[[[84, 132, 144, 100], [150, 234, 252, 174], [198, 306, 324, 222], [148, 228, 240, 164]],"
+                 "[[222, 342, 360, 246], [369, 567, 594, 405], [441, 675, 702, 477], [318, 486, 504, 342]],"
+                 "[[414, 630, 648, 438], [657, 999, 1026, 693], [729, 1107, 1134, 765], [510, 774, 792, 534]],"
+                 "[[340, 516, 528, 356], [534, 810, 828, 558], [582, 882, 900, 606], [404, 612, 624, 420]]]");
+  EXPECT_ARRAY_EQ(expected, g({a}, {{"shape", nd::array{3, 3, 3}}, {"offset", nd::array{-1, -1, -1}}}));
+
+  expected =
+      parse_json("4 * 4 * 4 * int32",
+                 "[[[1128, 864, 588, 300], [918, 702, 477, 243], [660, 504, 342, 174], [354, 270, 183, 93]],"
+                 "[[1896, 1440, 972, 492], [1494, 1134, 765, 387], [1044, 792, 534, 270], [546, 414, 279, 141]],"
+                 "[[1520, 1152, 776, 392], [1188, 900, 606, 306], [824, 624, 420, 212], [428, 324, 218, 110]],"
+                 "[[888, 672, 452, 228], [690, 522, 351, 177], [476, 360, 242, 122], [246, 186, 125, 63]]]");
+  EXPECT_ARRAY_EQ(expected, g({a}, {{"shape", nd::array{3, 5, 7}}}));
+}
+
+TEST(Neighborhood, Padding) {
+  nd::array a{0, 1, 2, 3};
+
+  nd::callable f = nd::functional::neighborhood(nd::sum, nd::functional::neighborhood_boundary_nearest);
+  EXPECT_ARRAY_EQ((nd::array{3, 6, 9, 12}), f({a}, {{"shape", nd::array{5}}, {"offset", nd::array{-2}}}));
+
+  f = nd::functional::neighborhood(nd::sum, nd::functional::neighborhood_boundary_reflect);
+  EXPECT_ARRAY_EQ((nd::array{4, 6, 9, 11}), f({a}, {{"shape", nd::array{5}}, {"offset", nd::array{-2}}}));
+
+  f = nd::functional::neighborhood(nd::sum, nd::functional::neighborhood_boundary_wrap);
+  EXPECT_ARRAY_EQ((nd::array{8, 9, 6, 7}), f({a}, {{"shape", nd::array{5}}, {"offset", nd::array{-2}}}));
+
+  // The window may be larger than the array
+  EXPECT_ARRAY_EQ((nd::array{18, 18, 18, 18}), f({a}, {{"shape", nd::array{12}}, {"offset", nd::array{-5}}}));
+}
+
+TEST(Neighborhood, Tiles) {
+  // Several tiles in each dimension, and the same result from any number of threads
+  intptr_t rows = 70, cols = 1100;
+  nd::array a = nd::empty(rows, cols, ndt::make_type<double>());
+  double *data = reinterpret_cast<double *>(a.data());
+  for (intptr_t i = 0; i < rows * cols; ++i) {
+    data[i] = static_cast<double>((i * 7) % 13);
+  }
+
+  nd::array expected = nd::empty(rows, cols, ndt::make_type<double>());
+  double *expected_data = reinterpret_cast<double *>(expected.data());
+  for (intptr_t i = 0; i < rows; ++i) {
+    for (intptr_t j = 0; j < cols; ++j) {
+      double res = 0;
+      for (intptr_t k = i - 1; k <= i + 1; ++k) {
+        for (intptr_t l = j - 2; l <= j + 2; ++l) {
+          if (k >= 0 && k < rows && l >= 0 && l < cols) {
+            res += data[k * cols + l];
+          }
+        }
+      }
+      expected_data[i * cols + j] = res;
+    }
+  }
+
+  for (intptr_t thread_count : {1, 4}) {
+    nd::callable f = nd::functional::neighborhood(nd::sum, nd::functional::neighborhood_boundary_zero, thread_count);
+    EXPECT_ARRAY_EQ(expected, f({a}, {{"shape", nd::array{3, 5}}, {"offset", nd::array{-1, -2}}}));
+  }
+
+  // A strided view
+  nd::callable f = nd::functional::neighborhood(nd::sum);
+  nd::array b = a(irange().by(2), irange().by(3));
+  nd::array c = f({b}, {{"shape", nd::array{1, 2}}});
+  EXPECT_EQ(data[0] + data[3], c(0, 0).as<double>());
+  EXPECT_EQ(data[2 * cols + 6] + data[2 * cols + 9], c(1, 2).as<double>());
+}
+
+TEST(Neighborhood, Errors) {
+  nd::callable f = nd::functional::neighborhood(nd::sum);
+
+  EXPECT_THROW(f({nd::array{0, 1, 2, 3}}, {{"shape", nd::array{2, 2}}}), type_error);
+  EXPECT_THROW(f({nd::array{0, 1, 2, 3}}, {{"shape", nd::array{0}}}), invalid_argument);
+  EXPECT_THROW(f({nd::array{0, 1, 2, 3}}, {{"shape", nd::array{2}}, {"offset", nd::array{0, 0}}}), invalid_argument);
+  EXPECT_THROW(nd::functional::neighborhood(nd::sum, nd::functional::neighborhood_boundary_fill), invalid_argument);
+}
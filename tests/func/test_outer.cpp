@@ -8,6 +8,7 @@
 #include <iostream>
 #include <stdexcept>
 
+#include <dynd/arithmetic.hpp>
 #include <dynd/functional.hpp>
 #include <dynd/gtest.hpp>
 
@@ -39,3 +40,55 @@ TEST(Outer, 3D) {
   EXPECT_ARRAY_EQ(nd::array({3, 4}), f(0, 1, nd::array{2, 3}));
   EXPECT_ARRAY_EQ(3, f(0, 1, 2));
 }
+
+TEST(Outer, Arithmetic) {
+  nd::callable f = nd::functional::outer(nd::add);
+  EXPECT_ARRAY_EQ(nd::array({{1.5f, 3.5f}, {3.5f, 5.5f}}), f(nd::array{0.5f, 2.5f}, nd::array{1.0f, 3.0f}));
+  EXPECT_ARRAY_EQ(nd::array({{1, 3, 5}, {3, 5, 7}}), f(nd::array{0, 2}, nd::array{1, 3, 5}));
+  EXPECT_ARRAY_EQ(nd::array({1, 3}), f(nd::array{0, 2}, 1));
+
+  f = nd::functional::outer(nd::subtract);
+  EXPECT_ARRAY_EQ(nd::array({{-1.0, -3.0}, {1.0, -1.0}}), f(nd::array{0.0, 2.0}, nd::array{1.0, 3.0}));
+  EXPECT_ARRAY_EQ(nd::array({{INT64_C(-1), INT64_C(-3)}, {INT64_C(1), INT64_C(-1)}}),
+                  f(nd::array{INT64_C(0), INT64_C(2)}, nd::array{INT64_C(1), INT64_C(3)}));
+
+  f = nd::functional::outer(nd::divide);
+  EXPECT_ARRAY_EQ(nd::array({{0.0, 0.0}, {2.0, 0.5}}), f(nd::array{0.0, 2.0}, nd::array{1.0, 4.0}));
+  EXPECT_THROW(f(nd::array{0, 2}, nd::array{1, 0}), zero_division_error);
+
+  // Strided arguments and destination, multiple column blocks and threads
+  const intptr_t m = 700, n = 1600;
+  nd::array a = nd::empty(2 * m, "float32");
+  nd::array b = nd::empty(2 * n, "float32");
+  float *a_data = reinterpret_cast<float *>(a.data());
+  float *b_data = reinterpret_cast<float *>(b.data());
+  for (intptr_t i = 0; i < 2 * m; ++i) {
+    a_data[i] = static_cast<float>(i % 37) - 18.0f;
+  }
+  for (intptr_t j = 0; j < 2 * n; ++j) {
+    b_data[j] = static_cast<float>(j % 29) * 0.5f;
+  }
+
+  for (intptr_t thread_count : {1, 3}) {
+    f = nd::functional::outer(nd::multiply, thread_count);
+    nd::array c = f(a(irange().by(2)), b(irange().by(2)));
+    EXPECT_EQ(ndt::type("700 * 1600 * float32"), c.get_type());
+    const float *c_data = reinterpret_cast<const float *>(c.cdata());
+    for (intptr_t i = 0; i < m; ++i) {
+      for (intptr_t j = 0; j < n; ++j) {
+        ASSERT_EQ(a_data[2 * i] * b_data[2 * j], c_data[i * n + j]);
+      }
+    }
+  }
+
+  nd::array d = nd::empty(n, m, "float32");
+  nd::functional::outer(nd::add)({a(irange(0, m)), b(irange(0, n))}, {{"dst", d.transpose()}});
+  const float *d_data = reinterpret_cast<const float *>(d.cdata());
+  for (intptr_t i = 0; i < m; ++i) {
+    for (intptr_t j = 0; j < n; ++j) {
+      ASSERT_EQ(a_data[i] + b_data[j], d_data[j * m + i]);
+    }
+  }
+
+  EXPECT_THROW(nd::functional::outer(nd::add, 0), invalid_argument);
+}
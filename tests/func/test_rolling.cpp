@@ -0,0 +1,155 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include <dynd/arithmetic.hpp>
+#include <dynd/gtest.hpp>
+#include <dynd/json_parser.hpp>
+#include <dynd/statistics.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+
+const double NaN = numeric_limits<double>::quiet_NaN();
+const double Inf = numeric_limits<double>::infinity();
+
+// NaN and infinities in the expected values must be matched exactly, and
+// everything else to within rounding
+void expect_rolling(const vector<double> &expected, const nd::array &actual) {
+  ASSERT_EQ(static_cast<intptr_t>(expected.size()), actual.get_dim_size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    double value = actual(i).as<double>();
+    if (std::isnan(expected[i])) {
+      EXPECT_TRUE(std::isnan(value)) << "at index " << i << ", got " << value;
+    } else if (std::isinf(expected[i])) {
+      EXPECT_EQ(expected[i], value) << "at index " << i;
+    } else {
+      EXPECT_NEAR(expected[i], value, 1e-9 * std::max(1.0, std::abs(expected[i]))) << "at index " << i;
+    }
+  }
+}
+
+} // unnamed namespace
+
+TEST(Rolling, Max) {
+  nd::array a = parse_json("9 * int32", "[3, 2, -1, 0, 0, 5, 2, 2, 2]");
+  expect_rolling({NaN, NaN, 3, 2, 0, 5, 5, 5, 2}, nd::rolling(nd::rolling_max, 3)(a));
+
+  // Missing values count against min_periods, which defaults to the window
+  a = nd::array{1.0, 3.0, 7.0, NaN, 6.0, 2.0, 7.0, Inf};
+  expect_rolling({NaN, NaN, 7, NaN, NaN, NaN, 7, Inf}, nd::rolling(nd::max, 3)(a));
+  expect_rolling({NaN, NaN, 7, 7, 7, 6, 7, Inf}, nd::rolling(nd::max, 3, 2)(a));
+}
+
+TEST(Rolling, Min) {
+  nd::array a = parse_json("9 * int32", "[3, 2, -1, 0, 0, 5, 2, 2, 2]");
+  expect_rolling({NaN, NaN, -1, -1, -1, 0, 0, 2, 2}, nd::rolling(nd::rolling_min, 3)(a));
+  expect_rolling({3, 2, -1, 0, 0, 5, 2, 2, 2}, nd::rolling(nd::min, 1)(a));
+}
+
+TEST(Rolling, Sum) {
+  nd::array a{1, 2, 3, 4, 5};
+  expect_rolling({NaN, 3, 5, 7, 9}, nd::rolling(nd::sum, 2)(a));
+  expect_rolling({NaN, 1.5, 2.5, 3.5, 4.5}, nd::rolling(nd::rolling_mean, 2)(a));
+  expect_rolling({NaN, NaN, NaN, NaN, 15}, nd::rolling(nd::rolling_sum, 5)(a));
+
+  // Infinities are counted rather than summed, so they leave the window cleanly
+  a = nd::array{1.0, Inf, -Inf, 2.0, 3.0};
+  expect_rolling({NaN, Inf, NaN, -Inf, 5}, nd::rolling(nd::rolling_sum, 2)(a));
+  expect_rolling({NaN, Inf, NaN, -Inf, 2.5}, nd::rolling(nd::rolling_mean, 2)(a));
+}
+
+TEST(Rolling, Var) {
+  nd::array a{1.0, 2.0, 3.0, 4.0, 10.0};
+  expect_rolling({NaN, NaN, 1, 1, 43.0 / 3.0}, nd::rolling(nd::rolling_var, 3)(a));
+
+  a = nd::array{1.0, 2.0, Inf, 4.0, 5.0, 6.0};
+  expect_rolling({NaN, 0.5, NaN, NaN, 0.5, 0.5}, nd::rolling(nd::rolling_var, 2)(a));
+}
+
+TEST(Rolling, MatchesRecomputing) {
+  // A long series, so that the updated state has time to drift from the recomputed one
+  intptr_t size = 5000, window = 37;
+  vector<double> values(size);
+  for (intptr_t i = 0; i < size; ++i) {
+    values[i] = std::sin(0.37 * i) * 1000.0 + ((i * 7919) % 101);
+  }
+  nd::array a = nd::empty(size, ndt::make_type<double>());
+  std::copy(values.begin(), values.end(), reinterpret_cast<double *>(a.data()));
+
+  vector<double> sums(size, NaN), means(size, NaN), vars(size, NaN), mins(size, NaN), maxs(size, NaN);
+  for (intptr_t i = window - 1; i < size; ++i) {
+    double s = 0;
+    for (intptr_t j = i - window + 1; j <= i; ++j) {
+      s += values[j];
+    }
+    double m = s / window, ss = 0;
+    for (intptr_t j = i - window + 1; j <= i; ++j) {
+      ss += (values[j] - m) * (values[j] - m);
+    }
+    sums[i] = s;
+    means[i] = m;
+    vars[i] = ss / (window - 1);
+    mins[i] = *std::min_element(values.begin() + (i - window + 1), values.begin() + (i + 1));
+    maxs[i] = *std::max_element(values.begin() + (i - window + 1), values.begin() + (i + 1));
+  }
+
+  expect_rolling(sums, nd::rolling(nd::rolling_sum, window)(a));
+  expect_rolling(means, nd::rolling(nd::rolling_mean, window)(a));
+  expect_rolling(vars, nd::rolling(nd::rolling_var, window)(a));
+  expect_rolling(mins, nd::rolling(nd::rolling_min, window)(a));
+  expect_rolling(maxs, nd::rolling(nd::rolling_max, window)(a));
+}
+
+TEST(Rolling, Dims) {
+  nd::callable f = nd::rolling(nd::rolling_sum, 2);
+
+  nd::array res = f(parse_json("2 * 3 * int32", "[[1, 2, 3], [4, 5, 6]]"));
+  EXPECT_EQ(ndt::type("2 * 3 * float64"), res.get_type());
+  expect_rolling({NaN, 3, 5}, res(0));
+  expect_rolling({NaN, 9, 11}, res(1));
+
+  res = f(parse_json("2 * var * int32", "[[1, 2, 3], [4, 5, 6, 7]]"));
+  EXPECT_EQ(ndt::type("2 * var * float64"), res.get_type());
+  expect_rolling({NaN, 3, 5}, res(0));
+  expect_rolling({NaN, 9, 11, 13}, res(1));
+}
+
+TEST(Rolling, Option) {
+  nd::array a = parse_json("6 * ?int32", "[1, null, 3, 4, null, 6]");
+
+  nd::array res = nd::rolling(nd::rolling_sum, 2)(a);
+  EXPECT_EQ(ndt::type("6 * ?float64"), res.get_type());
+  EXPECT_TRUE(res(0).is_na());
+  EXPECT_TRUE(res(1).is_na());
+  EXPECT_TRUE(res(2).is_na());
+  EXPECT_EQ(7, res(3).as<double>());
+  EXPECT_TRUE(res(4).is_na());
+  EXPECT_TRUE(res(5).is_na());
+
+  res = nd::rolling(nd::rolling_max, 2, 1)(a);
+  EXPECT_TRUE(res(0).is_na());
+  EXPECT_EQ(1, res(1).as<double>());
+  EXPECT_EQ(3, res(2).as<double>());
+  EXPECT_EQ(4, res(3).as<double>());
+  EXPECT_EQ(4, res(4).as<double>());
+  EXPECT_EQ(6, res(5).as<double>());
+}
+
+TEST(Rolling, Errors) {
+  EXPECT_THROW(nd::rolling(nd::rolling_sum, 0), invalid_argument);
+  EXPECT_THROW(nd::rolling(nd::rolling_sum, 2, 3), invalid_argument);
+  EXPECT_THROW(nd::rolling(nd::add, 2), invalid_argument);
+  EXPECT_THROW(nd::rolling(nd::rolling_sum, 2)(nd::array(1)), type_error);
+  EXPECT_THROW(nd::rolling(nd::rolling_sum, 2)(nd::array{"a", "b"}), type_error);
+}
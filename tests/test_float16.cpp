@@ -5,9 +5,12 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <iostream>
 #include <stdexcept>
+#include <vector>
 
+#include <dynd/array.hpp>
 #include <dynd/config.hpp>
 #include <dynd/gtest.hpp>
 
@@ -23,3 +26,205 @@ TEST(Float16, CommonType)
                             float64>::value));
 }
 */
+
+TEST(Float16, BulkToFloat)
+{
+  // Every float16 bit pattern
+  vector<uint16_t> h(0x10000);
+  for (size_t i = 0; i < h.size(); ++i) {
+    h[i] = static_cast<uint16_t>(i);
+  }
+
+  vector<float> f(h.size());
+  halfbits_to_float(f.data(), h.data(), h.size());
+  for (size_t i = 0; i < h.size(); ++i) {
+    float expected = halfbits_to_float(h[i]);
+    if (std::isnan(expected)) {
+      EXPECT_TRUE(std::isnan(f[i]));
+    }
+    else {
+      EXPECT_EQ(0, memcmp(&expected, &f[i], sizeof(float))) << "float16 bits " << h[i];
+    }
+  }
+
+  vector<double> d(h.size());
+  halfbits_to_double(d.data(), h.data(), h.size());
+  for (size_t i = 0; i < h.size(); ++i) {
+    double expected = halfbits_to_double(h[i]);
+    if (std::isnan(expected)) {
+      EXPECT_TRUE(std::isnan(d[i]));
+    }
+    else {
+      EXPECT_EQ(0, memcmp(&expected, &d[i], sizeof(double))) << "float16 bits " << h[i];
+    }
+  }
+}
+
+TEST(Float16, BulkFromFloat)
+{
+  // Every finite float16 value, plus values halfway between neighbours that round to even
+  vector<float> f;
+  for (uint32_t i = 0; i < 0x7c00u; ++i) {
+    float value = halfbits_to_float(static_cast<uint16_t>(i));
+    f.push_back(value);
+    f.push_back(-value);
+    if (i >= 0x0400u && i < 0x7bffu) {
+      f.push_back((value + halfbits_to_float(static_cast<uint16_t>(i + 1))) / 2);
+    }
+  }
+  f.push_back(std::numeric_limits<float>::infinity());
+  f.push_back(-std::numeric_limits<float>::infinity());
+  f.push_back(1e30f);
+
+  vector<uint16_t> h(f.size());
+  float_to_halfbits(h.data(), f.data(), f.size());
+  for (size_t i = 0; i < f.size(); ++i) {
+    EXPECT_EQ(float_to_halfbits(f[i]), h[i]) << "float32 value " << f[i];
+  }
+
+  vector<double> d(f.begin(), f.end());
+  double_to_halfbits(h.data(), d.data(), d.size());
+  for (size_t i = 0; i < d.size(); ++i) {
+    EXPECT_EQ(double_to_halfbits(d[i]), h[i]) << "float64 value " << d[i];
+  }
+
+  // The bulk conversion raises the same errors as the single value one
+  vector<float> g(100, 1.0f);
+  g[50] = 65530.0f;
+  EXPECT_THROW(float_to_halfbits(h.data(), g.data(), g.size()), overflow_error);
+  g[50] = 1e-6f;
+  EXPECT_THROW(float_to_halfbits(h.data(), g.data(), g.size()), runtime_error);
+}
+
+TEST(Float16, BulkFromFloatNocheck)
+{
+  // Values across the whole float16 range and past both ends of it, including ones that only just miss the halfway
+  // point between two subnormals
+  vector<float> f;
+  for (uint32_t i = 0x32000000u; i < 0x48000000u; i += 0x1003u) {
+    f.push_back(alias_cast<float>(i));
+    f.push_back(-alias_cast<float>(i));
+  }
+  f.push_back(alias_cast<float>(0x33000001u));
+  f.push_back(alias_cast<float>(0x33c00001u));
+  f.push_back(alias_cast<float>(0x387fc001u));
+  f.push_back(std::numeric_limits<float>::infinity());
+  f.push_back(1e30f);
+  f.push_back(1e-30f);
+
+  vector<uint16_t> h(f.size());
+  float_to_halfbits_nocheck(h.data(), f.data(), f.size());
+  for (size_t i = 0; i < f.size(); ++i) {
+    EXPECT_EQ(float_to_halfbits_nocheck(f[i]), h[i]) << "float32 value " << f[i];
+  }
+
+  vector<double> d(f.begin(), f.end());
+  double_to_halfbits_nocheck(h.data(), d.data(), d.size());
+  for (size_t i = 0; i < d.size(); ++i) {
+    EXPECT_EQ(float_to_halfbits_nocheck(f[i]), h[i]) << "float64 value " << d[i];
+  }
+
+  EXPECT_EQ(0x0000u, float_to_halfbits_nocheck(1e-8f));
+  EXPECT_EQ(0x8002u, float_to_halfbits_nocheck(-1e-7f));
+  EXPECT_EQ(0x7bffu, float_to_halfbits_nocheck(65519.0f));
+  EXPECT_EQ(0x7c00u, float_to_halfbits_nocheck(65520.0f));
+  EXPECT_EQ(0xfc00u, double_to_halfbits_nocheck(-1e6));
+}
+
+template <typename T>
+static vector<uint16_t> float16_assign(T value, assign_error_mode error_mode)
+{
+  // The value sits in the middle of a contiguous run, with ones that convert exactly around it
+  nd::array a = nd::empty(20, ndt::make_type<T>());
+  T *a_data = reinterpret_cast<T *>(a.data());
+  for (int i = 0; i < 20; ++i) {
+    a_data[i] = static_cast<T>(i) / 4;
+  }
+  a_data[11] = value;
+
+  nd::array b = nd::empty(20, ndt::make_type<float16>());
+  b.assign(a, error_mode);
+  // Strided
+  nd::array c = nd::empty(10, ndt::make_type<float16>());
+  c.assign(a(irange(1, 20, 2)), error_mode);
+
+  const uint16_t *b_data = reinterpret_cast<const uint16_t *>(b.cdata());
+  const uint16_t *c_data = reinterpret_cast<const uint16_t *>(c.cdata());
+  for (int i = 0; i < 20; ++i) {
+    if (i != 11) {
+      EXPECT_EQ(float_to_halfbits(i / 4.0f), b_data[i]);
+    }
+  }
+  EXPECT_EQ(b_data[11], c_data[5]);
+  return vector<uint16_t>(b_data, b_data + 20);
+}
+
+TEST(Float16, AssignErrorMode)
+{
+  // Without checking, values round quietly to zero, a subnormal or inf
+  for (assign_error_mode error_mode : {assign_error_nocheck, assign_error_default}) {
+    EXPECT_EQ(0x0000u, float16_assign(1e-8f, error_mode)[11]);
+    EXPECT_EQ(0x0002u, float16_assign(1e-7f, error_mode)[11]);
+    EXPECT_EQ(0x7c00u, float16_assign(1e6f, error_mode)[11]);
+    EXPECT_EQ(0xfc00u, float16_assign(-65520.0f, error_mode)[11]);
+    EXPECT_EQ(0x0000u, float16_assign(1e-8, error_mode)[11]);
+    EXPECT_EQ(0x0002u, float16_assign(1e-7, error_mode)[11]);
+    EXPECT_EQ(0x7c00u, float16_assign(1e6, error_mode)[11]);
+    EXPECT_EQ(0xfc00u, float16_assign(-65520.0, error_mode)[11]);
+  }
+
+  // Overflow and fractional checking raise when a finite value rounds to inf, but still round tiny values
+  for (assign_error_mode error_mode : {assign_error_overflow, assign_error_fractional}) {
+    EXPECT_EQ(0x0000u, float16_assign(1e-8f, error_mode)[11]);
+    EXPECT_EQ(0x0002u, float16_assign(1e-7f, error_mode)[11]);
+    EXPECT_EQ(0x7bffu, float16_assign(65519.0f, error_mode)[11]);
+    EXPECT_EQ(0x7c00u, float16_assign(std::numeric_limits<float>::infinity(), error_mode)[11]);
+    EXPECT_THROW(float16_assign(1e6f, error_mode), overflow_error);
+    EXPECT_THROW(float16_assign(-65520.0f, error_mode), overflow_error);
+    EXPECT_EQ(0x0000u, float16_assign(1e-8, error_mode)[11]);
+    EXPECT_EQ(0x0002u, float16_assign(1e-7, error_mode)[11]);
+    EXPECT_EQ(0x7bffu, float16_assign(65519.0, error_mode)[11]);
+    EXPECT_THROW(float16_assign(1e6, error_mode), overflow_error);
+    EXPECT_THROW(float16_assign(-65520.0, error_mode), overflow_error);
+  }
+
+  // Inexact checking raises on any rounding as well
+  EXPECT_EQ(0x0001u, float16_assign(5.9604644775390625e-08f, assign_error_inexact)[11]);
+  EXPECT_EQ(0x7bffu, float16_assign(65504.0f, assign_error_inexact)[11]);
+  EXPECT_EQ(0x7e00u, float16_assign(std::numeric_limits<float>::quiet_NaN(), assign_error_inexact)[11] & 0x7e00u);
+  EXPECT_THROW(float16_assign(1e-8f, assign_error_inexact), runtime_error);
+  EXPECT_THROW(float16_assign(1e-7f, assign_error_inexact), runtime_error);
+  EXPECT_THROW(float16_assign(0.1f, assign_error_inexact), runtime_error);
+  EXPECT_THROW(float16_assign(1e6f, assign_error_inexact), overflow_error);
+  EXPECT_EQ(0x0001u, float16_assign(5.9604644775390625e-08, assign_error_inexact)[11]);
+  EXPECT_EQ(0x7bffu, float16_assign(65504.0, assign_error_inexact)[11]);
+  EXPECT_THROW(float16_assign(1e-8, assign_error_inexact), runtime_error);
+  EXPECT_THROW(float16_assign(1.0 + 1e-10, assign_error_inexact), runtime_error);
+  EXPECT_THROW(float16_assign(1e6, assign_error_inexact), overflow_error);
+}
+
+TEST(Float16, ArrayAssign)
+{
+  nd::array a = nd::empty(1000, ndt::make_type<float>());
+  float *a_data = reinterpret_cast<float *>(a.data());
+  for (int i = 0; i < 1000; ++i) {
+    a_data[i] = i - 500.25f;
+  }
+
+  nd::array b = nd::empty(1000, ndt::make_type<float16>());
+  b.assign(a);
+  nd::array c = nd::empty(1000, ndt::make_type<double>());
+  c.assign(b);
+  const double *c_data = reinterpret_cast<const double *>(c.cdata());
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(i - 500.25, c_data[i]);
+  }
+
+  // Strided
+  nd::array d = nd::empty(500, ndt::make_type<float>());
+  d.assign(b(irange().by(2)));
+  const float *d_data = reinterpret_cast<const float *>(d.cdata());
+  for (int i = 0; i < 500; ++i) {
+    EXPECT_EQ(2 * i - 500.25f, d_data[i]);
+  }
+}
@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <sstream>
 #include <stdexcept>
 
 #include <dynd/gtest.hpp>
@@ -23,3 +24,73 @@ TEST(Serialize, FixedDimFixedDim) {
   EXPECT_ARRAY_EQ(bytes("\x00\x00\x00\x00\x01\x00\x00\x00\x02\x00\x00\x00\x03\x00\x00\x00"),
                   nd::serialize(nd::array{{0, 1}, {2, 3}}));
 }
+
+TEST(Binary, FixedDim) {
+  nd::array a = nd::array{{0.5, 1.5, 2.5}, {3.5, 4.5, 5.5}};
+  std::stringstream ss;
+  nd::save(ss, a);
+
+  nd::array b = nd::load(ss);
+  EXPECT_EQ(a.get_type(), b.get_type());
+  EXPECT_ARRAY_EQ(a, b);
+  EXPECT_TRUE(b.is_immutable());
+}
+
+TEST(Binary, Struct) {
+  nd::array a = nd::empty("3 * {x: int8, s: string, v: var * ?int32, t: (float64, bytes)}");
+  a(0, 0).vals() = 1;
+  a(1, 0).vals() = -2;
+  a(2, 0).vals() = 3;
+  a(0, 1).vals() = "short";
+  a(1, 1).vals() = "a string that is too long for the small string optimization";
+  a(2, 1).vals() = "";
+  a(0, 2).vals() = nd::array{1, 2, 3};
+  a(1, 2).vals() = nd::array{4};
+  a(2, 2).vals() = nd::empty("0 * ?int32");
+  a(irange(), 3, 0).vals() = 2.25;
+  a(irange(), 3, 1).vals() = bytes("\x01\x02\x03");
+  std::stringstream ss;
+  nd::save(ss, a);
+
+  nd::array b = nd::load(ss);
+  EXPECT_EQ(a.get_type(), b.get_type());
+  for (intptr_t i = 0; i < 3; ++i) {
+    EXPECT_EQ(a(i, 0).as<int>(), b(i, 0).as<int>());
+    EXPECT_EQ(a(i, 1).as<std::string>(), b(i, 1).as<std::string>());
+    ASSERT_EQ(a(i, 2).get_dim_size(), b(i, 2).get_dim_size());
+    for (intptr_t j = 0; j < a(i, 2).get_dim_size(); ++j) {
+      EXPECT_EQ(a(i, 2, j).as<int>(), b(i, 2, j).as<int>());
+    }
+    EXPECT_EQ(2.25, b(i, 3, 0).as<double>());
+    EXPECT_EQ(bytes("\x01\x02\x03"), b(i, 3, 1).as<bytes>());
+  }
+}
+
+TEST(Binary, File) {
+  nd::array a = nd::empty("1000 * {x: int32, y: float64}");
+  for (int i = 0; i < 1000; ++i) {
+    a(i, 0).vals() = i;
+    a(i, 1).vals() = i / 4.0;
+  }
+  nd::save("test_binary.dynd", a(irange().by(2)));
+
+  {
+    nd::array b = nd::load("test_binary.dynd");
+    EXPECT_EQ(ndt::type("500 * {x: int32, y: float64}"), b.get_type());
+    EXPECT_TRUE(b.is_immutable());
+    EXPECT_EQ(998, b(499, 0).as<int>());
+    EXPECT_EQ(249.5, b(499, 1).as<double>());
+  }
+  remove("test_binary.dynd");
+}
+
+TEST(Binary, Errors) {
+  std::stringstream ss("not a dynd binary file, but long enough");
+  EXPECT_THROW(nd::load(ss), runtime_error);
+
+  std::stringstream out;
+  nd::save(out, nd::array{"a", "bb"});
+  std::string str = out.str();
+  str.resize(str.size() - 20);
+  EXPECT_THROW(nd::load(str.data(), str.data() + str.size()), runtime_error);
+}
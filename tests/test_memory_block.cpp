@@ -0,0 +1,71 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <stdexcept>
+
+#include <dynd/gtest.hpp>
+#include <dynd/memblock/objectarray_memory_block.hpp>
+#include <dynd/memblock/pod_memory_block.hpp>
+#include <dynd/memblock/zeroinit_memory_block.hpp>
+#include <dynd/string.hpp>
+
+using namespace std;
+using namespace dynd;
+
+TEST(PODMemoryBlock, Growth) {
+  nd::pod_memory_block a(1, 1, 16, 4.0);
+  a.alloc(16);
+  a.alloc(10);
+  ASSERT_EQ(2u, a.m_memory_handles.size());
+  EXPECT_EQ(48, a.m_memory_handles[1].end - a.m_memory_handles[1].begin);
+
+  nd::pod_memory_block b(1, 1, 16, 1.0);
+  b.alloc(16);
+  b.alloc(10);
+  ASSERT_EQ(2u, b.m_memory_handles.size());
+  EXPECT_EQ(10, b.m_memory_handles[1].end - b.m_memory_handles[1].begin);
+
+  EXPECT_THROW(nd::pod_memory_block(1, 1, 16, 0.5), invalid_argument);
+}
+
+TEST(PODMemoryBlock, Reset) {
+  nd::zeroinit_memory_block a(ndt::make_type<int32_t>(), 64);
+  for (int i = 0; i < 10; ++i) {
+    char *data = a.alloc(8);
+    for (int j = 0; j < 8; ++j) {
+      reinterpret_cast<int32_t *>(data)[j] = j + 1;
+    }
+  }
+  a.finalize();
+  EXPECT_LT(1u, a.m_memory_handles.size());
+
+  // After a reset, the same amount of data fits in a single chunk
+  a.reset();
+  ASSERT_EQ(1u, a.m_memory_handles.size());
+  for (int i = 0; i < 10; ++i) {
+    char *data = a.alloc(8);
+    for (int j = 0; j < 8; ++j) {
+      EXPECT_EQ(0, reinterpret_cast<int32_t *>(data)[j]);
+    }
+  }
+  EXPECT_EQ(1u, a.m_memory_handles.size());
+}
+
+TEST(ObjectArrayMemoryBlock, Reset) {
+  nd::objectarray_memory_block a(ndt::make_type<dynd::string>(), 0, NULL, sizeof(dynd::string), 2);
+  for (int i = 0; i < 4; ++i) {
+    dynd::string *data = reinterpret_cast<dynd::string *>(a.alloc(3));
+    for (int j = 0; j < 3; ++j) {
+      data[j] = dynd::string("a string which does not fit inline");
+    }
+  }
+  a.finalize();
+
+  a.reset();
+  dynd::string *data = reinterpret_cast<dynd::string *>(a.alloc(12));
+  for (int j = 0; j < 12; ++j) {
+    EXPECT_EQ(0u, data[j].size());
+  }
+}
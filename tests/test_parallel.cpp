@@ -0,0 +1,79 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <dynd/parallel.hpp>
+#include <dynd/gtest.hpp>
+
+using namespace std;
+using namespace dynd;
+
+TEST(Parallel, ChunkCount) {
+  EXPECT_EQ(1, parallel_chunk_count(0, 4, 1));
+  EXPECT_EQ(1, parallel_chunk_count(100, 4, 1000));
+  EXPECT_EQ(2, parallel_chunk_count(2500, 4, 1000));
+  EXPECT_EQ(4, parallel_chunk_count(100, 4, 1));
+  EXPECT_EQ(3, parallel_chunk_count(3, 4, 0));
+  EXPECT_LE(1, parallel_chunk_count(100, 0, 1));
+}
+
+TEST(Parallel, CoversRange) {
+  mutex m;
+  vector<pair<intptr_t, intptr_t>> ranges;
+  vector<int> visits(1003);
+  parallel_for(1003, 4, 10, [&](intptr_t begin, intptr_t end) {
+    for (intptr_t i = begin; i < end; ++i) {
+      ++visits[i];
+    }
+    lock_guard<mutex> lock(m);
+    ranges.emplace_back(begin, end);
+  });
+
+  EXPECT_EQ(4u, ranges.size());
+  for (int count : visits) {
+    EXPECT_EQ(1, count);
+  }
+}
+
+TEST(Parallel, SmallWorkRunsInline) {
+  thread::id caller = this_thread::get_id(), ran_on;
+  int calls = 0;
+  parallel_for(50, 8, 100, [&](intptr_t begin, intptr_t end) {
+    EXPECT_EQ(0, begin);
+    EXPECT_EQ(50, end);
+    ran_on = this_thread::get_id();
+    ++calls;
+  });
+  EXPECT_EQ(1, calls);
+  EXPECT_EQ(caller, ran_on);
+}
+
+TEST(Parallel, Exceptions) {
+  atomic<int> finished(0);
+  EXPECT_THROW(parallel_for(4, 4, 1,
+                            [&](intptr_t begin, intptr_t DYND_UNUSED(end)) {
+                              if (begin == 2) {
+                                throw overflow_error("overflow in a worker");
+                              }
+                              ++finished;
+                            }),
+               overflow_error);
+  // The other ranges still ran to completion
+  EXPECT_EQ(3, finished.load());
+
+  EXPECT_THROW(parallel_for(4, 4, 1,
+                            [](intptr_t begin, intptr_t DYND_UNUSED(end)) {
+                              if (begin == 0) {
+                                throw invalid_argument("invalid on the calling thread");
+                              }
+                            }),
+               invalid_argument);
+}
@@ -11,6 +11,7 @@
 #include <dynd/kernels/byteswap_kernels.hpp>
 #include <dynd/types/adapt_type.hpp>
 #include <dynd/types/fixed_bytes_type.hpp>
+#include <dynd/gtest.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -84,3 +85,82 @@ TEST(AdaptType, ByteswapEval) {
   a.assign(dynd::complex<double>(alias_cast<double>(0x112D4454FB210940LL), alias_cast<double>(0x002892B01FF771C2LL)));
   EXPECT_EQ(dynd::complex<double>(3.14159265358979, -1.2345678912345e12), a.view<dynd::complex<double>>());
 }
+
+TEST(AdaptType, ViewByteswapped) {
+  // Big-endian data, as it would be read from a file
+  nd::array raw = nd::empty(8, ndt::make_type<uint32_t>());
+  uint32_t *raw_data = reinterpret_cast<uint32_t *>(raw.data());
+  for (uint32_t i = 0; i < 8; ++i) {
+    raw_data[i] = byteswap_value(i * 0x01010101u);
+  }
+
+  // A strided view of every other value
+  nd::array a = nd::view_byteswapped(raw(irange().by(2)));
+  EXPECT_EQ(ndt::make_fixed_dim(4, ndt::make_type<uint32_t>()), a.get_type().get_canonical_type());
+  EXPECT_EQ(raw.cdata(), a.cdata());
+
+  nd::array b = nd::empty(4, ndt::make_type<uint32_t>());
+  b.assign(a);
+  for (uint32_t i = 0; i < 4; ++i) {
+    EXPECT_EQ(2 * i * 0x01010101u, b(i).as<uint32_t>());
+  }
+
+  // Assigning to a different type goes through a buffer of values
+  b = nd::empty(4, ndt::make_type<double>());
+  b.assign(a);
+  for (uint32_t i = 0; i < 4; ++i) {
+    EXPECT_EQ(2 * i * 0x01010101u, b(i).as<double>());
+  }
+
+  // Writing through the view stores big-endian data
+  a.assign(nd::array{1u, 2u, 3u, 4u});
+  for (uint32_t i = 0; i < 4; ++i) {
+    EXPECT_EQ(byteswap_value(i + 1), raw_data[2 * i]);
+    EXPECT_EQ(byteswap_value((2 * i + 1) * 0x01010101u), raw_data[2 * i + 1]);
+  }
+
+  b = nd::view_byteswapped(nd::array{int16_t(0x0102), int16_t(0x0304)}).eval();
+  EXPECT_EQ(ndt::make_fixed_dim(2, ndt::make_type<int16_t>()), b.get_type());
+  EXPECT_EQ(0x0201, b(0).as<int16_t>());
+  EXPECT_EQ(0x0403, b(1).as<int16_t>());
+
+  b = nd::view_byteswapped(nd::array{0x0102030405060708LL, 0x1112131415161718LL}).eval();
+  EXPECT_EQ(0x0807060504030201LL, b(0).as<long long>());
+  EXPECT_EQ(0x1817161514131211LL, b(1).as<long long>());
+
+  a = nd::empty(2, ndt::make_type<uint128>());
+  reinterpret_cast<uint128 *>(a.data())[0] = uint128(0x0102030405060708ULL, 0x1112131415161718ULL);
+  reinterpret_cast<uint128 *>(a.data())[1] = uint128(0x2122232425262728ULL, 0x3132333435363738ULL);
+  b = nd::view_byteswapped(a).eval();
+  EXPECT_EQ(uint128(0x1817161514131211ULL, 0x0807060504030201ULL), b(0).as<uint128>());
+  EXPECT_EQ(uint128(0x3837363534333231ULL, 0x2827262524232221ULL), b(1).as<uint128>());
+
+  a = nd::empty(2, ndt::make_type<dynd::complex<float>>());
+  reinterpret_cast<uint32_t *>(a.data())[0] = 0xDA0F4940;
+  reinterpret_cast<uint32_t *>(a.data())[1] = 0xC1B88FD3;
+  reinterpret_cast<uint32_t *>(a.data())[2] = 0xC1B88FD3;
+  reinterpret_cast<uint32_t *>(a.data())[3] = 0xDA0F4940;
+  b = nd::view_byteswapped(a).eval();
+  EXPECT_EQ(dynd::complex<float>(3.1415926f, -1.23456e12f), b(0).as<dynd::complex<float>>());
+  EXPECT_EQ(dynd::complex<float>(-1.23456e12f, 3.1415926f), b(1).as<dynd::complex<float>>());
+
+  // Contiguous runs that don't fill a whole number of vectors
+  a = nd::empty(7, ndt::make_type<uint32_t>());
+  for (uint32_t i = 0; i < 7; ++i) {
+    reinterpret_cast<uint32_t *>(a.data())[i] = 0x01020304u + i;
+  }
+  b = nd::view_byteswapped(a).eval();
+  for (uint32_t i = 0; i < 7; ++i) {
+    EXPECT_EQ(byteswap_value(0x01020304u + i), b(i).as<uint32_t>());
+  }
+  a = nd::empty(5, ndt::make_type<uint64_t>());
+  for (uint64_t i = 0; i < 5; ++i) {
+    reinterpret_cast<uint64_t *>(a.data())[i] = 0x0102030405060708ULL + i;
+  }
+  b = nd::view_byteswapped(a).eval();
+  for (uint64_t i = 0; i < 5; ++i) {
+    EXPECT_EQ(byteswap_value(static_cast<uint64_t>(0x0102030405060708ULL + i)), b(i).as<uint64_t>());
+  }
+
+  EXPECT_THROW(nd::view_byteswapped(nd::array{"abc", "def"}), type_error);
+}
@@ -0,0 +1,54 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include <dynd/array.hpp>
+#include <dynd/gtest.hpp>
+#include <dynd/kernels/byteswap_kernels.hpp>
+#include <dynd/types/adapt_type.hpp>
+#include <dynd/types/callable_type.hpp>
+#include <dynd/types/expr_kind_type.hpp>
+#include <dynd/types/fixed_bytes_type.hpp>
+
+using namespace std;
+using namespace dynd;
+
+TEST(ExprKindType, Basic) {
+  ndt::type expr_kind_tp = ndt::make_type<ndt::expr_kind_type>();
+  EXPECT_EQ(expr_kind_id, expr_kind_tp.get_id());
+  EXPECT_TRUE(expr_kind_tp.is_symbolic());
+  EXPECT_EQ(0, expr_kind_tp.get_ndim());
+  EXPECT_EQ("Expr", expr_kind_tp.str());
+}
+
+TEST(ExprKindType, Match) {
+  ndt::type tp = ndt::make_type<ndt::expr_kind_type>();
+  ndt::type adapt_tp =
+      ndt::make_type<ndt::adapt_type>(ndt::make_type<int32_t>(), ndt::make_type<ndt::fixed_bytes_type>(4, 4),
+                                      nd::byteswap, nd::byteswap);
+  EXPECT_TRUE(tp.match(tp));
+  EXPECT_TRUE(tp.match(adapt_tp));
+  EXPECT_FALSE(tp.match(ndt::type("int32")));
+  EXPECT_FALSE(tp.match(ndt::type("fixed_bytes[4, align=4]")));
+  EXPECT_FALSE(tp.match(ndt::type("Scalar")));
+  EXPECT_FALSE(tp.match(ndt::type("Any")));
+  EXPECT_FALSE(tp.match(ndt::type("4 * int32")));
+  EXPECT_FALSE(tp.match(ndt::make_type<ndt::fixed_dim_type>(4, adapt_tp)));
+  EXPECT_FALSE(tp.match(ndt::type("Fixed * Any")));
+
+  // Expr itself is still a scalar pattern
+  EXPECT_TRUE(ndt::type("Scalar").match(tp));
+  EXPECT_FALSE(ndt::type("Fixed * Any").match(tp));
+
+  // A signature taking Expr only accepts expression types
+  ndt::type callable_tp = ndt::make_type<ndt::callable_type>(ndt::type("int32"), {tp});
+  EXPECT_TRUE(callable_tp.match(ndt::make_type<ndt::callable_type>(ndt::type("int32"), {adapt_tp})));
+  EXPECT_FALSE(callable_tp.match(ndt::type("(int32) -> int32")));
+}
+
+TEST(ExprKindType, IDOf) { EXPECT_EQ(expr_kind_id, ndt::id_of<ndt::expr_kind_type>::value); }
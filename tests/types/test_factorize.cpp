@@ -0,0 +1,86 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include <dynd/array.hpp>
+#include <dynd/types/categorical_type.hpp>
+#include <dynd/types/string_type.hpp>
+#include <dynd/gtest.hpp>
+
+using namespace std;
+using namespace dynd;
+
+TEST(Factorize, String) {
+  nd::array categories;
+  nd::array codes = nd::factorize({"foo", "bar", "foo", "baz", "bar", "a longer string value"}, categories);
+
+  EXPECT_EQ(ndt::type("6 * uint32"), codes.get_type());
+  EXPECT_ARRAY_EQ(nd::array({0u, 1u, 0u, 2u, 1u, 3u}), codes);
+  EXPECT_EQ(ndt::type("4 * string"), categories.get_type());
+  EXPECT_EQ("foo", categories(0).as<std::string>());
+  EXPECT_EQ("bar", categories(1).as<std::string>());
+  EXPECT_EQ("baz", categories(2).as<std::string>());
+  EXPECT_EQ("a longer string value", categories(3).as<std::string>());
+}
+
+TEST(Factorize, Int) {
+  nd::array categories;
+  nd::array codes = nd::factorize({10, 10, 0, -3, 0}, categories);
+
+  EXPECT_ARRAY_EQ(nd::array({0u, 0u, 1u, 2u, 1u}), codes);
+  EXPECT_ARRAY_EQ(nd::array({10, 0, -3}), categories);
+
+  // Strided values
+  codes = nd::factorize(nd::array({1, 2, 1, 3, 1, 4})(irange().by(2)), categories);
+  EXPECT_ARRAY_EQ(nd::array({0u, 0u, 0u}), codes);
+  EXPECT_ARRAY_EQ(nd::array({1}), categories);
+}
+
+TEST(Factorize, FloatByValue) {
+  // -0.0 is the same value as 0.0, and every NaN is one category
+  double nan = std::numeric_limits<double>::quiet_NaN();
+  nd::array categories;
+  nd::array codes = nd::factorize({0.0, -0.0, 1.5, nan, -nan}, categories);
+
+  EXPECT_ARRAY_EQ(nd::array({0u, 0u, 1u, 2u, 2u}), codes);
+  EXPECT_EQ(3, categories.get_dim_size());
+  EXPECT_EQ(0.0, categories(0).as<double>());
+  EXPECT_FALSE(std::signbit(categories(0).as<double>()));
+
+  ndt::type cat_tp = ndt::make_type<ndt::categorical_type>(nd::array{0.0, 1.5, 3.0}, true);
+  EXPECT_EQ(0u, cat_tp.extended<ndt::categorical_type>()->get_value_from_category(nd::array(-0.0)));
+  EXPECT_EQ(1u, cat_tp.extended<ndt::categorical_type>()->get_value_from_category(nd::array(1.5)));
+}
+
+TEST(Factorize, Threads) {
+  // Enough values that three threads each get a chunk
+  intptr_t size = 200000;
+  nd::array values = nd::empty(size, ndt::make_type<ndt::string_type>());
+  for (intptr_t i = 0; i < size; ++i) {
+    values(i).vals() = "value" + std::to_string((i * 7919) % 1000);
+  }
+
+  nd::array categories, threaded_categories;
+  nd::array codes = nd::factorize(values, categories);
+  nd::array threaded_codes = nd::factorize(values, threaded_categories, 3);
+
+  EXPECT_EQ(1000, categories.get_dim_size());
+  EXPECT_ARRAY_EQ(codes, threaded_codes);
+  EXPECT_ARRAY_EQ(categories, threaded_categories);
+  for (intptr_t i = 0; i < size; i += 997) {
+    EXPECT_EQ(values(i).as<std::string>(), categories(codes(i).as<uint32_t>()).as<std::string>());
+  }
+}
+
+TEST(Factorize, Errors) {
+  nd::array categories;
+  EXPECT_THROW(nd::factorize(nd::array({{1, 2}, {3, 4}}), categories), type_error);
+  EXPECT_THROW(nd::factorize(nd::empty(ndt::type("3 * {a: string}")), categories), type_error);
+}
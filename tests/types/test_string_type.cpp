@@ -514,6 +514,63 @@ TEST(StringType, Split) {
   EXPECT_EQ("foobar", c(3)(0));
 }
 
+TEST(StringType, SplitMany) {
+  std::string s;
+  for (int i = 0; i < 1000; ++i) {
+    s += (i > 0 ? ", " : "") + std::string(i % 40, 'a' + i % 26);
+  }
+  nd::array a = {s, std::string("x, y")};
+
+  nd::array c = nd::string_split(a, ", ");
+  ASSERT_EQ(1000, c(0).get_dim_size());
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(std::string(i % 40, 'a' + i % 26), c(0, i).as<std::string>());
+  }
+  ASSERT_EQ(2, c(1).get_dim_size());
+  EXPECT_EQ("x", c(1, 0).as<std::string>());
+  EXPECT_EQ("y", c(1, 1).as<std::string>());
+}
+
+static void expect_offsets(intptr_t begin, intptr_t end, const nd::array &a) {
+  EXPECT_EQ(begin, a(0).as<intptr_t>());
+  EXPECT_EQ(end, a(1).as<intptr_t>());
+}
+
+TEST(StringType, SplitOffsets) {
+  nd::array a, b, c;
+
+  a = {"xaxxbxxxc", "foobar"};
+  b = {"x", ""};
+
+  c = nd::string_split_offsets(a, b);
+  EXPECT_EQ(ndt::type("2 * var * 2 * int64"), c.get_type());
+  ASSERT_EQ(7, c(0).get_dim_size());
+  expect_offsets(0, 0, c(0, 0));
+  expect_offsets(1, 2, c(0, 1));
+  expect_offsets(4, 5, c(0, 3));
+  expect_offsets(8, 9, c(0, 6));
+  ASSERT_EQ(1, c(1).get_dim_size());
+  expect_offsets(0, 6, c(1, 0));
+}
+
+TEST(StringType, Tokenize) {
+  nd::array a = {"a b  c", "", "long piece of text with many words"};
+
+  nd::array c = nd::string_tokenize(a, " ");
+  EXPECT_EQ(ndt::type("3 * var * string"), c.get_type());
+  ASSERT_EQ(4, c(0).get_dim_size());
+  EXPECT_EQ("a", c(0, 0).as<std::string>());
+  EXPECT_EQ("b", c(0, 1).as<std::string>());
+  EXPECT_EQ("", c(0, 2).as<std::string>());
+  EXPECT_EQ("c", c(0, 3).as<std::string>());
+  ASSERT_EQ(1, c(1).get_dim_size());
+  EXPECT_EQ("", c(1, 0).as<std::string>());
+  ASSERT_EQ(7, c(2).get_dim_size());
+  EXPECT_EQ("words", c(2, 6).as<std::string>());
+
+  EXPECT_THROW(nd::string_tokenize(nd::array{1, 2}, " "), type_error);
+}
+
 TEST(StringType, StartsWith) {
   nd::array a, b, c;
 
@@ -220,6 +220,74 @@ TEST(StructType, DifferentTypeAssign) {
   EXPECT_EQ(8, b(1, 1).as<short>());
 }
 
+TEST(StructType, MixedFieldAssign) {
+  // The POD fields around the string are copied as blocks, the string through its kernel
+  ndt::type dt = ndt::make_type<ndt::struct_type>({{ndt::make_type<int>(), "x"},
+                                                   {ndt::make_type<int>(), "y"},
+                                                   {ndt::make_type<ndt::string_type>(), "s"},
+                                                   {ndt::make_type<double>(), "z"}});
+  nd::array a = nd::empty(6, dt);
+  for (int i = 0; i < 6; ++i) {
+    a(i, 0).vals() = i;
+    a(i, 1).vals() = 10 * i;
+    a(i, 2).vals() = "s" + std::to_string(i);
+    a(i, 3).vals() = i + 0.5;
+  }
+
+  nd::array b = nd::empty(6, dt);
+  b.assign(a);
+  for (int i = 0; i < 6; ++i) {
+    EXPECT_EQ(i, b(i, 0).as<int>());
+    EXPECT_EQ(10 * i, b(i, 1).as<int>());
+    EXPECT_EQ("s" + std::to_string(i), b(i, 2).as<std::string>());
+    EXPECT_EQ(i + 0.5, b(i, 3).as<double>());
+  }
+
+  // Strided records
+  b = nd::empty(3, dt);
+  b.assign(a(irange().by(2)));
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(2 * i, b(i, 0).as<int>());
+    EXPECT_EQ(20 * i, b(i, 1).as<int>());
+    EXPECT_EQ("s" + std::to_string(2 * i), b(i, 2).as<std::string>());
+    EXPECT_EQ(2 * i + 0.5, b(i, 3).as<double>());
+  }
+
+  // Same field types in a different order, which can't be merged into one block
+  ndt::type dt2 = ndt::make_type<ndt::struct_type>({{ndt::make_type<double>(), "z"},
+                                                    {ndt::make_type<int>(), "y"},
+                                                    {ndt::make_type<ndt::string_type>(), "s"},
+                                                    {ndt::make_type<int>(), "x"}});
+  nd::array c = nd::empty(6, dt2);
+  c.assign(a);
+  for (int i = 0; i < 6; ++i) {
+    EXPECT_EQ(i + 0.5, c(i, 0).as<double>());
+    EXPECT_EQ(10 * i, c(i, 1).as<int>());
+    EXPECT_EQ("s" + std::to_string(i), c(i, 2).as<std::string>());
+    EXPECT_EQ(i, c(i, 3).as<int>());
+  }
+}
+
+TEST(StructType, PODAssign) {
+  // A struct of identical POD fields is copied as whole records
+  ndt::type dt = ndt::make_type<ndt::struct_type>(
+      {{ndt::make_type<int>(), "x"}, {ndt::make_type<int>(), "y"}, {ndt::make_type<double>(), "z"}});
+  nd::array a = nd::empty(100, dt);
+  for (int i = 0; i < 100; ++i) {
+    a(i, 0).vals() = i;
+    a(i, 1).vals() = -i;
+    a(i, 2).vals() = i * 0.25;
+  }
+
+  nd::array b = nd::empty(100, dt);
+  b.assign(a);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(i, b(i, 0).as<int>());
+    EXPECT_EQ(-i, b(i, 1).as<int>());
+    EXPECT_EQ(i * 0.25, b(i, 2).as<double>());
+  }
+}
+
 TEST(StructType, SingleCompare) {
   nd::array a, b;
   ndt::type sdt = ndt::make_type<ndt::struct_type>(
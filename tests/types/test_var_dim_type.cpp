@@ -454,4 +454,37 @@ TEST(VarArrayDType, AssignAfterCreated) {
   EXPECT_JSON_EQ_ARR("[1, 3, 5]", a);
 }
 
+TEST(VarDimType, Compact) {
+  nd::array a = nd::empty("3 * var * int32");
+  intptr_t stride = reinterpret_cast<const fixed_dim_type_arrmeta *>(a.get()->metadata())->stride;
+  const ndt::var_dim_type::metadata_type *md = reinterpret_cast<const ndt::var_dim_type::metadata_type *>(
+      a.get()->metadata() + sizeof(fixed_dim_type_arrmeta));
+
+  // Each row is too large to share a chunk of the memory block with the previous one
+  for (int i = 0; i < 3; ++i) {
+    ndt::var_dim_type::data_type *d = reinterpret_cast<ndt::var_dim_type::data_type *>(a.data() + i * stride);
+    d->begin = md->blockref->alloc(400);
+    d->size = 400;
+    for (int j = 0; j < 400; ++j) {
+      reinterpret_cast<int32_t *>(d->begin)[j] = 1000 * i + j;
+    }
+  }
+  md->blockref->finalize();
+
+  nd::array view = a(1);
+  EXPECT_THROW(nd::compact_var_dim(a), invalid_argument);
+  view = nd::array();
+
+  nd::compact_var_dim(a);
+  const ndt::var_dim_type::data_type *d = reinterpret_cast<const ndt::var_dim_type::data_type *>(a.cdata());
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(d[0].begin + i * 1600, reinterpret_cast<const ndt::var_dim_type::data_type *>(
+                                           a.cdata() + i * stride)->begin);
+    EXPECT_EQ(1000 * i + 7, a(i, 7).as<int>());
+    EXPECT_EQ(1000 * i + 399, a(i, 399).as<int>());
+  }
+
+  EXPECT_THROW(nd::compact_var_dim(nd::empty("3 * int32")), type_error);
+}
+
 TEST(VarDimType, IDOf) { EXPECT_EQ(var_dim_id, ndt::id_of<ndt::var_dim_type>::value); }